@@ -0,0 +1,126 @@
+#ifndef AGP_COMPILED_PROGRAM_H
+#define AGP_COMPILED_PROGRAM_H
+
+#include "base/vector.h"
+#include "hardware/AvidaGP.h"
+#include "hardware/InstLib.h"
+#include "tools/math.h"
+
+/// Pre-resolved scope exits for an AvidaGP genome.
+/// emp::AvidaGP::BypassScope finds where a scope ends by walking forward through the genome
+/// until it finds an instruction that opens a scope at the same or an outer level. That walk
+/// only depends on the genome, so we do it once per genotype for every (position, scope) pair
+/// and store the result in a jump table.
+///
+/// Function entry points are *not* precomputed: AvidaGP only knows about a function once its
+/// Define instruction has executed, and we want identical semantics.
+template<typename HARDWARE_T>
+class AGPCompiledProgram {
+public:
+  using hardware_t = HARDWARE_T;
+  using genome_t = typename hardware_t::genome_t;
+  using inst_t = typename hardware_t::inst_t;
+
+protected:
+  static constexpr size_t SCOPE_CNT = hardware_t::CPU_SIZE + 1; ///< Scopes are stored +1 (0 means 'no scope').
+
+  emp::vector<size_t> bypass_targets; ///< [ip * SCOPE_CNT + scope] => where BypassScope leaves the IP.
+  size_t genome_size;
+  bool compiled;
+
+  /// What scope (+1) does this instruction open? (0 if none)
+  static size_t InstScope(const genome_t & genome, const inst_t & inst) {
+    if (genome.inst_lib->GetScopeType(inst.id) == emp::ScopeType::NONE) return 0;
+    return inst.args[genome.inst_lib->GetScopeArg(inst.id)] + 1;
+  }
+
+public:
+  AGPCompiledProgram() : bypass_targets(), genome_size(0), compiled(false) { ; }
+
+  bool IsCompiled() const { return compiled; }
+
+  void Clear() { bypass_targets.clear(); genome_size = 0; compiled = false; }
+
+  /// Build jump table for genome (single backwards pass).
+  void Compile(const genome_t & genome) {
+    genome_size = genome.sequence.size();
+    bypass_targets.resize(genome_size * SCOPE_CNT);
+    // next_open[s] = first position after the current one that opens a scope in (0, s].
+    emp::vector<size_t> next_open(SCOPE_CNT, genome_size);
+    for (size_t ip = genome_size; ip-- > 0; ) {
+      for (size_t s = 0; s < SCOPE_CNT; ++s) {
+        // No scope to stop at? BypassScope runs off to the last instruction.
+        bypass_targets[ip * SCOPE_CNT + s] = (next_open[s] == genome_size) ? genome_size - 1 : next_open[s] - 1;
+      }
+      const size_t inst_scope = InstScope(genome, genome.sequence[ip]);
+      for (size_t s = inst_scope; inst_scope && s < SCOPE_CNT; ++s) next_open[s] = ip;
+    }
+    compiled = true;
+  }
+
+  /// Where should the IP end up if we bypass scope (stored +1) from position ip?
+  size_t GetBypassTarget(size_t ip, size_t scope) const {
+    emp_assert(ip < genome_size);
+    return bypass_targets[ip * SCOPE_CNT + emp::Min(scope, SCOPE_CNT - 1)];
+  }
+
+  /// Equivalent to hw.BypassScope(scope), using the jump table.
+  void BypassScope(hardware_t & hw, size_t scope) const {
+    scope++;                            // Scopes are stored as +1
+    if (hw.CurScope() < scope) return;  // Only continue if break is relevant for current scope.
+    hw.ExitScope();
+    const size_t ip = hw.GetIP();
+    if (ip < genome_size) hw.SetIP(GetBypassTarget(ip, scope));
+  }
+};
+
+template<typename HARDWARE_T>
+constexpr size_t AGPCompiledProgram<HARDWARE_T>::SCOPE_CNT;
+
+// Scope-bypassing instructions: each behaves exactly like its emp::AvidaCPU_InstLib counterpart, but
+// jumps using compiled's table instead of scanning the genome for the end of the scope. compiled must
+// be compiled from the genome on hw. Instruction libraries register them wrapped in whatever finds
+// the compiled program for the hardware being run.
+
+/// If reg Arg1 != 0, scope -> Arg2; else skip scope.
+template<typename HARDWARE_T>
+void AGPCompiled_Inst_If(HARDWARE_T & hw, const typename HARDWARE_T::inst_t & inst,
+                         const AGPCompiledProgram<HARDWARE_T> & compiled) {
+  if (hw.UpdateScope(inst.args[1]) == false) return;
+  if (hw.regs[inst.args[0]] == 0.0) compiled.BypassScope(hw, inst.args[1]);
+}
+
+/// Until reg Arg1 != 0, repeat scope Arg2; else skip.
+template<typename HARDWARE_T>
+void AGPCompiled_Inst_While(HARDWARE_T & hw, const typename HARDWARE_T::inst_t & inst,
+                            const AGPCompiledProgram<HARDWARE_T> & compiled) {
+  if (hw.UpdateScope(inst.args[1], emp::ScopeType::LOOP) == false) return;
+  if (hw.regs[inst.args[0]] == 0.0) compiled.BypassScope(hw, inst.args[1]);
+}
+
+/// Countdown reg Arg1 to zero; scope to Arg2.
+template<typename HARDWARE_T>
+void AGPCompiled_Inst_Countdown(HARDWARE_T & hw, const typename HARDWARE_T::inst_t & inst,
+                                const AGPCompiledProgram<HARDWARE_T> & compiled) {
+  if (hw.UpdateScope(inst.args[1], emp::ScopeType::LOOP) == false) return;
+  if (hw.regs[inst.args[0]] == 0.0) compiled.BypassScope(hw, inst.args[1]);
+  else hw.regs[inst.args[0]]--;
+}
+
+/// Break out of scope Arg1.
+template<typename HARDWARE_T>
+void AGPCompiled_Inst_Break(HARDWARE_T & hw, const typename HARDWARE_T::inst_t & inst,
+                            const AGPCompiledProgram<HARDWARE_T> & compiled) {
+  compiled.BypassScope(hw, inst.args[0]);
+}
+
+/// Build function Arg1 in scope Arg2.
+template<typename HARDWARE_T>
+void AGPCompiled_Inst_Define(HARDWARE_T & hw, const typename HARDWARE_T::inst_t & inst,
+                             const AGPCompiledProgram<HARDWARE_T> & compiled) {
+  if (hw.UpdateScope(inst.args[1]) == false) return;
+  hw.fun_starts[inst.args[0]] = (int)hw.GetIP();
+  compiled.BypassScope(hw, inst.args[1]);
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef BATCH_REPRODUCTION_H
+#define BATCH_REPRODUCTION_H
+
+#include <algorithm>
+
+#include "base/vector.h"
+
+#include "FitnessSelection.h"
+#include "WorkerPool.h"
+
+/// Helpers for batched reproduction: parents for a whole generation are picked up front
+/// (serially), then offspring are copied and mutated by a fixed number of workers.
+/// Parent pickers append parent positions to parents; they follow the emp::*Select functions they
+/// stand in for, but only pick (no births). RANDOM_T: emp::Random or CounterRandom.
+/// (Lexicase parents come from LexicaseSelector.)
+
+/// Copy and mutate a generation's offspring on num_workers of workers' workers. Offspring i is a
+/// copy of get_genome(parents[i]); unless it's an elite (the first elite_cnt of each block of block_size),
+/// it's then mutated by mutate(genome, rnd, mstate) with stream (update, i, purpose) of its worker's
+/// generator, and muts[i] = mstate.muts. So results don't depend on the number of workers.
+/// offspring only ever grows (its buffers are reused).
+template<typename GENOME_T, typename GET_FUN, typename MUT_FUN, typename RANDOM_T, typename MSTATE_T, typename COUNTS_T>
+void MutateOffspring(WorkerPool & workers, size_t num_workers, const emp::vector<size_t> & parents, size_t elite_cnt, size_t block_size,
+                     size_t update, size_t purpose, GET_FUN && get_genome, MUT_FUN && mutate,
+                     emp::vector<RANDOM_T> & rngs, emp::vector<MSTATE_T> & mstates,
+                     emp::vector<GENOME_T> & offspring, emp::vector<COUNTS_T> & muts) {
+  emp_assert(num_workers > 0 && num_workers <= workers.GetSize());
+  emp_assert(rngs.size() >= num_workers && mstates.size() >= num_workers);
+  const size_t offspring_cnt = parents.size();
+  block_size = std::max(block_size, (size_t)1);
+  elite_cnt = std::min(elite_cnt, offspring_cnt);
+  while (offspring.size() < offspring_cnt) offspring.emplace_back(get_genome(parents[offspring.size()]));
+  muts.resize(offspring_cnt);
+  workers.Run(num_workers, [&](size_t w) {
+    const size_t begin = (offspring_cnt * w) / num_workers;
+    const size_t end = (offspring_cnt * (w + 1)) / num_workers;
+    MSTATE_T & mstate = mstates[w];
+    RANDOM_T & rnd = rngs[w];
+    for (size_t i = begin; i < end; ++i) {
+      offspring[i] = get_genome(parents[i]);
+      if (i % block_size < elite_cnt) {
+        muts[i].fill(0);
+        continue;
+      }
+      rnd.SetStream(update, i, purpose);
+      mutate(offspring[i], rnd, mstate);
+      muts[i] = mstate.muts;
+    }
+  });
+}
+
+/// Elite selection: the e_count highest-fitness positions (each once; highest first).
+inline void SelectEliteParents(const emp::vector<double> & fitness, size_t e_count,
+                               emp::vector<size_t> & order, emp::vector<size_t> & parents) {
+  if (e_count == 0 || fitness.empty()) return;
+  e_count = std::min(e_count, fitness.size());
+  order.resize(fitness.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::partial_sort(order.begin(), order.begin() + e_count, order.end(),
+                    [&fitness](size_t a, size_t b) { return fitness[a] > fitness[b] || (fitness[a] == fitness[b] && a < b); });
+  parents.insert(parents.end(), order.begin(), order.begin() + e_count);
+}
+
+/// Tournament selection (see RunTournament): t_size entrants per tournament, with replacement, as
+/// emp::TournamentSelect draws them.
+template<typename RANDOM_T>
+void SelectTournamentParents(const emp::vector<double> & fitness, size_t t_size, size_t count,
+                             RANDOM_T & rnd, emp::vector<size_t> & parents) {
+  const size_t pop_size = fitness.size();
+  for (size_t t = 0; t < count; ++t) {
+    parents.emplace_back(RunTournament(fitness, t_size, [&rnd, pop_size]() { return (size_t)rnd.GetUInt(pop_size); }));
+  }
+}
+
+/// Roulette selection: parents are picked with probability proportional to fitness (table is
+/// rebuilt from fitness, then each pick is one O(1) draw).
+template<typename RANDOM_T>
+void SelectRouletteParents(const emp::vector<double> & fitness, size_t count, RANDOM_T & rnd,
+                           AliasTable & table, emp::vector<size_t> & parents) {
+  table.Build(fitness);
+  for (size_t n = 0; n < count; ++n) parents.emplace_back(table.Draw(rnd));
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef COUNTER_RANDOM_H
+#define COUNTER_RANDOM_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/// Counter-based random number generator (Philox4x32-10; Salmon et al. 2011).
+/// Every random number is a pure function of (seed, stream, position in stream), so streams can be
+/// addressed directly: e.g. the mutations of offspring 12 in update 300 always come from stream
+/// (300, 12, RANDOM_PURPOSE_ID__MUTATION), no matter which thread makes them or what was drawn
+/// before. Switching streams is free (no warm-up), so it's fine to switch once per offspring.
+/// Provides the subset of emp::Random's interface that our mutation/selection/initialization
+/// code uses.
+class CounterRandom {
+public:
+  using block_t = std::array<uint32_t, 4>;
+  using key_t = std::array<uint32_t, 2>;
+
+  /// The Philox4x32 bijection with 10 rounds.
+  static block_t Philox4x32_10(block_t ctr, key_t key) {
+    for (size_t round = 0; round < 10; ++round) {
+      if (round) { key[0] += 0x9E3779B9u; key[1] += 0xBB67AE85u; }
+      const uint64_t prod0 = (uint64_t)0xD2511F53u * ctr[0];
+      const uint64_t prod1 = (uint64_t)0xCD9E8D57u * ctr[2];
+      ctr = {{ (uint32_t)(prod1 >> 32) ^ ctr[1] ^ key[0], (uint32_t)prod1,
+               (uint32_t)(prod0 >> 32) ^ ctr[3] ^ key[1], (uint32_t)prod0 }};
+    }
+    return ctr;
+  }
+
+protected:
+  key_t key;       ///< From the seed.
+  block_t ctr;     ///< [0]: block within stream; [1..3]: stream ID.
+  block_t buffer;  ///< Output of the current block.
+  size_t buffer_pos;
+
+public:
+  CounterRandom(uint64_t seed=0) : key(), ctr(), buffer(), buffer_pos(4) { SetSeed(seed); }
+
+  void SetSeed(uint64_t seed) {
+    key = {{ (uint32_t)seed, (uint32_t)(seed >> 32) }};
+    ctr[0] = 0;
+    buffer_pos = 4;
+  }
+
+  /// Start drawing from the beginning of stream (update, agent, purpose).
+  void SetStream(uint32_t update, uint32_t agent, uint32_t purpose) {
+    ctr = {{ 0, agent, update, purpose }};
+    buffer_pos = 4;
+  }
+
+  uint32_t GetUInt32() {
+    if (buffer_pos == 4) {
+      buffer = Philox4x32_10(ctr, key);
+      ++ctr[0];
+      buffer_pos = 0;
+    }
+    return buffer[buffer_pos++];
+  }
+
+  /// Uniform double in [0, 1) (53 random bits).
+  double GetDouble() {
+    const uint32_t a = GetUInt32() >> 5;
+    const uint32_t b = GetUInt32() >> 6;
+    return (a * 67108864.0 + b) / 9007199254740992.0;
+  }
+  double GetDouble(double max) { return GetDouble() * max; }
+  double GetDouble(double min, double max) { return GetDouble() * (max - min) + min; }
+
+  /// Uniform integer in [0, max) or [min, max).
+  uint32_t GetUInt(size_t max) { return (uint32_t)(GetDouble() * (double)max); }
+  uint32_t GetUInt(size_t min, size_t max) { return GetUInt(max - min) + (uint32_t)min; }
+  int GetInt(int max) { return (int)GetUInt((size_t)max); }
+  int GetInt(int min, int max) { return GetInt(max - min) + min; }
+
+  /// True with probability p.
+  bool P(double p) { return GetDouble() < p; }
+
+  /// Normally distributed (Box-Muller).
+  double GetRandNormal(double mean=0.0, double std=1.0) {
+    const double u1 = 1.0 - GetDouble(); // (0, 1]
+    const double u2 = GetDouble();
+    return mean + std * std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+  }
+
+  /// Number of successes in n trials with success probability p (draws geometric gaps between
+  /// successes rather than one number per trial).
+  size_t GetRandBinomial(size_t n, double p) {
+    if (p <= 0.0) return 0;
+    if (p >= 1.0) return n;
+    const double log_q = std::log1p(-p);
+    size_t cnt = 0;
+    double trial = 0.0;
+    while (true) {
+      trial += std::floor(std::log(1.0 - GetDouble()) / log_q);
+      if (trial >= (double)n) return cnt;
+      ++cnt;
+      trial += 1.0;
+    }
+  }
+
+  /// Set each bit of bits with probability p.
+  template<typename BITS_T>
+  void RandomizeBits(BITS_T & bits, double p=0.5) {
+    for (size_t i = 0; i < bits.GetSize(); ++i) bits.Set(i, P(p));
+  }
+};
+
+#endif
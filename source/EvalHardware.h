@@ -0,0 +1,49 @@
+#ifndef EVAL_HARDWARE_H
+#define EVAL_HARDWARE_H
+
+#include <utility>
+
+#include "base/Ptr.h"
+
+/// Evaluation hardware: any virtual hardware (BASE_HW) + a pointer to an evaluation context.
+/// Lets instructions be plain static functions that find everything they need (game board,
+/// player, lookup tables, etc.) through the hardware they're executed on instead of capturing
+/// an experiment object.
+/// NOTE: GetContext(BASE_HW &) assumes the hardware passed in actually is an EvalHardware.
+template<typename BASE_HW, typename CONTEXT_T>
+class EvalHardware : public BASE_HW {
+public:
+  using base_hw_t = BASE_HW;
+  using context_t = CONTEXT_T;
+
+protected:
+  emp::Ptr<context_t> context;
+
+public:
+  template<typename... ARGS>
+  EvalHardware(ARGS &&... args)
+    : BASE_HW(std::forward<ARGS>(args)...), context(nullptr)
+  { ; }
+
+  void SetContext(emp::Ptr<context_t> in) { context = in; }
+  context_t & GetContext() { emp_assert(context != nullptr); return *context; }
+
+  /// Get evaluation context of hardware that is being run as BASE_HW (e.g. from within an instruction).
+  static context_t & GetContext(base_hw_t & hw) {
+    return static_cast<EvalHardware &>(hw).GetContext();
+  }
+
+  /// Advance hardware up to max_steps time steps, stopping early as soon as stop(*this) is true
+  /// (checked before every step). Returns the number of steps actually taken.
+  template<typename STOP_FUN>
+  size_t RunUntil(size_t max_steps, STOP_FUN && stop) {
+    size_t steps = 0;
+    while (steps < max_steps && !stop(*this)) {
+      BASE_HW::SingleProcess();
+      ++steps;
+    }
+    return steps;
+  }
+};
+
+#endif
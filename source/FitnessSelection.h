@@ -0,0 +1,118 @@
+#ifndef FITNESS_SELECTION_H
+#define FITNESS_SELECTION_H
+
+#include <algorithm>
+
+#include "base/vector.h"
+
+/// Tournament and roulette selection over a precomputed fitness array (stand-ins for
+/// emp::TournamentSelect and emp::RouletteSelect, which call the world's fitness function through a
+/// std::function for every entrant / every organism). Fitness is filled in once per generation
+/// (e.g. from cached phenotype scores); all parents are picked first, then births are issued in
+/// order. Only for synchronous worlds (offspring don't replace anyone until the update ends, so
+/// fitnesses can't change mid-selection).
+
+/// Walker's alias table (Vose's construction) for roulette selection: built once per generation in
+/// O(N), then each draw is O(1) (one random number) instead of a search over cumulative fitness.
+class AliasTable {
+protected:
+  emp::vector<double> prob;    ///< By column: probability of keeping the column's own index.
+  emp::vector<size_t> alias;   ///< By column: index drawn otherwise.
+  emp::vector<size_t> small;   ///< Scratch: columns with scaled weight < 1.
+  emp::vector<size_t> large;   ///< Scratch: columns with scaled weight >= 1.
+  double total;
+
+public:
+  AliasTable() : total(0.0) { ; }
+
+  size_t GetSize() const { return prob.size(); }
+  double GetTotal() const { return total; }
+
+  /// Build from (non-negative) weights. If they sum to zero, draws are uniform.
+  void Build(const emp::vector<double> & weights) {
+    const size_t n = weights.size();
+    prob.resize(n);
+    alias.resize(n);
+    small.clear();
+    large.clear();
+    total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      emp_assert(weights[i] >= 0.0, i, weights[i]);
+      total += weights[i];
+    }
+    const double scale = (total > 0.0) ? (double)n / total : 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      alias[i] = i;
+      prob[i] = (total > 0.0) ? weights[i] * scale : 1.0;
+      if (prob[i] < 1.0) small.emplace_back(i);
+      else large.emplace_back(i);
+    }
+    // Pair each under-full column with an over-full one, which tops it up.
+    while (!small.empty() && !large.empty()) {
+      const size_t s = small.back(); small.pop_back();
+      const size_t l = large.back();
+      alias[s] = l;
+      prob[l] -= 1.0 - prob[s];
+      if (prob[l] < 1.0) { large.pop_back(); small.emplace_back(l); }
+    }
+    // Whatever is left is full (up to rounding).
+    for (size_t i : small) prob[i] = 1.0;
+    for (size_t i : large) prob[i] = 1.0;
+  }
+
+  /// Index drawn with probability weight / total.
+  template<typename RANDOM_T>
+  size_t Draw(RANDOM_T & rnd) const {
+    emp_assert(GetSize() > 0);
+    const double x = rnd.GetDouble() * (double)prob.size();
+    const size_t col = std::min((size_t)x, prob.size() - 1);
+    return (x - (double)col < prob[col]) ? col : alias[col];
+  }
+};
+
+/// One tournament (as emp::TournamentSelect runs it): t_size entrants drawn by draw_id(), with
+/// replacement; returns the first highest-fitness entrant.
+template<typename DRAW_FUN>
+size_t RunTournament(const emp::vector<double> & fitness, size_t t_size, DRAW_FUN && draw_id) {
+  emp_assert(t_size > 0, t_size);
+  size_t best_id = draw_id();
+  double best_fit = fitness[best_id];
+  for (size_t i = 1; i < t_size; ++i) {
+    const size_t id = draw_id();
+    if (fitness[id] > best_fit) {
+      best_fit = fitness[id];
+      best_id = id;
+    }
+  }
+  return best_id;
+}
+
+/// Tournament selection into world (as emp::TournamentSelect): tourny_count tournaments of t_size
+/// random organisms (with replacement); the first highest-fitness entrant of each reproduces.
+/// fitness is by world position. Entrants are drawn exactly as emp::TournamentSelect draws them, so
+/// the results are the same.
+template<typename WORLD_TYPE>
+void TournamentSelectArray(WORLD_TYPE & world, const emp::vector<double> & fitness, size_t t_size,
+                           size_t tourny_count, emp::vector<size_t> & parents) {
+  emp_assert(t_size > 0 && fitness.size() == world.GetSize(), t_size, fitness.size(), world.GetSize());
+  emp_assert(world.IsSynchronous());
+  parents.clear();
+  for (size_t t = 0; t < tourny_count; ++t) {
+    parents.emplace_back(RunTournament(fitness, t_size, [&world]() { return world.GetRandomOrgID(); }));
+  }
+  for (size_t parent : parents) world.DoBirth(world.GetGenomeAt(parent), parent);
+}
+
+/// Roulette selection into world (as emp::RouletteSelect): count parents, each drawn with
+/// probability proportional to fitness. table must be built from fitness by world position.
+template<typename WORLD_TYPE>
+void RouletteSelectArray(WORLD_TYPE & world, const AliasTable & table, size_t count,
+                         emp::vector<size_t> & parents) {
+  emp_assert(table.GetSize() == world.GetSize(), table.GetSize(), world.GetSize());
+  emp_assert(world.IsSynchronous());
+  parents.clear();
+  for (size_t n = 0; n < count; ++n) parents.emplace_back(table.Draw(world.GetRandom()));
+  for (size_t parent : parents) world.DoBirth(world.GetGenomeAt(parent), parent);
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef GENOME_RECYCLER_H
+#define GENOME_RECYCLER_H
+
+#include <utility>
+
+#include "base/vector.h"
+
+/// Per-thread pool of dead organisms' genomes, kept for their heap storage.
+/// emp::World allocates every offspring from its parent's genome and frees the previous
+/// generation afterwards; agents that Recycle their genome when they die and Copy into a recycled
+/// genome when they're born turn that into copy-assignment into already-allocated buffers (which
+/// only allocates if the new genome is bigger than any the buffer has held). In steady state, the
+/// pool holds about one generation's worth of genomes.
+template<typename GENOME_T>
+class GenomeRecycler {
+public:
+  using genome_t = GENOME_T;
+
+protected:
+  static emp::vector<genome_t> & GetPool() {
+    thread_local emp::vector<genome_t> pool;
+    return pool;
+  }
+
+public:
+  /// Get a copy of src, built in recycled storage if there is any.
+  static genome_t Copy(const genome_t & src) {
+    emp::vector<genome_t> & pool = GetPool();
+    if (pool.empty()) return src;
+    genome_t genome(std::move(pool.back()));
+    pool.pop_back();
+    genome = src;
+    return genome;
+  }
+
+  /// Hand genome's storage over to the pool.
+  static void Recycle(genome_t && genome) {
+    GetPool().emplace_back(std::move(genome));
+  }
+
+  static size_t GetPoolSize() { return GetPool().size(); }
+};
+
+#endif
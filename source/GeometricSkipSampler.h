@@ -0,0 +1,55 @@
+#ifndef GEOMETRIC_SKIP_SAMPLER_H
+#define GEOMETRIC_SKIP_SAMPLER_H
+
+#include <cmath>
+#include <limits>
+
+#include "tools/Random.h"
+
+/// Visits the 'hits' in a run of independent Bernoulli(p) trials (e.g. the sites of a genome that
+/// get mutated) without drawing a random number per trial: the gap between consecutive hits is
+/// geometrically distributed, so we draw gaps instead. Cost scales with the number of hits rather
+/// than the number of trials; every trial is still hit independently with probability p.
+class GeometricSkipSampler {
+public:
+  static constexpr size_t NEVER = std::numeric_limits<size_t>::max();
+
+protected:
+  double p;
+  double log_q; ///< log(1 - p)
+
+public:
+  GeometricSkipSampler(double _p=0.0) { SetP(_p); }
+
+  void SetP(double _p) {
+    p = _p;
+    log_q = (p > 0.0 && p < 1.0) ? std::log1p(-p) : 0.0;
+  }
+  double GetP() const { return p; }
+
+  /// How many trials are skipped before the next hit? (NEVER if p is 0)
+  /// RANDOM_T: emp::Random or anything else with GetDouble().
+  template<typename RANDOM_T>
+  size_t NextGap(RANDOM_T & rnd) const {
+    if (p <= 0.0) return NEVER;
+    if (p >= 1.0) return 0;
+    // P(gap >= k) = (1-p)^k = P(1-U <= (1-p)^k) for U uniform in [0, 1).
+    const double gap = std::floor(std::log(1.0 - rnd.GetDouble()) / log_q);
+    return (gap >= (double)NEVER) ? NEVER : (size_t)gap;
+  }
+
+  /// Call fun(trial) for every hit among trials [0, num_trials), in order.
+  template<typename RANDOM_T, typename FUN>
+  void ForEachHit(size_t num_trials, RANDOM_T & rnd, FUN && fun) const {
+    size_t trial = 0;
+    while (trial < num_trials) {
+      const size_t gap = NextGap(rnd);
+      if (gap >= num_trials - trial) break;
+      trial += gap;
+      fun(trial);
+      ++trial;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef LEXICASE_SELECTION_H
+#define LEXICASE_SELECTION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+
+#include "base/vector.h"
+
+/// Lexicase selection over a population x test case score matrix (stand-in for emp::LexicaseSelect
+/// with one fitness function per test case).
+/// - Positions with identical scores on every test case (phenotype classes) always survive or die
+///   together, so filtering is done on classes, and a survivor is picked with each class weighted by
+///   its size. Cost scales with the number of distinct phenotypes, not the population size.
+/// - Class scores are stored by test case (column): all classes' scores on a test case are
+///   contiguous, so each filtering pass is a scan over one array.
+/// - Candidate pools are bitsets (one bit per class); empty words are skipped.
+/// - Every selection event starts from the whole population, so each test case's first filtering
+///   pass (which classes are within epsilon of the population's best) is done once per
+///   generation, in Prepare.
+/// - Test cases are shuffled lazily (one Fisher-Yates step per test case actually used).
+/// Picks follow the same distribution as emp::LexicaseSelect: uniformly random test case order,
+/// uniformly random pick among the surviving positions. Survivors of a test case are the
+/// candidates whose score is at least (best candidate score - epsilon).
+class LexicaseSelector {
+public:
+  using word_t = uint64_t;
+  static constexpr size_t WORD_BITS = 64;
+
+protected:
+  size_t pop_size;
+  size_t num_tests;
+  size_t num_classes;
+  size_t num_words;                   ///< Bitset words per candidate pool.
+  double epsilon;
+  emp::vector<double> scores;         ///< [testID * pop_size + orgID]
+  emp::vector<double> class_scores;   ///< [testID * num_classes + classID]
+  emp::vector<size_t> class_start;    ///< Class classID's positions: class_members[class_start[classID]..class_start[classID+1]).
+  emp::vector<size_t> class_members;
+  emp::vector<size_t> org_class;      ///< Scratch: classID by position.
+  emp::vector<size_t> org_hash;       ///< Scratch: hash of scores by position.
+  emp::vector<size_t> class_rep;      ///< Scratch: a position in each class.
+  std::unordered_map<size_t, emp::vector<size_t>> class_lookup; ///< Scratch: score hash => classIDs.
+  emp::vector<word_t> winners;        ///< [testID * num_words + word]: best on testID across population.
+  emp::vector<size_t> winner_cnts;    ///< Number of classes in each test case's winners.
+  emp::vector<word_t> pool;
+  emp::vector<size_t> order;
+
+  static size_t CountBits(word_t bits) { return (size_t)__builtin_popcountll(bits); }
+  static size_t LowestBit(word_t bits) { return (size_t)__builtin_ctzll(bits); }
+
+  size_t GetClassSize(size_t classID) const { return class_start[classID + 1] - class_start[classID]; }
+
+  bool SameScores(size_t org_a, size_t org_b) const {
+    for (size_t testID = 0; testID < num_tests; ++testID) {
+      if (scores[testID * pop_size + org_a] != scores[testID * pop_size + org_b]) return false;
+    }
+    return true;
+  }
+
+  /// Group positions into phenotype classes; fill class_scores, class_start, and class_members.
+  void BuildClasses() {
+    class_lookup.clear();
+    class_rep.clear();
+    org_class.resize(pop_size);
+    org_hash.assign(pop_size, 0);
+    for (size_t testID = 0; testID < num_tests; ++testID) {
+      const double * col = scores.data() + testID * pop_size;
+      for (size_t org = 0; org < pop_size; ++org) {
+        const double score = col[org] + 0.0; // -0.0 => 0.0 (they compare equal).
+        org_hash[org] = org_hash[org] * 1000003u ^ std::hash<double>()(score);
+      }
+    }
+    for (size_t org = 0; org < pop_size; ++org) {
+      emp::vector<size_t> & candidates = class_lookup[org_hash[org]];
+      size_t classID = class_rep.size();
+      for (size_t c : candidates) {
+        if (SameScores(org, class_rep[c])) { classID = c; break; }
+      }
+      if (classID == class_rep.size()) {
+        candidates.emplace_back(classID);
+        class_rep.emplace_back(org);
+      }
+      org_class[org] = classID;
+    }
+    num_classes = class_rep.size();
+    // Members by class (counting sort).
+    class_start.assign(num_classes + 1, 0);
+    for (size_t org = 0; org < pop_size; ++org) ++class_start[org_class[org] + 1];
+    for (size_t c = 0; c < num_classes; ++c) class_start[c + 1] += class_start[c];
+    class_members.resize(pop_size);
+    emp::vector<size_t> & fill_pos = org_hash; // Hashes are no longer needed.
+    std::copy(class_start.begin(), class_start.end() - 1, fill_pos.begin());
+    for (size_t org = 0; org < pop_size; ++org) class_members[fill_pos[org_class[org]]++] = org;
+    // Class score columns.
+    class_scores.resize(num_tests * num_classes);
+    for (size_t testID = 0; testID < num_tests; ++testID) {
+      const double * col = scores.data() + testID * pop_size;
+      double * class_col = class_scores.data() + testID * num_classes;
+      for (size_t c = 0; c < num_classes; ++c) class_col[c] = col[class_rep[c]];
+    }
+  }
+
+  /// Keep only pool classes within epsilon of the pool's best on testID. Returns new pool size (in
+  /// classes).
+  size_t Filter(size_t testID) {
+    const double * col = class_scores.data() + testID * num_classes;
+    double max_score = -std::numeric_limits<double>::infinity();
+    for (size_t w = 0; w < num_words; ++w) {
+      for (word_t bits = pool[w]; bits; bits &= bits - 1) {
+        max_score = std::max(max_score, col[w * WORD_BITS + LowestBit(bits)]);
+      }
+    }
+    const double threshold = max_score - epsilon;
+    size_t cnt = 0;
+    for (size_t w = 0; w < num_words; ++w) {
+      word_t keep = 0;
+      for (word_t bits = pool[w]; bits; bits &= bits - 1) {
+        const size_t b = LowestBit(bits);
+        if (col[w * WORD_BITS + b] >= threshold) keep |= (word_t)1 << b;
+      }
+      pool[w] = keep;
+      cnt += CountBits(keep);
+    }
+    return cnt;
+  }
+
+public:
+  LexicaseSelector() : pop_size(0), num_tests(0), num_classes(0), num_words(0), epsilon(0.0) { ; }
+
+  size_t GetPopSize() const { return pop_size; }
+  size_t GetNumTests() const { return num_tests; }
+  /// Number of distinct phenotypes (as of the last Prepare).
+  size_t GetNumClasses() const { return num_classes; }
+
+  /// Set matrix dimensions (keeps storage for reuse). Scores must be (re)filled afterwards.
+  void Resize(size_t _pop_size, size_t _num_tests) {
+    pop_size = _pop_size;
+    num_tests = _num_tests;
+    scores.resize(pop_size * num_tests);
+    winner_cnts.resize(num_tests);
+    order.resize(num_tests);
+    for (size_t i = 0; i < num_tests; ++i) order[i] = i;
+  }
+
+  void SetScore(size_t testID, size_t orgID, double score) {
+    emp_assert(testID < num_tests && orgID < pop_size, testID, orgID);
+    scores[testID * pop_size + orgID] = score;
+  }
+
+  /// Set scores of orgID on test cases [0, org_scores.size()).
+  void SetOrgScores(size_t orgID, const emp::vector<double> & org_scores) {
+    emp_assert(org_scores.size() <= num_tests && orgID < pop_size);
+    for (size_t testID = 0; testID < org_scores.size(); ++testID) scores[testID * pop_size + orgID] = org_scores[testID];
+  }
+
+  double GetScore(size_t testID, size_t orgID) const { return scores[testID * pop_size + orgID]; }
+
+  /// Call after filling scores, before selecting: groups the population into phenotype classes and
+  /// finds each test case's best classes.
+  void Prepare(double _epsilon=0.0) {
+    epsilon = _epsilon;
+    BuildClasses();
+    num_words = (num_classes + WORD_BITS - 1) / WORD_BITS;
+    winners.resize(num_words * num_tests);
+    pool.resize(num_words);
+    for (size_t testID = 0; testID < num_tests; ++testID) {
+      const double * col = class_scores.data() + testID * num_classes;
+      const double threshold = *std::max_element(col, col + num_classes) - epsilon;
+      word_t * win = winners.data() + testID * num_words;
+      size_t cnt = 0;
+      for (size_t w = 0; w < num_words; ++w) {
+        const size_t base = w * WORD_BITS;
+        const size_t bits = std::min((size_t)WORD_BITS, num_classes - base); // (Copy: WORD_BITS has no out-of-class definition.)
+        word_t keep = 0;
+        for (size_t b = 0; b < bits; ++b) keep |= (word_t)(col[base + b] >= threshold) << b;
+        win[w] = keep;
+        cnt += CountBits(keep);
+      }
+      winner_cnts[testID] = cnt;
+    }
+  }
+
+  /// One selection event; returns the chosen position.
+  template<typename RANDOM_T>
+  size_t SelectOne(RANDOM_T & rnd) {
+    emp_assert(pop_size > 0 && num_tests > 0);
+    // First test case: pool is its precomputed winners.
+    std::swap(order[0], order[rnd.GetUInt(num_tests)]);
+    const word_t * win = winners.data() + order[0] * num_words;
+    std::copy(win, win + num_words, pool.begin());
+    size_t cnt = winner_cnts[order[0]];
+    for (size_t k = 1; k < num_tests && cnt > 1; ++k) {
+      std::swap(order[k], order[k + rnd.GetUInt(num_tests - k)]);
+      cnt = Filter(order[k]);
+    }
+    // Uniform pick among surviving positions (i.e. classes weighted by size).
+    size_t total = 0;
+    for (size_t w = 0; w < num_words; ++w) {
+      for (word_t bits = pool[w]; bits; bits &= bits - 1) total += GetClassSize(w * WORD_BITS + LowestBit(bits));
+    }
+    size_t pick = (total > 1) ? rnd.GetUInt(total) : 0;
+    for (size_t w = 0; w < num_words; ++w) {
+      for (word_t bits = pool[w]; bits; bits &= bits - 1) {
+        const size_t classID = w * WORD_BITS + LowestBit(bits);
+        const size_t size = GetClassSize(classID);
+        if (pick < size) return class_members[class_start[classID] + pick];
+        pick -= size;
+      }
+    }
+    emp_assert(false, "Empty lexicase pool");
+    return 0;
+  }
+
+  /// count selection events; appends the chosen positions to parents.
+  template<typename RANDOM_T>
+  void Select(size_t count, RANDOM_T & rnd, emp::vector<size_t> & parents) {
+    for (size_t n = 0; n < count; ++n) parents.emplace_back(SelectOne(rnd));
+  }
+};
+
+/// Lexicase selection into world (as emp::LexicaseSelect): lex must be prepared with scores by
+/// world position. Picks all parents first (using the world's random number generator), then gives
+/// birth to their offspring in order.
+template<typename WORLD_TYPE>
+void LexicaseSelectMatrix(WORLD_TYPE & world, LexicaseSelector & lex, size_t repro_count,
+                          emp::vector<size_t> & parents) {
+  emp_assert(lex.GetPopSize() == world.GetSize(), lex.GetPopSize(), world.GetSize());
+  parents.clear();
+  lex.Select(repro_count, world.GetRandom(), parents);
+  for (size_t parent : parents) world.DoBirth(world.GetGenomeAt(parent), parent);
+}
+
+#endif
@@ -32,6 +32,24 @@
 #include "TestcaseSet.h"
 #include "OthelloHW.h"
 #include "OthelloLookup.h"
+#include "OthelloGeometry.h"
+#include "OthelloFeatures.h"
+#include "SGPBindingTable.h"
+#include "SGPCompiledProgram.h"
+#include "SGPHardware.h"
+#include "SGPMemory.h"
+#include "SharedSGPProgram.h"
+#include "AGPCompiledProgram.h"
+#include "EvalHardware.h"
+#include "GeometricSkipSampler.h"
+#include "GenomeRecycler.h"
+#include "BatchReproduction.h"
+#include "FitnessSelection.h"
+#include "LexicaseSelection.h"
+#include "ResourceSelection.h"
+#include "MapElitesArchive.h"
+#include "CounterRandom.h"
+#include "MutationCounts.h"
 #include "lineage-config.h"
 
 // @constants
@@ -40,6 +58,7 @@ constexpr int TESTCASE_FILE__LIGHT_ID = -1;
 constexpr int TESTCASE_FILE__OPEN_ID = 0;
 
 constexpr size_t SGP__TAG_WIDTH = 16;
+constexpr size_t SGP__MEM_SIZE = 16;   ///< SignalGP memory keys (instruction arguments) are in [0, SGP__MEM_SIZE).
 
 constexpr size_t REPRESENTATION_ID__AVIDAGP = 0;
 constexpr size_t REPRESENTATION_ID__SIGNALGP = 1;
@@ -63,6 +82,9 @@ constexpr size_t SELECTION_METHOD_ID__ECOEA = 2;
 constexpr size_t SELECTION_METHOD_ID__MAPELITES = 3;
 constexpr size_t SELECTION_METHOD_ID__ROULETTE = 4;
 
+constexpr size_t ISLAND_TOPOLOGY_ID__RING = 0;   ///< Migrants come from the previous deme.
+constexpr size_t ISLAND_TOPOLOGY_ID__FULL = 1;   ///< Migrants come from any other deme.
+
 constexpr size_t RESOURCE_SELECT_MODE_ID__PHASES = 0;   ///< Each resource is a collection of testcase that share a range of game rounds.
 constexpr size_t RESOURCE_SELECT_MODE_ID__INDIV = 1;    ///< Each test case is a resource.
 
@@ -72,9 +94,25 @@ constexpr size_t POP_INITIALIZATION_METHOD_ID__RANDOM_POP = 1;
 constexpr size_t OTHELLO_BOARD_WIDTH = 8;
 constexpr size_t OTHELLO_BOARD_NUM_CELLS = OTHELLO_BOARD_WIDTH * OTHELLO_BOARD_WIDTH;
 
+constexpr size_t MUTATION_ID__INST_SUBSTITUTIONS = 0;
+constexpr size_t MUTATION_ID__ARG_SUBSTITUTIONS = 1;
+constexpr size_t MUTATION_ID__TAG_BIT_FLIPS = 2;
+constexpr size_t MUTATION_ID__INST_INSERTIONS = 3;
+constexpr size_t MUTATION_ID__INST_DELETIONS = 4;
+constexpr size_t MUTATION_ID__FUNC_DUPLICATIONS = 5;
+constexpr size_t MUTATION_ID__FUNC_DELETIONS = 6;
+constexpr size_t NUM_MUTATION_TYPES = 7;
+
+/// What a CounterRandom stream is for: streams are (update, agent, purpose).
+constexpr size_t RANDOM_PURPOSE_ID__INIT = 0;
+constexpr size_t RANDOM_PURPOSE_ID__SELECTION = 1;
+constexpr size_t RANDOM_PURPOSE_ID__MUTATION = 2;
+
+/// Output names for mutation types (indexed by MUTATION_ID__*).
 const emp::vector<std::string> MUTATION_TYPES = {"inst_substitutions", "arg_substitutions", "tag_bit_flips", "inst_insertions", "inst_deletions", "func_duplications", "func_deletions"};
 
 /// Setup a data_file with world that records information about the dominant genotype.
+/// mut_types[i] is the name of mutation type i (i.e. MUTATION_TYPES).
 template <typename WORLD_TYPE>
 emp::DataFile & AddDominantFile(WORLD_TYPE & world, const std::string & fpath="dominant.csv", emp::vector<std::string> mut_types = {"substitution"}){
     auto & file = world.SetupFile(fpath);
@@ -85,7 +123,7 @@ emp::DataFile & AddDominantFile(WORLD_TYPE & world, const std::string & fpath="d
     // Add file field for each mutation type.
     for (size_t i = 0; i < mut_types.size(); ++i) {
       std::string mut_type = mut_types[i];
-      std::function<int(void)> mut_fun = [&world, mut_type]() { return emp::CountMuts(world.GetGenotypeAt(0), mut_type); };
+      std::function<int(void)> mut_fun = [&world, i]() { return (int)CountLineageMuts(world.GetGenotypeAt(0), i); };
       file.AddFun(mut_fun, "dominant_"+mut_type+"_mutation_count", "sum of "+mut_type+" mutations along dominant organism's lineage");
     }
 
@@ -93,17 +131,19 @@ emp::DataFile & AddDominantFile(WORLD_TYPE & world, const std::string & fpath="d
       return emp::LineageLength(world.GetGenotypeAt(0));
     };
     std::function<int(void)> dom_lin_len_inst_sub = [&world](){
-      return emp::CountMutSteps(world.GetGenotypeAt(0), "inst_substitutions");
+      return CountLineageMutSteps(world.GetGenotypeAt(0), {MUTATION_ID__INST_SUBSTITUTIONS});
     };
     std::function<int(void)> dom_lin_len_all_sub = [&world](){
-      return emp::CountMutSteps(world.GetGenotypeAt(0), emp::vector<std::string>({"inst_substitutions", "arg_substitutions"}));
+      return CountLineageMutSteps(world.GetGenotypeAt(0), {MUTATION_ID__INST_SUBSTITUTIONS, MUTATION_ID__ARG_SUBSTITUTIONS});
     };
 
     std::function<int(void)> dom_lin_len_all_non_bit = [&world](){
-      return emp::CountMutSteps(world.GetGenotypeAt(0), emp::vector<std::string>({"inst_substitutions", "arg_substitutions", "inst_insertions", "inst_deletions", "func_duplications", "func_deletions"}));
+      return CountLineageMutSteps(world.GetGenotypeAt(0), {MUTATION_ID__INST_SUBSTITUTIONS, MUTATION_ID__ARG_SUBSTITUTIONS, MUTATION_ID__INST_INSERTIONS,
+                                                           MUTATION_ID__INST_DELETIONS, MUTATION_ID__FUNC_DUPLICATIONS, MUTATION_ID__FUNC_DELETIONS});
     };
     std::function<int(void)> dom_lin_len_all_non_bit_non_arg = [&world](){
-      return emp::CountMutSteps(world.GetGenotypeAt(0), emp::vector<std::string>({"inst_substitutions", "inst_insertions", "inst_deletions", "func_duplications", "func_deletions"}));
+      return CountLineageMutSteps(world.GetGenotypeAt(0), {MUTATION_ID__INST_SUBSTITUTIONS, MUTATION_ID__INST_INSERTIONS, MUTATION_ID__INST_DELETIONS,
+                                                           MUTATION_ID__FUNC_DUPLICATIONS, MUTATION_ID__FUNC_DELETIONS});
     };
 
     std::function<int(void)> dom_del_step = [&world](){
@@ -136,22 +176,94 @@ public:
   using player_t = othello_t::Player;
   using facing_t = othello_t::Facing;
   using othello_idx_t = othello_t::Index;
+  using othello_geom_t = OthelloGeometry<OTHELLO_BOARD_WIDTH>;
   // SignalGP-specific type aliases:
   using SGP__hardware_t = emp::EventDrivenGP_AW<SGP__TAG_WIDTH>;
   using SGP__program_t = SGP__hardware_t::Program;
-  using SGP__state_t = SGP__hardware_t::State;
+  using SGP__genome_t = SharedSGPProgram<SGP__hardware_t>;  ///< What SGP agents (and genotypes) hold.
+  using SGP__function_t = SGP__hardware_t::Function;
   using SGP__inst_t = SGP__hardware_t::inst_t;
   using SGP__inst_lib_t = SGP__hardware_t::inst_lib_t;
   using SGP__event_t = SGP__hardware_t::event_t;
   using SGP__event_lib_t = SGP__hardware_t::event_lib_t;
-  using SGP__memory_t = SGP__hardware_t::memory_t;
+  // Programs are EventDrivenGP programs, but they're evaluated on SGPHardware with dense
+  // (argument-indexed) memory: every memory access is an array index, and Call/Fork copy memory
+  // with a memcpy instead of copying a hash map.
+  using SGP__memory_t = SGPDenseMemory<SGP__MEM_SIZE>;
+  using SGP__eval_base_t = SGPHardware<SGP__TAG_WIDTH, SGP__memory_t>;
+  using SGP__eval_inst_lib_t = SGP__eval_base_t::inst_lib_t;
+  using SGP__state_t = SGP__eval_base_t::State;
   using SGP__tag_t = SGP__hardware_t::affinity_t;
+  using SGP__bind_table_t = SGPBindingTable<SGP__TAG_WIDTH>;
+  using SGP__compiled_t = SGPCompiledProgram<SGP__eval_base_t>;  ///< What SGP eval hardware runs.
 
   // AvidaGP-specific type aliases:
   using AGP__hardware_t = emp::AvidaGP;
   using AGP__program_t = AGP__hardware_t::genome_t;
   using AGP__inst_t = AGP__hardware_t::inst_t;
   using AGP__inst_lib_t = AGP__hardware_t::inst_lib_t;
+  using AGP__compiled_t = AGPCompiledProgram<AGP__hardware_t>;
+
+  /// Everything an instruction needs to know about the current evaluation.
+  /// Evaluation hardware carries a pointer to one of these, so instructions can be static functions.
+  struct EvalContext {
+    emp::Ptr<OthelloHardware> dreamware = nullptr;        ///< Agent's dream boards.
+    emp::Ptr<othello_t> board = nullptr;                  ///< Active dream board.
+    player_t playerID = player_t::DARK;                   ///< Who is the agent playing as?
+    emp::Ptr<const othello_t> turn_board = nullptr;       ///< Board at the beginning of the current turn.
+    emp::Ptr<OthelloLookup> lookup = nullptr;             ///< Othello lookup table.
+    emp::Ptr<SGP__bind_table_t> sgp_bind_table = nullptr; ///< Tag bindings for the program loaded on SGP eval hardware.
+    emp::Ptr<AGP__compiled_t> agp_compiled = nullptr;     ///< Compiled genome loaded on AGP eval hardware.
+
+    /// Point board/playerID at the dreamware's active dream/player.
+    void SyncDreamware() {
+      board = &dreamware->GetActiveDreamOthello();
+      playerID = dreamware->GetPlayerID();
+    }
+
+    /// Start a turn on game as playerID: every dream starts out as game, and dream 0 is active.
+    void BeginTurn(const othello_t & game, player_t pID) {
+      dreamware->Reset(game);
+      dreamware->SetActiveDream(0);
+      dreamware->SetPlayerID(pID);
+      turn_board = &game;
+      SyncDreamware();
+    }
+  };
+
+  using SGP__eval_hw_t = EvalHardware<SGP__eval_base_t, EvalContext>;
+  using AGP__eval_hw_t = EvalHardware<AGP__hardware_t, EvalContext>;
+
+  /// Island model: one deme's evaluation unit, so that demes can be evaluated at the same time (one
+  /// worker each). It has its own copy of everything evaluation writes to: eval hardware (and its
+  /// random number generator, which breaks SGP tag-binding ties), dreamware, lookup table, tag
+  /// bindings, and the context its instructions see. The deme's agents stay in the shared world:
+  /// demes are contiguous blocks of one world with one systematics tracker, and only evaluation and
+  /// selection are per deme.
+  struct DemeEvaluator {
+    emp::Random random;
+    OthelloHardware dreamware;
+    OthelloLookup lookup;
+    SGP__bind_table_t sgp_bind_table;
+    EvalContext context;
+    emp::Ptr<SGP__eval_hw_t> sgp_eval_hw = nullptr;
+    emp::Ptr<AGP__eval_hw_t> agp_eval_hw = nullptr;
+
+    DemeEvaluator(int seed, size_t dream_cnt, const OthelloLookup & _lookup)
+      : random(seed), dreamware(dream_cnt), lookup(_lookup), sgp_bind_table(), context()
+    {
+      context.dreamware = &dreamware;
+      context.lookup = &lookup;
+      context.sgp_bind_table = &sgp_bind_table;
+      context.SyncDreamware();
+    }
+    DemeEvaluator(const DemeEvaluator &) = delete;   // context points into it.
+
+    ~DemeEvaluator() {
+      sgp_eval_hw.Delete();
+      agp_eval_hw.Delete();
+    }
+  };
 
   struct Agent {
     size_t agent_id;
@@ -160,43 +272,56 @@ public:
   };
 
   /// SGP Target of evolution:
+  /// Genomes are built in (and returned to) recycled storage; see GenomeRecycler. Their function
+  /// blocks are recycled by SharedSGPProgram.
   struct SignalGPAgent : Agent {
     using Agent::agent_id;
-    SGP__program_t program;
+    using recycler_t = GenomeRecycler<SGP__genome_t>;
+    SGP__genome_t program;
 
-    SignalGPAgent(const SGP__program_t & _p)
-      : program(_p)
+    SignalGPAgent(const SGP__genome_t & _p)
+      : program(recycler_t::Copy(_p))
     { ; }
 
-    SignalGPAgent(const SignalGPAgent && in)
-      : Agent(in), program(in.program)
+    SignalGPAgent(SignalGPAgent && in)
+      : Agent(in), program(std::move(in.program))
     { ; }
 
     SignalGPAgent(const SignalGPAgent & in)
-      : Agent(in), program(in.program)
+      : Agent(in), program(recycler_t::Copy(in.program))
     { ; }
 
-    SGP__program_t & GetGenome() { return program; }
+    ~SignalGPAgent() {
+      program.Clear(); // Blocks no one else holds go to SharedSGPProgram's block pool.
+      if (program.GetCapacity()) recycler_t::Recycle(std::move(program)); // (Not if moved from.)
+    }
+
+    SGP__genome_t & GetGenome() { return program; }
 
   };
 
   /// AGP target of evolution:
   struct AvidaGPAgent : Agent {
     using Agent::agent_id;
+    using recycler_t = GenomeRecycler<AGP__program_t>;
     AGP__program_t program;
 
     AvidaGPAgent(const AGP__program_t & _p)
-    : Agent(), program(_p)
+    : Agent(), program(recycler_t::Copy(_p))
     { ; }
 
-    AvidaGPAgent(const AvidaGPAgent && in)
-      : Agent(in), program(in.program)
+    AvidaGPAgent(AvidaGPAgent && in)
+      : Agent(in), program(std::move(in.program))
     { ; }
 
     AvidaGPAgent(const AvidaGPAgent & in)
-      : Agent(in), program(in.program)
+      : Agent(in), program(recycler_t::Copy(in.program))
     { ; }
 
+    ~AvidaGPAgent() {
+      if (program.sequence.capacity()) recycler_t::Recycle(std::move(program)); // (Not if moved from.)
+    }
+
     AGP__program_t & GetGenome() { return program; }
   };
 
@@ -225,8 +350,25 @@ public:
 
   // More aliases
   using phenotype_t = emp::vector<double>;
-  using data_t = emp::mut_landscape_info<phenotype_t>;
-  using mut_count_t = std::unordered_map<std::string, double>;
+
+  /// Genotype-level data: mutational landscape info + anything we only want to build once per genome.
+  struct GenotypeData : MutCountData<phenotype_t, NUM_MUTATION_TYPES> {
+    SGP__compiled_t sgp_compiled; ///< Compiled (lowered for SGP eval hardware) SignalGP program.
+    AGP__compiled_t agp_compiled; ///< Compiled (scope-exit resolved) AvidaGP genome.
+  };
+
+  using data_t = GenotypeData;
+  using mut_count_t = mut_counts_t<NUM_MUTATION_TYPES>;
+
+  /// What a mutation operator did to the last genome it mutated, plus its scratch space.
+  /// Mutation operators only touch their MutatorState, so each reproduction worker gets its own.
+  struct MutatorState {
+    mut_count_t muts;              ///< Mutation counts (by MUTATION_ID__*).
+    emp::vector<size_t> ins_locs;  ///< SGP: insertion sites in the function being mutated.
+    emp::vector<size_t> del_locs;  ///< SGP: deletion sites in the function being mutated.
+
+    MutatorState() : muts(), ins_locs(), del_locs() { muts.fill(0); }
+  };
   using SGP__world_t = emp::World<SignalGPAgent, data_t>;
   using AGP__world_t = emp::World<AvidaGPAgent, data_t>;
   using SGP__genotype_t = SGP__world_t::genotype_t;
@@ -257,12 +399,24 @@ protected:
   double RESOURCE_SELECT__MAX_BONUS;
   double RESOURCE_SELECT__COST;
   size_t RESOURCE_SELECT__GAME_PHASE_LEN;
+  size_t REPRO_THREADS;
+  size_t MAP_ELITES__PHASE_BINS;
+  size_t MAP_ELITES__LENGTH_BINS;
+  size_t MAP_ELITES__ARCHIVE_INTERVAL;
+  // Island model parameters
+  size_t ISLAND__DEME_CNT;
+  size_t ISLAND__MIGRATION_INTERVAL;
+  size_t ISLAND__MIGRANT_CNT;
+  size_t ISLAND__TOPOLOGY;
+  bool ISLAND__DEME_SYSTEMATICS;
   // Scoring Group parameters
   double SCORE_MOVE__ILLEGAL_MOVE_VALUE;
   double SCORE_MOVE__LEGAL_MOVE_VALUE;
   double SCORE_MOVE__EXPERT_MOVE_VALUE;
   // Othello Group parameters
   size_t OTHELLO_HW_BOARDS;
+  bool OTHELLO_HW_CHECKPOINTS;
+  bool OTHELLO_HW_FEATURES;
   // SignalGP program group parameters
   size_t SGP_FUNCTION_LEN;
   size_t SGP_FUNCTION_CNT;
@@ -306,17 +460,41 @@ protected:
   using test_case_t = typename TestcaseSet<TestcaseInput, TestcaseOutput>::test_case_t;
   size_t cur_testcase;  ///< What's the current test case that *someone* is solving?
   // Fitness function sets.
-  emp::vector<std::function<double(SignalGPAgent &)>> sgp_lexicase_fit_set; ///< Fit set for SGP lexicase selection.
-  emp::vector<std::function<double(AvidaGPAgent &)>> agp_lexicase_fit_set;  ///< Fit set for AGP lexicase selection.
-  emp::vector<std::function<double(SignalGPAgent &)>> sgp_resource_fit_set; ///< Fit set for SGP resource selection.
-  emp::vector<std::function<double(AvidaGPAgent &)>> agp_resource_fit_set;  ///< Fit set for AGP resource selection.
+  LexicaseSelector lexicase;             ///< Population x test case scores for lexicase selection.
+  emp::vector<size_t> lexicase_parents;  ///< Scratch: parents picked by lexicase selection.
+  ResourceSelector resource_selector;    ///< Population x resource scores for Eco-EA.
 
   emp::vector<Phenotype> agent_phen_cache;
 
-  mut_count_t last_mutation;
+  mut_count_t last_mutation;                  ///< Mutations of the offspring being born (recorded for new genotypes).
+  GeometricSkipSampler sgp_tag_bflip_sampler; ///< Finds tag bits to flip (SGP_PER_BIT__TAG_BFLIP_RATE).
+  GeometricSkipSampler sgp_inst_sub_sampler;  ///< Finds instructions/arguments to substitute (SGP_PER_INST__SUB_RATE).
+  GeometricSkipSampler agp_inst_sub_sampler;  ///< Finds instructions/arguments to substitute (AGP_PER_INST__SUB_RATE).
+  GeometricSkipSampler sgp_inst_del_sampler;  ///< Finds instructions to delete (SGP_PER_INST__DEL_RATE).
+  MutatorState mutator;                       ///< Mutation state for serial (in-world) reproduction.
+  CounterRandom rng;                          ///< Mutation/selection/initialization randomness, keyed by the run's seed.
+  size_t birth_cnt;                           ///< In-world mutations so far this update (agent ID for their streams).
+
+  // Batched reproduction (REPRO_THREADS > 0); parents/fitness/roulette table also serve the serial fitness-array selection paths.
+  bool repro_premutated;                          ///< Are the offspring being born already mutated?
+  size_t repro_elite_cnt;                         ///< How many offspring (at the front of each block) are unmutated copies?
+  size_t repro_block_size;                        ///< Offspring come in blocks (one per deme) of this many.
+  emp::vector<size_t> repro_parents;              ///< Parent position of each offspring (elites first).
+  emp::vector<mut_count_t> repro_muts;            ///< Mutations applied to each offspring.
+  emp::vector<MutatorState> repro_mutators;       ///< One per worker.
+  emp::vector<CounterRandom> repro_rngs;          ///< One per worker.
+  emp::vector<SGP__genome_t> sgp_offspring;       ///< Offspring genome buffers (reused every update).
+  emp::vector<AGP__program_t> agp_offspring;
+  emp::vector<double> repro_fitness;              ///< Fitness by position (see CalcReproFitness).
+  AliasTable roulette_table;                      ///< Roulette selection: built from repro_fitness.
+  emp::vector<double> deme_fitness;               ///< Scratch: one deme's slice of repro_fitness.
+  emp::vector<size_t> repro_scratch;
+  std::function<size_t(SGP__genome_t &, CounterRandom &, MutatorState &)> sgp_mutate; ///< Configured SGP mutation operator.
 
   emp::vector<emp::vector<size_t>> testcases_by_phase;  ///< Testcase IDs organized by game phase (the length of which is defined by RESOURCE_SELECT__GAME_PHASE_LEN)
   emp::vector<emp::Resource> resources;                 ///< Resources for emp::ResourceSelect. One for each game phase.
+  MapElitesArchive mape_archive;  ///< MAP-Elites: elites by expert move rate in each game phase and/or program length.
+  emp::vector<double> mape_desc;  ///< Scratch: one agent's MAP-Elites descriptors.
 
   // emp::CollectionDataFile<std::unordered_set<emp::Ptr<SGP__genotype_t>, typename emp::Ptr<SGP__genotype_t>::hash_t>*> sgp_muller_file;
   // emp::CollectionDataFile<std::unordered_set<emp::Ptr<AGP__genotype_t>, typename emp::Ptr<AGP__genotype_t>::hash_t>*> agp_muller_file;
@@ -328,13 +506,20 @@ protected:
   // SignalGP-specifics.
   emp::Ptr<SGP__world_t> sgp_world;         ///< World for evolving SignalGP agents.
   emp::Ptr<SGP__inst_lib_t> sgp_inst_lib;   ///< SignalGP instruction library.
+  emp::Ptr<SGP__eval_inst_lib_t> sgp_eval_inst_lib; ///< Same instruction set, for sgp_eval_hw.
   emp::Ptr<SGP__event_lib_t> sgp_event_lib; ///< SignalGP event library.
-  emp::Ptr<SGP__hardware_t> sgp_eval_hw;    ///< Hardware used to evaluate SignalGP programs during evolution/analysis.
+  emp::Ptr<SGP__eval_hw_t> sgp_eval_hw;     ///< Hardware used to evaluate SignalGP programs during evolution/analysis.
+  emp::Ptr<SGP__program_t> sgp_eval_program; ///< Flat copy of the (shared) program being compiled.
+  SGP__bind_table_t sgp_bind_table;         ///< Tag bindings for the program currently loaded on sgp_eval_hw.
 
   // AvidaGP-specifics.
   emp::Ptr<AGP__world_t> agp_world;         ///< World for evolving AvidaGP agents.
   emp::Ptr<AGP__inst_lib_t> agp_inst_lib;   ///< AvidaGP instruction library.
-  emp::Ptr<AGP__hardware_t> agp_eval_hw;    ///< Hardware used to evaluate AvidaGP programs during evolution/analysis.
+  emp::Ptr<AGP__eval_hw_t> agp_eval_hw;     ///< Hardware used to evaluate AvidaGP programs during evolution/analysis.
+
+  EvalContext eval_context; ///< Evaluation context shared by the evaluation hardware.
+  emp::vector<emp::Ptr<DemeEvaluator>> deme_evaluators; ///< Island model: one evaluation unit per deme (experiment runs only).
+  emp::Ptr<WorkerPool> workers;             ///< Batched reproduction/island model workers (for the whole run).
 
   // --- Signals and functors! ---
   // Many of these are hardware-specific.
@@ -351,32 +536,28 @@ protected:
   emp::Signal<void(size_t pos, const phenotype_t &)> record_phen_sig;  ///< Trigger signal before organism gives birth.
   // Agent evaluation signals.
   emp::Signal<void(const othello_t &)> begin_turn_sig; ///< Called at beginning of agent turn during evaluation.
-  emp::Signal<void(void)> agent_advance_sig;              ///< Called during agent's turn. Should cause agent to advance by a single timestep.
 
+  std::function<size_t(size_t)> run_eval_agent;                 ///< Should run eval_hardware for up to N timesteps (stopping early once it's done) and return timesteps used. Hardware-specific!
   std::function<size_t(void)> get_eval_agent_move;              ///< Should return eval_hardware's current move selection. Hardware-specific!
-  std::function<bool(void)> get_eval_agent_done;                ///< Should return whether or not eval_hardware is done. Hardware-specific!
   std::function<player_t(void)> get_eval_agent_playerID;          ///< Should return eval_hardware's current playerID. Hardware-specific!
   std::function<double(test_case_t &, othello_idx_t)> calc_test_score; ///< Given a test case and a move, what is the appropriate score? Shared between hardware types.
 
   /// Get othello board index given *any* position.
   /// If position can't be used to make an Othello::Index struct, clamp it so that it can.
-  othello_idx_t GetOthelloIndex(size_t pos) {
+  static othello_idx_t GetOthelloIndex(size_t pos) {
     return (pos > OTHELLO_BOARD_NUM_CELLS) ? OTHELLO_BOARD_NUM_CELLS : pos;
   }
   /// Evaluate GP move (hardware-agnostic).
   /// Requires that the following signals/functors be setup:
   ///  - begin_turn_sig
-  ///  - agent_advance_sig
-  ///  - get_eval_agent_done
+  ///  - run_eval_agent
   ///  - get_eval_agent_move
   ///  - get_eval_agent_playerID
   othello_idx_t EvalMove__GP(othello_t & game, bool promise_validity=false) {
     // Signal begin_turn
     begin_turn_sig.Trigger(game);
     // Run agent until time is up or until agent indicates it is done evaluating.
-    for (eval_time = 0; eval_time < EVAL_TIME && !get_eval_agent_done(); ++eval_time) {
-      agent_advance_sig.Trigger();
-    }
+    eval_time = run_eval_agent(EVAL_TIME);
     // Extract agent's move.
     othello_idx_t move = GetOthelloIndex(get_eval_agent_move());
     // Did we promise a valid move?
@@ -471,6 +652,19 @@ protected:
   /// Run all tests on current eval hardware.
   void Evaluate(Agent & agent) {
     const size_t id = agent.GetID();
+    const double score = ScorePhenotype(id, [this, id](size_t testID) {
+      cur_testcase = testID;
+      return this->RunTest(id, testID);
+    });
+    // Trigger systematics-recording functions:
+    record_fit_sig.Trigger(id, score);
+    record_phen_sig.Trigger(id, agent_phen_cache[id].testcase_scores); // TODO: pass reference instead of full vector.
+  }
+
+  /// Fill in agent id's phenotype from its score on each test case (run_test(testID) runs it on
+  /// one and returns its score). Returns the agent's aggregate score.
+  template<typename TEST_FUN>
+  double ScorePhenotype(size_t id, TEST_FUN && run_test) {
     Phenotype & phen = agent_phen_cache[id];
     // Reset score and various phenotype information.
     double score = 0.0;
@@ -478,9 +672,9 @@ protected:
     phen.valid_move_total = 0;
     phen.expert_move_total = 0;
     // Evaluate agent on all test cases.
-    for (cur_testcase = 0; cur_testcase < testcases.GetSize(); ++cur_testcase) {
-      const double test_score = this->RunTest(id, cur_testcase);
-      phen.testcase_scores[cur_testcase] = test_score;
+    for (size_t testID = 0; testID < testcases.GetSize(); ++testID) {
+      const double test_score = run_test(testID);
+      phen.testcase_scores[testID] = test_score;
       if (test_score == SCORE_MOVE__EXPERT_MOVE_VALUE) {
         phen.expert_move_total += 1;
         phen.valid_move_total += 1;
@@ -495,9 +689,7 @@ protected:
       score += test_score;
     }
     phen.aggregate_score = score;
-    // Trigger systematics-recording functions:
-    record_fit_sig.Trigger(id, score);
-    record_phen_sig.Trigger(id, phen.testcase_scores); // TODO: pass reference instead of full vector.
+    return score;
   }
 
   /// Run test return test score.
@@ -508,20 +700,11 @@ protected:
     return calc_test_score(test, move);
   }
 
-  facing_t IntToFacing(int dir) {
-    dir = emp::Mod(dir, othello_t::NUM_DIRECTIONS);
-    switch(dir) {
-      case 0: return facing_t::N;
-      case 1: return facing_t::NE;
-      case 2: return facing_t::E;
-      case 3: return facing_t::SE;
-      case 4: return facing_t::S;
-      case 5: return facing_t::SW;
-      case 6: return facing_t::W;
-      case 7: return facing_t::NW;
-    }
-    emp_assert(false); return facing_t::N; //< Should never get here.
-  }
+  // SGP instructions are templated on hardware: the EventDrivenGP versions only fill sgp_inst_lib
+  // (what programs are built from); programs are run on SGP__eval_hw_t.
+  static EvalContext & GetEvalContext(SGP__hardware_t & hw) { return EvalHardware<SGP__hardware_t, EvalContext>::GetContext(hw); }
+  static EvalContext & GetEvalContext(SGP__eval_base_t & hw) { return SGP__eval_hw_t::GetContext(hw); }
+  static EvalContext & GetEvalContext(AGP__hardware_t & hw) { return AGP__eval_hw_t::GetContext(hw); }
 
   // Elite select mask.
   template<typename WORLD_TYPE>
@@ -532,7 +715,7 @@ protected:
 
 public:
   LineageExp(const LineageConfig & config)   // @constructor
-    : update(0), eval_time(0), OTHELLO_MAX_ROUND_CNT(0), best_agent_id(0), testcases(), cur_testcase(0), last_mutation()//,
+    : update(0), eval_time(0), OTHELLO_MAX_ROUND_CNT(0), best_agent_id(0), testcases(), cur_testcase(0), last_mutation(), birth_cnt(0), repro_premutated(false), repro_elite_cnt(0), repro_block_size(0)//,
       // sgp_muller_file(DATA_DIRECTORY + "muller_data.dat"),
       // agp_muller_file(DATA_DIRECTORY + "muller_data.dat")
   {
@@ -558,10 +741,21 @@ public:
     RESOURCE_SELECT__MAX_BONUS = config.RESOURCE_SELECT__MAX_BONUS();
     RESOURCE_SELECT__COST = config.RESOURCE_SELECT__COST();
     RESOURCE_SELECT__GAME_PHASE_LEN = config.RESOURCE_SELECT__GAME_PHASE_LEN();
+    REPRO_THREADS = config.REPRO_THREADS();
+    MAP_ELITES__PHASE_BINS = config.MAP_ELITES__PHASE_BINS();
+    MAP_ELITES__LENGTH_BINS = config.MAP_ELITES__LENGTH_BINS();
+    MAP_ELITES__ARCHIVE_INTERVAL = config.MAP_ELITES__ARCHIVE_INTERVAL();
+    ISLAND__DEME_CNT = config.ISLAND__DEME_CNT();
+    ISLAND__MIGRATION_INTERVAL = config.ISLAND__MIGRATION_INTERVAL();
+    ISLAND__MIGRANT_CNT = config.ISLAND__MIGRANT_CNT();
+    ISLAND__TOPOLOGY = config.ISLAND__TOPOLOGY();
+    ISLAND__DEME_SYSTEMATICS = config.ISLAND__DEME_SYSTEMATICS();
     SCORE_MOVE__ILLEGAL_MOVE_VALUE = config.SCORE_MOVE__ILLEGAL_MOVE_VALUE();
     SCORE_MOVE__LEGAL_MOVE_VALUE = config.SCORE_MOVE__LEGAL_MOVE_VALUE();
     SCORE_MOVE__EXPERT_MOVE_VALUE = config.SCORE_MOVE__EXPERT_MOVE_VALUE();
     OTHELLO_HW_BOARDS = config.OTHELLO_HW_BOARDS();
+    OTHELLO_HW_CHECKPOINTS = config.OTHELLO_HW_CHECKPOINTS();
+    OTHELLO_HW_FEATURES = config.OTHELLO_HW_FEATURES();
     SGP_FUNCTION_LEN = config.SGP_FUNCTION_LEN();
     SGP_FUNCTION_CNT = config.SGP_FUNCTION_CNT();
     SGP_PROG_MAX_LENGTH = config.SGP_PROG_MAX_LENGTH();
@@ -572,9 +766,13 @@ public:
     SGP_PER_BIT__TAG_BFLIP_RATE = config.SGP_PER_BIT__TAG_BFLIP_RATE();
     SGP_PER_INST__SUB_RATE = config.SGP_PER_INST__SUB_RATE();
     AGP_PER_INST__SUB_RATE = config.AGP_PER_INST__SUB_RATE();
+    sgp_tag_bflip_sampler.SetP(SGP_PER_BIT__TAG_BFLIP_RATE);
+    sgp_inst_sub_sampler.SetP(SGP_PER_INST__SUB_RATE);
+    agp_inst_sub_sampler.SetP(AGP_PER_INST__SUB_RATE);
     SGP_VARIABLE_LENGTH = config.SGP_VARIABLE_LENGTH();
     SGP_PER_INST__INS_RATE = config.SGP_PER_INST__INS_RATE();
     SGP_PER_INST__DEL_RATE = config.SGP_PER_INST__DEL_RATE();
+    sgp_inst_del_sampler.SetP(SGP_PER_INST__DEL_RATE);
     SGP_PER_FUNC__FUNC_DUP_RATE = config.SGP_PER_FUNC__FUNC_DUP_RATE();
     SGP_PER_FUNC__FUNC_DEL_RATE = config.SGP_PER_FUNC__FUNC_DEL_RATE();
     SYSTEMATICS_INTERVAL = config.SYSTEMATICS_INTERVAL();
@@ -586,13 +784,48 @@ public:
 
     // Make a random number generator.
     random = emp::NewPtr<emp::Random>(RANDOM_SEED);
+    rng.SetSeed((uint64_t)random->GetSeed());
 
     // What is the maximum number of rounds for an othello game?
     OTHELLO_MAX_ROUND_CNT = (OTHELLO_BOARD_WIDTH * OTHELLO_BOARD_WIDTH) - 4;
 
-    for (size_t i = 0; i < MUTATION_TYPES.size(); ++i) {
-      last_mutation.emplace(MUTATION_TYPES[i], 0);
+    last_mutation.fill(0);
+
+    if (REPRO_THREADS > 0 && SELECTION_METHOD == SELECTION_METHOD_ID__ECOEA) {
+      std::cout << "Eco-EA selection doesn't support batched reproduction (REPRO_THREADS > 0). Reproducing serially." << std::endl;
+      REPRO_THREADS = 0;
     }
+    if (ISLAND__DEME_CNT == 0) ISLAND__DEME_CNT = 1;
+    if (ISLAND__DEME_CNT > 1) {
+      if (SELECTION_METHOD == SELECTION_METHOD_ID__ECOEA || SELECTION_METHOD == SELECTION_METHOD_ID__MAPELITES) {
+        std::cout << "Island model only supports tournament, lexicase, and roulette selection. Exiting..." << std::endl;
+        exit(-1);
+      }
+      if (ISLAND__TOPOLOGY != ISLAND_TOPOLOGY_ID__RING && ISLAND__TOPOLOGY != ISLAND_TOPOLOGY_ID__FULL) {
+        std::cout << "Unrecognized island topology. Exiting..." << std::endl;
+        exit(-1);
+      }
+      if (POP_SIZE % ISLAND__DEME_CNT) {
+        std::cout << "POP_SIZE must be a multiple of ISLAND__DEME_CNT. Exiting..." << std::endl;
+        exit(-1);
+      }
+      const size_t deme_size = POP_SIZE / ISLAND__DEME_CNT;
+      if (ELITE_SELECT__ELITE_CNT + ISLAND__MIGRANT_CNT >= deme_size) {
+        std::cout << "Demes are too small for ELITE_SELECT__ELITE_CNT elites plus ISLAND__MIGRANT_CNT migrants. Exiting..." << std::endl;
+        exit(-1);
+      }
+      if (REPRO_THREADS == 0) {
+        std::cout << "Island model always uses batched reproduction. Using REPRO_THREADS = 1." << std::endl;
+        REPRO_THREADS = 1;
+      }
+    }
+    if (REPRO_THREADS == 0 && SELECTION_METHOD == SELECTION_METHOD_ID__MAPELITES) {
+      std::cout << "MAP-Elites always uses batched reproduction. Using REPRO_THREADS = 1." << std::endl;
+      REPRO_THREADS = 1;
+    }
+    repro_mutators.resize(REPRO_THREADS);
+    repro_rngs.resize(REPRO_THREADS, rng);
+    workers = emp::NewPtr<WorkerPool>(emp::Max(REPRO_THREADS, ISLAND__DEME_CNT));
 
     // Load test cases.
     testcases.RegisterTestcaseReader([this](emp::vector<std::string> & strs) { return this->GenerateTestcase(strs); });
@@ -610,8 +843,7 @@ public:
       agent_phen_cache[i].aggregate_score = 0;
     }
 
-    // Testing out othello lookup
-    OthelloLookup othello_lookup;
+    // Pre-cache the test case boards in the lookup table the evaluation context uses.
     std::cout << "Caching all test case boards..." << std::endl;
     for (size_t i = 0; i < testcases.GetSize(); ++i) {
       othello_lookup.CacheBoard(testcases[i].GetInput().game);
@@ -654,6 +886,29 @@ public:
         exit(-1);
     }
 
+    // Setup MAP-Elites archive axes: expert move rate in each game phase, then program length.
+    if (SELECTION_METHOD == SELECTION_METHOD_ID__MAPELITES) {
+      if (MAP_ELITES__PHASE_BINS) {
+        for (size_t i = 0; i < testcases_by_phase.size(); ++i) mape_archive.AddAxis(0.0, 1.0, MAP_ELITES__PHASE_BINS);
+      }
+      if (MAP_ELITES__LENGTH_BINS) {
+        const size_t max_len = (REPRESENTATION == REPRESENTATION_ID__SIGNALGP) ? SGP_PROG_MAX_LENGTH : AGP_GENOME_SIZE;
+        mape_archive.AddAxis(0.0, (double)max_len, MAP_ELITES__LENGTH_BINS);
+      }
+      if (mape_archive.GetNumDims() == 0) {
+        std::cout << "MAP-Elites needs at least one descriptor (MAP_ELITES__PHASE_BINS or MAP_ELITES__LENGTH_BINS). Exiting..." << std::endl;
+        exit(-1);
+      }
+      mape_archive.Reset();
+      mape_desc.resize(mape_archive.GetNumDims());
+      // Every elite is carried over into the next population, so they all have to fit (with room for offspring).
+      if (mape_archive.GetNumCells() >= POP_SIZE) {
+        std::cout << "MAP-Elites archive (" << mape_archive.GetNumCells() << " cells) must be smaller than POP_SIZE. Exiting..." << std::endl;
+        exit(-1);
+      }
+      std::cout << "MAP-Elites archive: " << mape_archive.GetNumCells() << " cells." << std::endl;
+    }
+
     // Because roulette select can't take negative scores, make sure we'll never
     // return negative values from calc_test_score (i.e. check user-input parameters)
     if (SCORE_MOVE__ILLEGAL_MOVE_VALUE <= 0 || SCORE_MOVE__LEGAL_MOVE_VALUE <= 0 || SCORE_MOVE__EXPERT_MOVE_VALUE <= 0) {
@@ -695,7 +950,19 @@ public:
     }
 
     // Configure the dreamware!
-    othello_dreamware = emp::NewPtr<OthelloHardware>(1);
+    if (OTHELLO_HW_BOARDS < 1) {
+      std::cout << "Agents need at least one othello hardware board. Exiting..." << std::endl;
+      exit(-1);
+    }
+    othello_dreamware = emp::NewPtr<OthelloHardware>(OTHELLO_HW_BOARDS);
+
+    // Configure the evaluation context.
+    eval_context.dreamware = othello_dreamware;
+    eval_context.lookup = &othello_lookup;
+    eval_context.sgp_bind_table = &sgp_bind_table;
+    eval_context.SyncDreamware();
+    // Island model: evaluation units for evaluating demes concurrently.
+    if (RUN_MODE == RUN_ID__EXP && ISLAND__DEME_CNT > 1) MakeDemeEvaluators();
 
     // Make the world(s)!
     // - SGP World -
@@ -704,6 +971,7 @@ public:
 
     // Configure instruction/event libraries.
     sgp_inst_lib = emp::NewPtr<SGP__inst_lib_t>();
+    sgp_eval_inst_lib = emp::NewPtr<SGP__eval_inst_lib_t>();
     sgp_event_lib = emp::NewPtr<SGP__event_lib_t>();
     agp_inst_lib = emp::NewPtr<AGP__inst_lib_t>();
 
@@ -733,10 +1001,14 @@ public:
     sgp_world.Delete();
     agp_world.Delete();
     sgp_inst_lib.Delete();
+    sgp_eval_inst_lib.Delete();
     agp_inst_lib.Delete();
     sgp_event_lib.Delete();
     sgp_eval_hw.Delete();
+    sgp_eval_program.Delete();
     agp_eval_hw.Delete();
+    for (emp::Ptr<DemeEvaluator> de : deme_evaluators) de.Delete();
+    workers.Delete();
   }
 
   void Run() {
@@ -749,6 +1021,10 @@ public:
         for (update = 0; update <= GENERATIONS; ++update) {
           RunStep();
           if (update % POP_SNAPSHOT_INTERVAL == 0) do_pop_snapshot_sig.Trigger(update);
+          if (SELECTION_METHOD == SELECTION_METHOD_ID__MAPELITES && MAP_ELITES__ARCHIVE_INTERVAL
+              && update % MAP_ELITES__ARCHIVE_INTERVAL == 0) {
+            mape_archive.WriteBinary(DATA_DIRECTORY + "map_elites_" + emp::to_string((int)update) + ".bin", update);
+          }
         }
 
         std::clock_t base_tot_time = std::clock() - base_start_time;
@@ -770,6 +1046,7 @@ public:
 
   /// Do a single step of evolution.
   void RunStep() {
+    birth_cnt = 0;
     do_evaluation_sig.Trigger();    // Update agent scores.
     do_selection_sig.Trigger();     // Do selection (selection, reproduction, mutation).
     do_world_update_sig.Trigger();  // Do world update (population turnover, clear score caches).
@@ -782,14 +1059,38 @@ public:
 
   // Config functions. These do all of the hardware-specific experiment setup/configuration.
   void ConfigSGP();
-  void ConfigSGP_InstLib();
+  template<typename HW_T, typename INST_LIB_T>
+  void ConfigSGP_InstLib(INST_LIB_T & inst_lib);
   void ConfigAGP();
   void ConfigAGP_InstLib();
 
   // Mutation functions
-  size_t SGP__Mutate_FixedLength(SignalGPAgent & agent, emp::Random & rnd);
-  size_t SGP__Mutate_VariableLength(SignalGPAgent & agent, emp::Random & rnd);
-  size_t AGP__Mutate(AvidaGPAgent & agent, emp::Random & rnd);
+  size_t SGP__Mutate_Substitutions(SGP__genome_t & program, size_t fID, CounterRandom & rnd, MutatorState & mstate);
+  size_t SGP__Mutate_Indels(SGP__genome_t & program, size_t fID, size_t & expected_prog_len, CounterRandom & rnd, MutatorState & mstate);
+  size_t SGP__Mutate_FixedLength(SGP__genome_t & program, CounterRandom & rnd, MutatorState & mstate);
+  size_t SGP__Mutate_VariableLength(SGP__genome_t & program, CounterRandom & rnd, MutatorState & mstate);
+  size_t AGP__Mutate(AGP__program_t & program, CounterRandom & rnd, MutatorState & mstate);
+
+  // Selection
+  void PrepareLexicase(size_t pop_size, size_t begin=0);
+  void CalcResourceScores(size_t pop_size);
+  static size_t GetGenomeLength(const SGP__genome_t & program) { return program.GetInstCnt(); }
+  static size_t GetGenomeLength(const AGP__program_t & program) { return program.sequence.size(); }
+  template<typename WORLD_TYPE>
+  void UpdateMapElitesArchive(WORLD_TYPE & world);
+
+  // Batched reproduction
+  void CalcReproFitness(size_t pop_size);
+  void SelectReproParents(size_t pop_size);
+  void SelectDemeParents(size_t begin, size_t deme_size, size_t count);
+  void SelectMigrantParents(size_t deme_size);
+  template<typename WORLD_TYPE, typename MUT_FUN>
+  void DoBatchedReproduction(WORLD_TYPE & world, emp::vector<typename WORLD_TYPE::genome_t> & offspring, MUT_FUN && mutate);
+
+  // Island model evaluation
+  void MakeDemeEvaluators();
+  template<typename WORLD_TYPE, typename LOAD_FUN, typename TURN_FUN>
+  void EvaluateDemes(WORLD_TYPE & world, LOAD_FUN && load_agent, TURN_FUN && run_turn);
 
   // Population snapshot functions
   void SGP_Snapshot_SingleFile(size_t update);
@@ -831,112 +1132,219 @@ public:
       return file;
   }
 
+  /// Island model: for each deme, its best and mean score, how many distinct genotypes it holds, and
+  /// its best agent's lineage length. (Demes share one phylogeny; this splits the summary by deme.)
+  template <typename WORLD_TYPE>
+  emp::DataFile & AddDemeSystematicsFile(WORLD_TYPE & world, const std::string & fpath="deme_systematics.csv") {
+      auto & file = world.SetupFile(fpath);
+
+      std::function<size_t(void)> get_update = [&world](){ return world.GetUpdate(); };
+      file.AddFun(get_update, "update", "Update");
+
+      const size_t deme_size = POP_SIZE / ISLAND__DEME_CNT;
+      for (size_t d = 0; d < ISLAND__DEME_CNT; ++d) {
+        const size_t begin = d * deme_size;
+        const std::string deme = "deme_" + emp::to_string(d);
+        // Best agent in the deme (agent_phen_cache is by position, same as best_phenotype.csv).
+        std::function<size_t(void)> get_best_id = [this, begin, deme_size]() {
+          size_t best_id = begin;
+          for (size_t id = begin + 1; id < begin + deme_size; ++id) {
+            if (this->agent_phen_cache[id].aggregate_score > this->agent_phen_cache[best_id].aggregate_score) best_id = id;
+          }
+          return best_id;
+        };
+        std::function<double(void)> get_max_score = [this, get_best_id]() {
+          return this->agent_phen_cache[get_best_id()].aggregate_score;
+        };
+        file.AddFun(get_max_score, deme + "_max_score", "best score in " + deme + " this update");
+
+        std::function<double(void)> get_mean_score = [this, begin, deme_size]() {
+          double total = 0.0;
+          for (size_t id = begin; id < begin + deme_size; ++id) total += this->agent_phen_cache[id].aggregate_score;
+          return total / (double)deme_size;
+        };
+        file.AddFun(get_mean_score, deme + "_mean_score", "mean score in " + deme + " this update");
+
+        std::function<size_t(void)> get_genotype_cnt = [&world, begin, deme_size]() {
+          emp::vector<const void *> genotypes(deme_size);
+          for (size_t i = 0; i < deme_size; ++i) genotypes[i] = world.GetGenotypeAt(begin + i).Raw();
+          std::sort(genotypes.begin(), genotypes.end());
+          return (size_t)(std::unique(genotypes.begin(), genotypes.end()) - genotypes.begin());
+        };
+        file.AddFun(get_genotype_cnt, deme + "_genotypes", "number of distinct genotypes in " + deme);
+
+        std::function<int(void)> get_lineage_len = [&world, get_best_id]() {
+          return emp::LineageLength(world.GetGenotypeAt(get_best_id()));
+        };
+        file.AddFun(get_lineage_len, deme + "_best_lineage_length", "count of changes in genotype in the lineage of " + deme + "'s best agent");
+      }
+      file.PrintHeaderKeys();
+      return file;
+  }
+
   // SignalGP utility functions.
   void SGP__InitPopulation_Random();
   void SGP__InitPopulation_FromAncestorFile();
-  void SGP__ResetHW(const SGP__memory_t & main_in_mem=SGP__memory_t());
+  static bool SGP__HasValidArgs(const SGP__program_t & program);
+  void SGP__ResetHW(const SGP__memory_t & main_in_mem=SGP__memory_t()) { SGP__ResetHW(*sgp_eval_hw, main_in_mem); }
+  static void SGP__ResetHW(SGP__eval_hw_t & hw, const SGP__memory_t & main_in_mem=SGP__memory_t());
+  void SGP__SetEvalProgram(const SGP__genome_t & program, SGP__compiled_t & compiled) {
+    SGP__Compile(program, compiled);
+    SGP__LoadProgram(*sgp_eval_hw, compiled);
+  }
+  void SGP__Compile(const SGP__genome_t & program, SGP__compiled_t & compiled);
+  void SGP__LoadProgram(SGP__eval_hw_t & hw, const SGP__compiled_t & compiled);
+  emp::Ptr<SGP__eval_hw_t> SGP__NewEvalHW(emp::Ptr<emp::Random> rnd, EvalContext & context);
+  void SGP__EvaluateDemes();
+  /// Is SignalGP eval hardware done with its turn? Either it says so, or it has no running threads
+  /// and none waiting to start (nothing ever queues events on eval hardware, so it can't do anything
+  /// else this turn). Spawned cores (including the main core, right after a reset) only become active
+  /// at the end of the next SingleProcess, so pending cores count as running.
+  static bool SGP__IsEvalDone(SGP__eval_hw_t & hw) {
+    return (bool)hw.GetTrait(TRAIT_ID__DONE) || (hw.GetActiveCores().empty() && hw.GetPendingCores().empty());
+  }
 
   //AvidaGP utility functions.
   void AGP__InitPopulation_Random();
   void AGP__InitPopulation_FromAncestorFile();
-  void AGP__ResetHW();
+  void AGP__ResetHW() { AGP__ResetHW(*agp_eval_hw); }
+  static void AGP__ResetHW(AGP__eval_hw_t & hw);
+  void AGP__SetEvalGenome(const AGP__program_t & genome, AGP__compiled_t & compiled) {
+    AGP__LoadGenome(*agp_eval_hw, genome, compiled);
+  }
+  static void AGP__LoadGenome(AGP__eval_hw_t & hw, const AGP__program_t & genome, AGP__compiled_t & compiled);
+  void AGP__EvaluateDemes();
+  /// Is AvidaGP eval hardware done with its turn?
+  static bool AGP__IsEvalDone(AGP__eval_hw_t & hw) { return (bool)hw.GetTrait(TRAIT_ID__DONE); }
 
   // SignalGP Analysis functions.
   void SGP__Debugging_Analysis();
 
   // -- AvidaGP Instructions --
+  // Scope-bypassing instructions
+  static void AGP__Inst_If(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_While(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_Countdown(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_Break(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_Define(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // BoardWidth
-  void AGP__Inst_GetBoardWidth(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_GetBoardWidth(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // EndTurn
-  void AGP__Inst_EndTurn(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_EndTurn(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // SetMove
-  void AGP__Inst_SetMoveXY(AGP__hardware_t &hw, const AGP__inst_t &inst);
-  void AGP__Inst_SetMoveID(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_SetMoveXY(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_SetMoveID(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // GetMove
-  void AGP__Inst_GetMoveXY(AGP__hardware_t &hw, const AGP__inst_t &inst);
-  void AGP__Inst_GetMoveID(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_GetMoveXY(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_GetMoveID(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // Adjacent
-  void AGP__Inst_AdjacentXY(AGP__hardware_t &hw, const AGP__inst_t &inst);
-  void AGP__Inst_AdjacentID(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_AdjacentXY(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_AdjacentID(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // ValidMovesCnt
-  void AGP__Inst_ValidMoveCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_ValidMoveCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // ValidOppMovesCnt
-  void AGP__Inst_ValidOppMoveCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_ValidOppMoveCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // GetBoardValue
-  void AGP__Inst_GetBoardValueXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
-  void AGP__Inst_GetBoardValueID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_GetBoardValueXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_GetBoardValueID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // IsValidXY
-  void AGP__Inst_IsValidXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
-  void AGP__Inst_IsValidID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_IsValidXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_IsValidID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // IsValidOpp
-  void AGP__Inst_IsValidOppXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
-  void AGP__Inst_IsValidOppID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_IsValidOppXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_IsValidOppID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // PlaceXY
-  void AGP__Inst_PlaceDiskXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
-  void AGP__Inst_PlaceDiskID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_PlaceDiskXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_PlaceDiskID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // PlaceOppXY
-  void AGP__Inst_PlaceOppDiskID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
-  void AGP__Inst_PlaceOppDiskXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_PlaceOppDiskID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_PlaceOppDiskXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // FlipCn_tXY
-  void AGP__Inst_FlipCntXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
-  void AGP__Inst_FlipCntID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_FlipCntXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_FlipCntID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // OppFli_pCntXY
-  void AGP__Inst_OppFlipCntXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
-  void AGP__Inst_OppFlipCntID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_OppFlipCntXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_OppFlipCntID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // FrontierCnt
-  void AGP__Inst_FrontierCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_FrontierCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // ResetBoard
-  void AGP__Inst_ResetBoard_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_ResetBoard_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
   // IsOver
-  void AGP__Inst_IsOver_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_IsOver_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  // SetActiveDream
+  static void AGP__Inst_SetActiveDream_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  // PushBoard, PopBoard
+  static void AGP__Inst_PushBoard_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_PopBoard_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  // Board features
+  static void AGP__Inst_DiscCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_OppDiscCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_CornerCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_OppCornerCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_GreedyMove_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
+  static void AGP__Inst_MobilityDiff_HW(AGP__hardware_t &hw, const AGP__inst_t &inst);
 
   // -- SignalGP Instructions --
+  // Call
+  template<typename HW_T> static void SGP__Inst_Call(HW_T & hw, const SGP__inst_t & inst);
   // Fork
-  void SGP__Inst_Fork(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_Fork(HW_T & hw, const SGP__inst_t & inst);
   // BoardWidth
-  void SGP_Inst_GetBoardWidth(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP_Inst_GetBoardWidth(HW_T & hw, const SGP__inst_t & inst);
   // EndTurn
-  void SGP_Inst_EndTurn(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP_Inst_EndTurn(HW_T & hw, const SGP__inst_t & inst);
   // SetMove
-  void SGP__Inst_SetMoveXY(SGP__hardware_t & hw, const SGP__inst_t & inst);
-  void SGP__Inst_SetMoveID(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_SetMoveXY(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_SetMoveID(HW_T & hw, const SGP__inst_t & inst);
   // GetMove
-  void SGP__Inst_GetMoveXY(SGP__hardware_t & hw, const SGP__inst_t & inst);
-  void SGP__Inst_GetMoveID(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_GetMoveXY(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_GetMoveID(HW_T & hw, const SGP__inst_t & inst);
   // Adjacent
-  void SGP__Inst_AdjacentXY(SGP__hardware_t & hw, const SGP__inst_t & inst);
-  void SGP__Inst_AdjacentID(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_AdjacentXY(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_AdjacentID(HW_T & hw, const SGP__inst_t & inst);
   // IsValid
-  void SGP__Inst_IsValidXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
-  void SGP__Inst_IsValidID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_IsValidXY_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_IsValidID_HW(HW_T & hw, const SGP__inst_t & inst);
   // IsValidOpp
-  void SGP__Inst_IsValidOppXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
-  void SGP__Inst_IsValidOppID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_IsValidOppXY_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_IsValidOppID_HW(HW_T & hw, const SGP__inst_t & inst);
   // ValidMovesCnt
-  void SGP__Inst_ValidMoveCnt_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_ValidMoveCnt_HW(HW_T & hw, const SGP__inst_t & inst);
   // ValidOppMovesCnt
-  void SGP__Inst_ValidOppMoveCnt_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_ValidOppMoveCnt_HW(HW_T & hw, const SGP__inst_t & inst);
   // GetBoardValue
-  void SGP__Inst_GetBoardValueXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
-  void SGP__Inst_GetBoardValueID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_GetBoardValueXY_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_GetBoardValueID_HW(HW_T & hw, const SGP__inst_t & inst);
   // Place
-  void SGP__Inst_PlaceDiskXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
-  void SGP__Inst_PlaceDiskID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_PlaceDiskXY_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_PlaceDiskID_HW(HW_T & hw, const SGP__inst_t & inst);
   // PlaceOpp
-  void SGP__Inst_PlaceOppDiskXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
-  void SGP__Inst_PlaceOppDiskID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_PlaceOppDiskXY_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_PlaceOppDiskID_HW(HW_T & hw, const SGP__inst_t & inst);
   // FlipCnt
-  void SGP__Inst_FlipCntXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
-  void SGP__Inst_FlipCntID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_FlipCntXY_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_FlipCntID_HW(HW_T & hw, const SGP__inst_t & inst);
   // OppFlipCnt
-  void SGP__Inst_OppFlipCntXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
-  void SGP__Inst_OppFlipCntID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_OppFlipCntXY_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_OppFlipCntID_HW(HW_T & hw, const SGP__inst_t & inst);
   // FrontierCnt
-  void SGP__Inst_FrontierCnt_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_FrontierCnt_HW(HW_T & hw, const SGP__inst_t & inst);
   // ResetBoard
-  void SGP__Inst_ResetBoard_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_ResetBoard_HW(HW_T & hw, const SGP__inst_t & inst);
   // IsOver
-  void SGP__Inst_IsOver_HW(SGP__hardware_t & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_IsOver_HW(HW_T & hw, const SGP__inst_t & inst);
+  // SetActiveDream
+  template<typename HW_T> static void SGP__Inst_SetActiveDream_HW(HW_T & hw, const SGP__inst_t & inst);
+  // PushBoard, PopBoard
+  template<typename HW_T> static void SGP__Inst_PushBoard_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_PopBoard_HW(HW_T & hw, const SGP__inst_t & inst);
+  // Board features
+  template<typename HW_T> static void SGP__Inst_DiscCnt_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_OppDiscCnt_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_CornerCnt_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_OppCornerCnt_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_GreedyMove_HW(HW_T & hw, const SGP__inst_t & inst);
+  template<typename HW_T> static void SGP__Inst_MobilityDiff_HW(HW_T & hw, const SGP__inst_t & inst);
 };
 
 // AvidaGP Functions
@@ -946,7 +1354,15 @@ void LineageExp::AGP__InitPopulation_Random()
   for (size_t p = 0; p < POP_SIZE; ++p)
   {
     AGP__hardware_t cpu(agp_inst_lib);
-    cpu.PushRandom(*random, AGP_GENOME_SIZE);
+    rng.SetStream(0, p, RANDOM_PURPOSE_ID__INIT);
+    for (size_t i = 0; i < AGP_GENOME_SIZE; ++i)
+    {
+      const size_t instID = rng.GetUInt(agp_inst_lib->GetSize());
+      const size_t a0 = rng.GetUInt(AGP__hardware_t::CPU_SIZE);
+      const size_t a1 = rng.GetUInt(AGP__hardware_t::CPU_SIZE);
+      const size_t a2 = rng.GetUInt(AGP__hardware_t::CPU_SIZE);
+      cpu.PushInst(instID, a0, a1, a2);
+    }
     agp_world->Inject(cpu.GetGenome(), 1);
   }
 }
@@ -969,35 +1385,29 @@ void LineageExp::AGP__InitPopulation_FromAncestorFile()
   agp_world->Inject(ancestor_prog.GetGenome(), 1); // Inject a bunch of ancestors into the population.
 }
 
-size_t LineageExp::AGP__Mutate(AvidaGPAgent &agent, emp::Random &rnd)
+size_t LineageExp::AGP__Mutate(AGP__program_t &program, CounterRandom &rnd, MutatorState &mstate)
 {
-  AGP__program_t &program = agent.GetGenome();
   size_t mut_cnt = 0;
-  for (size_t i = 0; i < MUTATION_TYPES.size(); ++i) {
-    last_mutation[MUTATION_TYPES[i]] = 0;
-  }
-  // Substitutions?
-  for (size_t i = 0; i < program.sequence.size(); ++i)
-  {
-    AGP__inst_t &inst = program.sequence[i];
-    // Mutate instruction.
-    if (rnd.P(AGP_PER_INST__SUB_RATE))
+  mstate.muts.fill(0);
+  // Substitutions? (site = (instruction, slot), where slot 0 is the instruction ID and slot k+1 is
+  // argument k; arguments are mutated even if they aren't relevent to instruction)
+  // Mutated sites are found by geometric skip-ahead sampling (see GeometricSkipSampler).
+  const size_t inst_slots = 1 + AGP__hardware_t::INST_ARGS;
+  agp_inst_sub_sampler.ForEachHit(program.sequence.size() * inst_slots, rnd, [&](size_t site) {
+    AGP__inst_t &inst = program.sequence[site / inst_slots];
+    const size_t slot = site % inst_slots;
+    if (slot == 0)
     {
-      ++mut_cnt;
-      ++last_mutation["inst_substitutions"];
+      ++mstate.muts[MUTATION_ID__INST_SUBSTITUTIONS];
       inst.id = rnd.GetUInt(program.inst_lib->GetSize());
     }
-    // Mutate arguments (even if they aren't relevent to instruction).
-    for (size_t k = 0; k < AGP__hardware_t::INST_ARGS; ++k)
+    else
     {
-      if (rnd.P(AGP_PER_INST__SUB_RATE))
-      {
-        ++mut_cnt;
-        ++last_mutation["arg_substitutions"];
-        inst.args[k] = rnd.GetInt(AGP__hardware_t::CPU_SIZE);
-      }
+      ++mstate.muts[MUTATION_ID__ARG_SUBSTITUTIONS];
+      inst.args[slot - 1] = rnd.GetInt(AGP__hardware_t::CPU_SIZE);
     }
-  }
+    ++mut_cnt;
+  });
 
   return mut_cnt;
 }
@@ -1031,37 +1441,108 @@ void LineageExp::AGP_Snapshot_SingleFile(size_t update)
   prog_ofstream.close();
 }
 
-void LineageExp::AGP__ResetHW()
+void LineageExp::AGP__ResetHW(AGP__eval_hw_t & hw)
+{
+  hw.ResetHardware();
+  hw.SetTrait(TRAIT_ID__MOVE, -1);
+  hw.SetTrait(TRAIT_ID__DONE, 0);
+}
+
+/// Load genome onto AvidaGP evaluation hardware.
+/// Compiles the genome if compiled isn't already up to date (i.e. first time we've seen this genotype).
+void LineageExp::AGP__LoadGenome(AGP__eval_hw_t & hw, const AGP__program_t & genome, AGP__compiled_t & compiled)
 {
-  agp_eval_hw->ResetHardware();
-  agp_eval_hw->SetTrait(TRAIT_ID__MOVE, -1);
-  agp_eval_hw->SetTrait(TRAIT_ID__DONE, 0);
+  if (!compiled.IsCompiled()) compiled.Compile(genome);
+  hw.GetContext().agp_compiled = &compiled;
+  hw.SetGenome(genome);
+}
+
+/// Island model: evaluate each deme's AvidaGP agents on its own evaluation unit (see EvaluateDemes).
+void LineageExp::AGP__EvaluateDemes() {
+  // Compile new genotypes up front: a genotype can be shared by agents in different demes.
+  for (size_t id = 0; id < agp_world->GetSize(); ++id) {
+    AGP__compiled_t & compiled = agp_world->GetGenotypeAt(id)->GetData().agp_compiled;
+    if (!compiled.IsCompiled()) compiled.Compile(agp_world->GetOrg(id).GetGenome());
+  }
+  EvaluateDemes(*agp_world,
+    [this](DemeEvaluator & de, size_t id) {
+      AGP__LoadGenome(*de.agp_eval_hw, agp_world->GetOrg(id).GetGenome(), agp_world->GetGenotypeAt(id)->GetData().agp_compiled);
+    },
+    [this](DemeEvaluator & de, test_case_t & test) {
+      AGP__ResetHW(*de.agp_eval_hw);
+      de.context.BeginTurn(test.GetInput().game, test.GetInput().playerID);
+      de.agp_eval_hw->RunUntil(EVAL_TIME, AGP__IsEvalDone);
+      return (size_t)de.agp_eval_hw->GetTrait(TRAIT_ID__MOVE);
+    });
 }
 
 // SignalGP Functions
-/// Reset the SignalGP evaluation hardware, setting input memory of
+/// Reset SignalGP evaluation hardware, setting input memory of
 /// main thread to be equal to main_in_mem.
-void LineageExp::SGP__ResetHW(const SGP__memory_t & main_in_mem) {
-  sgp_eval_hw->ResetHardware();
-  sgp_eval_hw->SetTrait(TRAIT_ID__MOVE, -1);
-  sgp_eval_hw->SetTrait(TRAIT_ID__DONE, 0);
-  sgp_eval_hw->SpawnCore(0, main_in_mem, true);
+void LineageExp::SGP__ResetHW(SGP__eval_hw_t & hw, const SGP__memory_t & main_in_mem) {
+  hw.ResetHardware();
+  hw.SetTrait(TRAIT_ID__MOVE, -1);
+  hw.SetTrait(TRAIT_ID__DONE, 0);
+  hw.SpawnCore(0, main_in_mem, true);
+}
+
+/// Compile program for SignalGP evaluation hardware, unless compiled already is (i.e. unless we've
+/// seen this genotype before). Not thread-safe: it compiles through sgp_eval_program.
+void LineageExp::SGP__Compile(const SGP__genome_t & program, SGP__compiled_t & compiled) {
+  if (compiled.IsCompiled()) return;
+  program.Materialize(*sgp_eval_program);
+  compiled.Compile(*sgp_eval_program, *sgp_eval_inst_lib);
+}
+
+/// Load compiled program onto SignalGP evaluation hardware and resolve its tag bindings (in the
+/// hardware's context's bind table).
+void LineageExp::SGP__LoadProgram(SGP__eval_hw_t & hw, const SGP__compiled_t & compiled) {
+  hw.SetProgram(compiled);
+  hw.GetContext().sgp_bind_table->SetProgram(compiled, SGP_HW_MIN_BIND_THRESH);
+}
+
+/// Make SignalGP evaluation hardware (using random number generator rnd) whose instructions see context.
+emp::Ptr<LineageExp::SGP__eval_hw_t> LineageExp::SGP__NewEvalHW(emp::Ptr<emp::Random> rnd, EvalContext & context) {
+  emp::Ptr<SGP__eval_hw_t> hw = emp::NewPtr<SGP__eval_hw_t>(sgp_eval_inst_lib, rnd);
+  hw->SetContext(&context);
+  hw->SetMaxCores(SGP_HW_MAX_CORES);
+  hw->SetMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
+  return hw;
+}
+
+/// Island model: evaluate each deme's SignalGP agents on its own evaluation unit (see EvaluateDemes).
+void LineageExp::SGP__EvaluateDemes() {
+  // Compile new genotypes up front: a genotype can be shared by agents in different demes.
+  for (size_t id = 0; id < sgp_world->GetSize(); ++id) {
+    SGP__Compile(sgp_world->GetOrg(id).GetGenome(), sgp_world->GetGenotypeAt(id)->GetData().sgp_compiled);
+  }
+  EvaluateDemes(*sgp_world,
+    [this](DemeEvaluator & de, size_t id) {
+      SGP__LoadProgram(*de.sgp_eval_hw, sgp_world->GetGenotypeAt(id)->GetData().sgp_compiled);
+    },
+    [this](DemeEvaluator & de, test_case_t & test) {
+      SGP__ResetHW(*de.sgp_eval_hw);
+      de.context.BeginTurn(test.GetInput().game, test.GetInput().playerID);
+      de.sgp_eval_hw->RunUntil(EVAL_TIME, SGP__IsEvalDone);
+      return (size_t)de.sgp_eval_hw->GetTrait(TRAIT_ID__MOVE);
+    });
 }
 
 void LineageExp::SGP__InitPopulation_Random() {
   std::cout << "Initializing population randomly!" << std::endl;
   for (size_t p = 0; p < POP_SIZE; ++p) {
     SGP__program_t prog(sgp_inst_lib);
+    rng.SetStream(0, p, RANDOM_PURPOSE_ID__INIT);
     for (size_t f = 0; f < SGP_FUNCTION_CNT; ++f) {
       prog.PushFunction();
-      prog[f].affinity.Randomize(*random);
+      rng.RandomizeBits(prog[f].affinity);
       for (size_t i = 0; i < SGP_FUNCTION_LEN; ++i) {
-        const size_t instID = random->GetUInt(sgp_inst_lib->GetSize());
-        const size_t a0 = random->GetUInt(0, SGP_PROG_MAX_ARG_VAL);
-        const size_t a1 = random->GetUInt(0, SGP_PROG_MAX_ARG_VAL);
-        const size_t a2 = random->GetUInt(0, SGP_PROG_MAX_ARG_VAL);
+        const size_t instID = rng.GetUInt(sgp_inst_lib->GetSize());
+        const size_t a0 = rng.GetUInt(0, SGP_PROG_MAX_ARG_VAL);
+        const size_t a1 = rng.GetUInt(0, SGP_PROG_MAX_ARG_VAL);
+        const size_t a2 = rng.GetUInt(0, SGP_PROG_MAX_ARG_VAL);
         SGP__inst_t inst(instID, a0, a1, a2);
-        inst.affinity.Randomize(*random);
+        rng.RandomizeBits(inst.affinity);
         prog[f].PushInst(inst);
       }
     }
@@ -1069,6 +1550,19 @@ void LineageExp::SGP__InitPopulation_Random() {
   }
 }
 
+/// Can program run on SignalGP evaluation hardware? Every instruction argument has to be a valid
+/// memory key (the experiment itself only makes arguments in [0, SGP_PROG_MAX_ARG_VAL)).
+bool LineageExp::SGP__HasValidArgs(const SGP__program_t & program) {
+  for (size_t fID = 0; fID < program.GetSize(); ++fID) {
+    for (const SGP__inst_t & inst : program[fID].inst_seq) {
+      for (size_t k = 0; k < SGP__hardware_t::MAX_INST_ARGS; ++k) {
+        if (!SGP__memory_t::IsValidKey(inst.args[k])) return false;
+      }
+    }
+  }
+  return true;
+}
+
 void LineageExp::SGP__InitPopulation_FromAncestorFile() {
   std::cout << "Initializing population from ancestor file!" << std::endl;
   // Configure the ancestor program.
@@ -1082,6 +1576,10 @@ void LineageExp::SGP__InitPopulation_FromAncestorFile() {
   std::cout << " --- Ancestor program: ---" << std::endl;
   ancestor_prog.PrintProgramFull();
   std::cout << " -------------------------" << std::endl;
+  if (!SGP__HasValidArgs(ancestor_prog)) {
+    std::cout << "Ancestor program instruction arguments must be between 0 and " << SGP__MEM_SIZE - 1 << ". Exiting..." << std::endl;
+    exit(-1);
+  }
   sgp_world->Inject(ancestor_prog, 1);    // Inject a bunch of ancestors into the population.
 }
 
@@ -1100,11 +1598,16 @@ void LineageExp::SGP__Debugging_Analysis() {
   std::cout << " --- Analysis program: ---" << std::endl;
   analyze_prog.PrintProgramFull();
   std::cout << " -------------------------" << std::endl;
+  if (!SGP__HasValidArgs(analyze_prog)) {
+    std::cout << "Analysis program instruction arguments must be between 0 and " << SGP__MEM_SIZE - 1 << ". Exiting..." << std::endl;
+    exit(-1);
+  }
 
   // Load program onto agent.
   SignalGPAgent our_hero(analyze_prog);
   our_hero.SetID(0);
-  sgp_eval_hw->SetProgram(our_hero.GetGenome());
+  SGP__compiled_t analyze_compiled;
+  SGP__SetEvalProgram(our_hero.GetGenome(), analyze_compiled);
   // this->Evaluate(our_hero);
   double score = 0.0;
   for (cur_testcase = 0; cur_testcase < testcases.GetSize(); ++cur_testcase) {
@@ -1124,63 +1627,128 @@ void LineageExp::SGP__Debugging_Analysis() {
   } std::cout << "}" << std::endl;
 }
 
+/// Tag bit flips (function tag and every instruction's tag, even if it doesn't use one),
+/// instruction substitutions, and argument substitutions (even if they aren't relevent to the
+/// instruction) for a single function. Shared by both SGP mutation operators.
+/// Mutated sites are found by geometric skip-ahead sampling: same per-site mutation
+/// probabilities, but we only draw random numbers for sites that actually mutate.
+size_t LineageExp::SGP__Mutate_Substitutions(SGP__genome_t & program, size_t fID, CounterRandom & rnd, MutatorState & mstate) {
+  const size_t fun_size = program[fID].inst_seq.size();
+  const size_t tag_width = program[fID].affinity.GetSize();
+  size_t mut_cnt = 0;
+  // Functions are shared with relatives: only get a writable copy once something mutates.
+  emp::Ptr<SGP__function_t> fun = nullptr;
+  auto edit_fun = [&]() -> SGP__function_t & {
+    if (!fun) fun = &program.EditFunction(fID);
+    return *fun;
+  };
+  // Tag bit flips: site = (tag ID, bit), where tag 0 is the function's tag and tag i+1 is
+  // instruction i's.
+  sgp_tag_bflip_sampler.ForEachHit((fun_size + 1) * tag_width, rnd, [&](size_t site) {
+    const size_t tagID = site / tag_width;
+    const size_t bit = site % tag_width;
+    SGP__tag_t & tag = (tagID == 0) ? edit_fun().affinity : edit_fun().inst_seq[tagID - 1].affinity;
+    tag.Set(bit, !tag.Get(bit));
+    ++mut_cnt;
+    ++mstate.muts[MUTATION_ID__TAG_BIT_FLIPS];
+  });
+  // Substitutions: site = (instruction, slot), where slot 0 is the instruction ID and slot k+1 is
+  // argument k.
+  const size_t inst_slots = 1 + SGP__hardware_t::MAX_INST_ARGS;
+  sgp_inst_sub_sampler.ForEachHit(fun_size * inst_slots, rnd, [&](size_t site) {
+    SGP__inst_t & inst = edit_fun().inst_seq[site / inst_slots];
+    const size_t slot = site % inst_slots;
+    if (slot == 0) {
+      ++mstate.muts[MUTATION_ID__INST_SUBSTITUTIONS];
+      inst.id = rnd.GetUInt(program.GetInstLib()->GetSize());
+    } else {
+      ++mstate.muts[MUTATION_ID__ARG_SUBSTITUTIONS];
+      inst.args[slot - 1] = rnd.GetInt(SGP_PROG_MAX_ARG_VAL);
+    }
+    ++mut_cnt;
+  });
+  return mut_cnt;
+}
+
+/// Instruction insertions/deletions for function fID. Sites are sampled up front; a function
+/// without any indels is left untouched (and stays shared), otherwise it is edited in place (deletions compact
+/// survivors toward the front, then insertions shift them back from the end to open gaps).
+/// Insertion sites are positions in the original function: a new instruction goes in front of
+/// the instruction at its site (whether or not that instruction is deleted).
+size_t LineageExp::SGP__Mutate_Indels(SGP__genome_t & program, size_t fID, size_t & expected_prog_len, CounterRandom & rnd, MutatorState & mstate) {
+  const size_t fun_size = program[fID].inst_seq.size();
+  // - Compute insertions.
+  int num_ins = rnd.GetRandBinomial(fun_size, SGP_PER_INST__INS_RATE);
+  // Ensure that insertions don't exceed maximum program length.
+  if ((num_ins + expected_prog_len) > SGP_PROG_MAX_LENGTH) {
+    num_ins = SGP_PROG_MAX_LENGTH - expected_prog_len;
+  }
+  expected_prog_len += num_ins;
+  mstate.ins_locs.clear();
+  for (int i = 0; i < num_ins; ++i) mstate.ins_locs.emplace_back(rnd.GetUInt(fun_size));
+  std::sort(mstate.ins_locs.begin(), mstate.ins_locs.end());
+  // - Compute deletions (never delete every instruction in the function).
+  mstate.del_locs.clear();
+  sgp_inst_del_sampler.ForEachHit(fun_size, rnd, [&mstate, fun_size](size_t pos) {
+    if (mstate.del_locs.size() + 1 < fun_size) mstate.del_locs.emplace_back(pos);
+  });
+  if (mstate.ins_locs.empty() && mstate.del_locs.empty()) return 0;
+
+  emp::vector<SGP__inst_t> & inst_seq = program.EditFunction(fID).inst_seq;
+  // Deletions: compact surviving instructions toward the front.
+  if (mstate.del_locs.size()) {
+    size_t whead = mstate.del_locs[0];
+    size_t dID = 0;
+    for (size_t rhead = mstate.del_locs[0]; rhead < fun_size; ++rhead) {
+      if (dID < mstate.del_locs.size() && mstate.del_locs[dID] == rhead) { ++dID; continue; }
+      inst_seq[whead++] = inst_seq[rhead];
+    }
+    inst_seq.resize(whead);
+    expected_prog_len -= mstate.del_locs.size();
+    mstate.muts[MUTATION_ID__INST_DELETIONS] += mstate.del_locs.size();
+  }
+  // Insertions: grow once, then walk back from the end, shifting survivors and filling gaps.
+  if (mstate.ins_locs.size()) {
+    // Translate insertion sites to post-deletion positions.
+    size_t dID = 0;
+    for (size_t & loc : mstate.ins_locs) {
+      while (dID < mstate.del_locs.size() && mstate.del_locs[dID] < loc) ++dID;
+      loc -= dID;
+    }
+    size_t rhead = inst_seq.size();
+    inst_seq.resize(inst_seq.size() + mstate.ins_locs.size());
+    size_t whead = inst_seq.size();
+    for (size_t i = mstate.ins_locs.size(); i-- > 0;) {
+      while (rhead > mstate.ins_locs[i]) inst_seq[--whead] = inst_seq[--rhead];
+      // Insert a random instruction.
+      SGP__inst_t & inst = inst_seq[--whead];
+      inst.id = rnd.GetUInt(program.GetInstLib()->GetSize());
+      for (size_t k = 0; k < SGP__hardware_t::MAX_INST_ARGS; ++k) inst.args[k] = rnd.GetInt(SGP_PROG_MAX_ARG_VAL);
+      rnd.RandomizeBits(inst.affinity);
+    }
+    mstate.muts[MUTATION_ID__INST_INSERTIONS] += mstate.ins_locs.size();
+  }
+  return mstate.ins_locs.size() + mstate.del_locs.size();
+}
+
 /// Mutate an SGP agent's program. Only does tag mutations, instruction substitutions, and
 /// argument substitutions. (maintains constand-length genomes)
-size_t LineageExp::SGP__Mutate_FixedLength(SignalGPAgent & agent, emp::Random & rnd) {
-  SGP__program_t & program = agent.GetGenome();
+size_t LineageExp::SGP__Mutate_FixedLength(SGP__genome_t & program, CounterRandom & rnd, MutatorState & mstate) {
   size_t mut_cnt = 0;
-  for (size_t i = 0; i < MUTATION_TYPES.size(); ++i) {
-    last_mutation[MUTATION_TYPES[i]] = 0;
-  }
+  mstate.muts.fill(0);
   // For each function:
   for (size_t fID = 0; fID < program.GetSize(); ++fID) {
-    // Mutate affinity.
-    for (size_t i = 0; i < program[fID].GetAffinity().GetSize(); ++i) {
-      SGP__tag_t & aff = program[fID].GetAffinity();
-      if (rnd.P(SGP_PER_BIT__TAG_BFLIP_RATE)) {
-        ++last_mutation["tag_bit_flips"];
-        ++mut_cnt;
-        aff.Set(i, !aff.Get(i));
-      }
-    }
-    // Substitutions?
-    for (size_t i = 0; i < program[fID].GetSize(); ++i) {
-      SGP__inst_t & inst = program[fID][i];
-      // Mutate affinity (even if it doesn't have one).
-      for (size_t k = 0; k < inst.affinity.GetSize(); ++k) {
-        if (rnd.P(SGP_PER_BIT__TAG_BFLIP_RATE)) {
-          ++mut_cnt;
-          ++last_mutation["tag_bit_flips"];
-          inst.affinity.Set(k, !inst.affinity.Get(k));
-        }
-      }
-      // Mutate instruction.
-      if (rnd.P(SGP_PER_INST__SUB_RATE)) {
-        ++mut_cnt;
-        ++last_mutation["inst_substitutions"];
-        inst.id = rnd.GetUInt(program.GetInstLib()->GetSize());
-      }
-      // Mutate arguments (even if they aren't relevent to instruction).
-      for (size_t k = 0; k < SGP__hardware_t::MAX_INST_ARGS; ++k) {
-        if (rnd.P(SGP_PER_INST__SUB_RATE)) {
-          ++mut_cnt;
-          ++last_mutation["arg_substitutions"];
-          inst.args[k] = rnd.GetInt(SGP_PROG_MAX_ARG_VAL);
-        }
-      }
-    }
+    // Tag mutations and substitutions.
+    mut_cnt += SGP__Mutate_Substitutions(program, fID, rnd, mstate);
   }
   return mut_cnt;
 }
 
 
-size_t LineageExp::SGP__Mutate_VariableLength(SignalGPAgent & agent, emp::Random & rnd) {
-  SGP__program_t & program = agent.GetGenome();
+size_t LineageExp::SGP__Mutate_VariableLength(SGP__genome_t & program, CounterRandom & rnd, MutatorState & mstate) {
   size_t mut_cnt = 0;
-  // Reset last mutation.
-  for (size_t i = 0; i < MUTATION_TYPES.size(); ++i) {
-    last_mutation[MUTATION_TYPES[i]] = 0;
-  }
+  // Reset mutation counts.
+  mstate.muts.fill(0);
   // Duplicate a function?
   size_t expected_prog_len = program.GetInstCnt();
   size_t old_content_wall = program.GetSize(); ///< First position (or invalid position) after old content.
@@ -1194,8 +1762,8 @@ size_t LineageExp::SGP__Mutate_VariableLength(SignalGPAgent & agent, emp::Random
       // Adjust expected program length (total instructions).
       expected_prog_len += program[fID].GetSize();
       // Duplication.
-      program.PushFunction(program[fID]);
-      ++last_mutation["func_duplications"];
+      program.DuplicateFunction(fID);
+      ++mstate.muts[MUTATION_ID__FUNC_DUPLICATIONS];
       ++mut_cnt;
     // Do we delete?
     } else if (del && program.GetSize() > 1) {
@@ -1203,104 +1771,225 @@ size_t LineageExp::SGP__Mutate_VariableLength(SignalGPAgent & agent, emp::Random
       expected_prog_len -= program[fID].GetSize();
       const size_t mfID = program.GetSize()-1;
       // Deletion.
-      program[fID] = program[mfID];
-      program.program.resize(mfID);
+      program.ReplaceFunction(fID, mfID);
+      program.ResizeFunctions(mfID);
       // Should we adjust the wall?
       if (mfID < old_content_wall) {
         // We're moving from within the wall, adjust wall.
         --old_content_wall;
         --fID;
       }
-      ++last_mutation["func_deletions"];
+      ++mstate.muts[MUTATION_ID__FUNC_DELETIONS];
       ++mut_cnt;
     }
     ++fID;
   }
   // For each function...
   for (size_t fID = 0; fID < program.GetSize(); ++fID) {
-    // Mutate affinity
-    for (size_t i = 0; i < program[fID].GetAffinity().GetSize(); ++i) {
-      SGP__tag_t & aff = program[fID].GetAffinity();
-      if (rnd.P(SGP_PER_BIT__TAG_BFLIP_RATE)) {
-        ++mut_cnt;
-        ++last_mutation["tag_bit_flips"];
-        aff.Set(i, !aff.Get(i));
-      }
+    // Tag mutations and substitutions.
+    mut_cnt += SGP__Mutate_Substitutions(program, fID, rnd, mstate);
+    // Insertion/deletion mutations?
+    mut_cnt += SGP__Mutate_Indels(program, fID, expected_prog_len, rnd, mstate);
+  }
+  return mut_cnt;
+}
+
+/// Load test case scores of positions [begin, begin + pop_size) into the lexicase score matrix
+/// (selector position i is population position begin + i).
+void LineageExp::PrepareLexicase(size_t pop_size, size_t begin) {
+  lexicase.Resize(pop_size, testcases.GetSize());
+  for (size_t i = 0; i < pop_size; ++i) lexicase.SetOrgScores(i, agent_phen_cache[begin + i].testcase_scores);
+  lexicase.Prepare();
+}
+
+/// Fill the Eco-EA score matrix (once per generation, after evaluation): each agent's score on
+/// each resource, i.e. its summed test case scores for each game phase (phases mode) or its score on
+/// each test case (indiv mode).
+void LineageExp::CalcResourceScores(size_t pop_size) {
+  resource_selector.Resize(pop_size, resources.size());
+  for (size_t id = 0; id < pop_size; ++id) {
+    const emp::vector<double> & testcase_scores = agent_phen_cache[id].testcase_scores;
+    double * res_scores = resource_selector.GetOrgScores(id);
+    if (RESOURCE_SELECT__MODE == RESOURCE_SELECT_MODE_ID__INDIV) {
+      std::copy(testcase_scores.begin(), testcase_scores.end(), res_scores);
+      continue;
     }
+    for (size_t i = 0; i < testcases_by_phase.size(); ++i) {
+      const emp::vector<size_t> & phasecases = testcases_by_phase[i];
+      double score = 0;
+      for (size_t j = 0; j < phasecases.size(); ++j) score += testcase_scores[phasecases[j]];
+      res_scores[i] = score;
+    }
+  }
+}
 
-    // Substitution mutations?
-    for (size_t i = 0; i < program[fID].GetSize(); ++i) {
-      SGP__inst_t & inst = program[fID][i];
-      // Mutate affinity (even if it doesn't have one).
-      for (size_t k = 0; k < inst.affinity.GetSize(); ++k) {
-        if (rnd.P(SGP_PER_BIT__TAG_BFLIP_RATE)) {
-          ++mut_cnt;
-          ++last_mutation["tag_bit_flips"];
-          inst.affinity.Set(k, !inst.affinity.Get(k));
-        }
-      }
-      // Mutate instruction.
-      if (rnd.P(SGP_PER_INST__SUB_RATE)) {
-        ++mut_cnt;
-        ++last_mutation["inst_substitutions"];
-        inst.id = rnd.GetUInt(program.GetInstLib()->GetSize());
-      }
-      // Mutate arguments (even if they aren't relevent to instruction).
-      for (size_t k = 0; k < SGP__hardware_t::MAX_INST_ARGS; ++k) {
-        if (rnd.P(SGP_PER_INST__SUB_RATE)) {
-          ++mut_cnt;
-          ++last_mutation["arg_substitutions"];
-          inst.args[k] = rnd.GetInt(SGP_PROG_MAX_ARG_VAL);
+/// Offer every agent (after evaluation) to the MAP-Elites archive. Descriptors: the agent's expert
+/// move rate on each game phase's test cases, then its program length (for each configured axis).
+template<typename WORLD_TYPE>
+void LineageExp::UpdateMapElitesArchive(WORLD_TYPE & world) {
+  const bool phase_axes = MAP_ELITES__PHASE_BINS > 0;
+  const bool length_axis = MAP_ELITES__LENGTH_BINS > 0;
+  for (size_t id = 0; id < world.GetSize(); ++id) {
+    const Phenotype & phen = agent_phen_cache[id];
+    size_t axis = 0;
+    if (phase_axes) {
+      for (size_t i = 0; i < testcases_by_phase.size(); ++i) {
+        const emp::vector<size_t> & phasecases = testcases_by_phase[i];
+        size_t expert_cnt = 0;
+        for (size_t j = 0; j < phasecases.size(); ++j) {
+          expert_cnt += (phen.testcase_scores[phasecases[j]] == SCORE_MOVE__EXPERT_MOVE_VALUE);
         }
+        mape_desc[axis++] = phasecases.size() ? (double)expert_cnt / (double)phasecases.size() : 0.0;
       }
     }
-    // Insertion/deletion mutations?
-    // - Compute insertions.
-    int num_ins = rnd.GetRandBinomial(program[fID].GetSize(), SGP_PER_INST__INS_RATE);
-    // Ensure that insertions don't exceed maximum program length.
-    if ((num_ins + expected_prog_len) > SGP_PROG_MAX_LENGTH) {
-      num_ins = SGP_PROG_MAX_LENGTH - expected_prog_len;
+    if (length_axis) mape_desc[axis++] = (double)GetGenomeLength(world.GetGenomeAt(id));
+    mape_archive.Insert(mape_desc.data(), phen.aggregate_score, id);
+  }
+}
+
+/// Fill repro_fitness with every agent's fitness (what CalcFitness gives the world), by position.
+void LineageExp::CalcReproFitness(size_t pop_size) {
+  repro_fitness.resize(pop_size);
+  for (size_t i = 0; i < pop_size; ++i) repro_fitness[i] = agent_phen_cache[i].aggregate_score;
+}
+
+/// Pick parents for the next generation (elites first), using the configured selection method.
+/// Parents are positions in the current population; picks come from stream (update, 0, selection).
+void LineageExp::SelectReproParents(size_t pop_size) {
+  repro_parents.clear();
+  rng.SetStream(update, 0, RANDOM_PURPOSE_ID__SELECTION);
+  if (SELECTION_METHOD == SELECTION_METHOD_ID__MAPELITES) {
+    // Every archived elite is carried over unmutated (so the archive always points at live
+    // agents); the rest of the population is offspring of uniformly random elites.
+    const size_t elite_cnt = mape_archive.GetNumOccupied();
+    for (size_t i = 0; i < elite_cnt; ++i) {
+      const size_t cell = mape_archive.GetOccupiedCell(i);
+      repro_parents.emplace_back(mape_archive.GetElitePos(cell));
+      mape_archive.SetElitePos(cell, i); // Where it'll be born.
     }
-    expected_prog_len += num_ins;
-
-    // Do we need to do any insertions or deletions?
-    if (num_ins > 0 || SGP_PER_INST__DEL_RATE > 0.0) {
-      emp::vector<size_t> ins_locs = emp::RandomUIntVector(rnd, num_ins, 0, program[fID].GetSize());
-      if (ins_locs.size()) std::sort(ins_locs.begin(), ins_locs.end(), std::greater<size_t>());
-      SGP__hardware_t::Function new_fun(program[fID].GetAffinity());
-      size_t rhead = 0;
-      size_t num_dels = 0;
-      while (rhead < program[fID].GetSize()) {
-        if (ins_locs.size()) {
-          if (rhead >= ins_locs.back()) {
-            // Insert a random instruction.
-            new_fun.PushInst(rnd.GetUInt(program.GetInstLib()->GetSize()),
-                             rnd.GetInt(SGP_PROG_MAX_ARG_VAL),
-                             rnd.GetInt(SGP_PROG_MAX_ARG_VAL),
-                             rnd.GetInt(SGP_PROG_MAX_ARG_VAL),
-                             SGP__tag_t());
-            new_fun.inst_seq.back().affinity.Randomize(rnd);
-            ++mut_cnt;
-            ++last_mutation["inst_insertions"];
-            ins_locs.pop_back();
-            continue;
-          }
-        }
-        // Do we delete this instruction?
-        if (rnd.P(SGP_PER_INST__DEL_RATE) && num_dels < (program[fID].GetSize() - 1)) {
-          ++mut_cnt;
-          ++last_mutation["inst_deletions"];
-          ++num_dels;
-          --expected_prog_len;
-        } else {
-          new_fun.PushInst(program[fID][rhead]);
-        }
-        ++rhead;
-      }
-      program[fID] = new_fun;
+    for (size_t i = elite_cnt; i < POP_SIZE; ++i) repro_parents.emplace_back(repro_parents[rng.GetUInt(elite_cnt)]);
+    repro_elite_cnt = elite_cnt;
+    repro_block_size = POP_SIZE;
+    return;
+  }
+  CalcReproFitness(pop_size);
+  repro_elite_cnt = ELITE_SELECT__ELITE_CNT;
+  if (ISLAND__DEME_CNT < 2) {
+    repro_block_size = POP_SIZE;
+    SelectDemeParents(0, pop_size, POP_SIZE);
+    return;
+  }
+  // Island model: each deme's offspring (born in order, so they replace it in place) have parents
+  // from the same deme, except for migrants.
+  const size_t deme_size = pop_size / ISLAND__DEME_CNT;
+  repro_block_size = deme_size;
+  for (size_t d = 0; d < ISLAND__DEME_CNT; ++d) SelectDemeParents(d * deme_size, deme_size, deme_size);
+  if (ISLAND__MIGRATION_INTERVAL && update && update % ISLAND__MIGRATION_INTERVAL == 0) SelectMigrantParents(deme_size);
+}
+
+/// Append count parents (elites first) picked among positions [begin, begin + deme_size) with the
+/// configured selection method.
+void LineageExp::SelectDemeParents(size_t begin, size_t deme_size, size_t count) {
+  const bool whole_pop = (begin == 0 && deme_size == repro_fitness.size());
+  if (!whole_pop) deme_fitness.assign(repro_fitness.begin() + begin, repro_fitness.begin() + begin + deme_size);
+  const emp::vector<double> & fitness = whole_pop ? repro_fitness : deme_fitness;
+  const size_t first = repro_parents.size();
+  SelectEliteParents(fitness, ELITE_SELECT__ELITE_CNT, repro_scratch, repro_parents);
+  const size_t repro_cnt = count - (repro_parents.size() - first);
+  switch (SELECTION_METHOD) {
+    case SELECTION_METHOD_ID__TOURNAMENT:
+      SelectTournamentParents(fitness, TOURNAMENT_SIZE, repro_cnt, rng, repro_parents);
+      break;
+    case SELECTION_METHOD_ID__LEXICASE:
+      PrepareLexicase(deme_size, begin);
+      lexicase.Select(repro_cnt, rng, repro_parents);
+      break;
+    case SELECTION_METHOD_ID__ROULETTE:
+      SelectRouletteParents(fitness, repro_cnt, rng, roulette_table, repro_parents);
+      break;
+    default:
+      std::cout << "Selection method not supported with batched reproduction (REPRO_THREADS > 0). Exiting..." << std::endl;
+      exit(-1);
+  }
+  if (begin) {
+    for (size_t i = first; i < repro_parents.size(); ++i) repro_parents[i] += begin;
+  }
+}
+
+/// Migration (island model): the last ISLAND__MIGRANT_CNT offspring of each deme get their parent
+/// from a source deme (ring: the previous deme; fully connected: a random other deme) instead. Each
+/// migrant's parent is one of the source deme's own (non-elite, non-migrant) picks, so migrants are
+/// chosen by the same selection method.
+void LineageExp::SelectMigrantParents(size_t deme_size) {
+  const size_t deme_cnt = ISLAND__DEME_CNT;
+  const size_t keep_begin = ELITE_SELECT__ELITE_CNT;
+  const size_t keep_cnt = deme_size - ELITE_SELECT__ELITE_CNT - ISLAND__MIGRANT_CNT;
+  for (size_t d = 0; d < deme_cnt; ++d) {
+    for (size_t m = 0; m < ISLAND__MIGRANT_CNT; ++m) {
+      const size_t src = (ISLAND__TOPOLOGY == ISLAND_TOPOLOGY_ID__RING) ? (d + deme_cnt - 1) % deme_cnt
+                                                                         : (d + 1 + rng.GetUInt(deme_cnt - 1)) % deme_cnt;
+      const size_t slot = src * deme_size + keep_begin + rng.GetUInt(keep_cnt);
+      repro_parents[(d + 1) * deme_size - ISLAND__MIGRANT_CNT + m] = repro_parents[slot];
     }
   }
-  return mut_cnt;
+}
+
+/// Batched reproduction: pick all parents up front, copy and mutate offspring on REPRO_THREADS
+/// workers (see MutateOffspring; each worker has its own MutatorState), then give birth to them in
+/// order. Offspring i is mutated with random number stream (update, i, mutation), so results don't
+/// depend on the number of workers, and any offspring's mutations can be replayed on their own.
+/// Births stay serial so systematics see each offspring with its parent and its mutations
+/// (last_mutation), same as in-world reproduction. Elites (the first repro_elite_cnt offspring of
+/// each block of repro_block_size, i.e. of each deme) aren't mutated.
+template<typename WORLD_TYPE, typename MUT_FUN>
+void LineageExp::DoBatchedReproduction(WORLD_TYPE & world, emp::vector<typename WORLD_TYPE::genome_t> & offspring, MUT_FUN && mutate) {
+  SelectReproParents(world.GetSize());
+  MutateOffspring(*workers, REPRO_THREADS, repro_parents, repro_elite_cnt, repro_block_size, update, RANDOM_PURPOSE_ID__MUTATION,
+                  [&world](size_t pos) -> const typename WORLD_TYPE::genome_t & { return world.GetGenomeAt(pos); },
+                  mutate, repro_rngs, repro_mutators, offspring, repro_muts);
+  repro_premutated = true;
+  const size_t offspring_cnt = repro_parents.size();
+  for (size_t i = 0; i < offspring_cnt; ++i) {
+    last_mutation = repro_muts[i];
+    world.DoBirth(offspring[i], repro_parents[i]);
+  }
+  repro_premutated = false;
+}
+
+/// Island model: make an evaluation unit for each deme (eval hardware is added by ConfigSGP/ConfigAGP).
+/// Each unit's random number generator gets its own seed, so results don't depend on thread timing.
+void LineageExp::MakeDemeEvaluators() {
+  for (size_t d = 0; d < ISLAND__DEME_CNT; ++d) {
+    deme_evaluators.emplace_back(emp::NewPtr<DemeEvaluator>(random->GetSeed() + (int)d + 1, OTHELLO_HW_BOARDS, othello_lookup));
+  }
+}
+
+/// Island model evaluation: deme d's agents (a contiguous block of positions) are evaluated on
+/// deme_evaluators[d], each deme on its own worker. load_agent(de, id) loads agent id onto de's eval
+/// hardware; run_turn(de, test) plays a turn of test (from hardware reset) and returns the move.
+/// Workers only write to their own deme's agents, cached phenotypes and evaluation unit, so programs
+/// have to be compiled beforehand, and fitness/phenotypes are recorded in genotypes (which demes can
+/// share) afterwards, in position order, as Evaluate would.
+template<typename WORLD_TYPE, typename LOAD_FUN, typename TURN_FUN>
+void LineageExp::EvaluateDemes(WORLD_TYPE & world, LOAD_FUN && load_agent, TURN_FUN && run_turn) {
+  const size_t deme_cnt = deme_evaluators.size();
+  const size_t deme_size = world.GetSize() / deme_cnt;
+  emp_assert(deme_size * deme_cnt == world.GetSize());
+  workers->Run(deme_cnt, [&](size_t d) {
+    DemeEvaluator & de = *deme_evaluators[d];
+    for (size_t id = d * deme_size; id < (d + 1) * deme_size; ++id) {
+      world.GetOrg(id).SetID(id);
+      load_agent(de, id);
+      ScorePhenotype(id, [&](size_t testID) {
+        test_case_t & test = testcases[testID];
+        return calc_test_score(test, GetOthelloIndex(run_turn(de, test)));
+      });
+    }
+  });
+  for (size_t id = 0; id < world.GetSize(); ++id) {
+    record_fit_sig.Trigger(id, agent_phen_cache[id].aggregate_score);
+    record_phen_sig.Trigger(id, agent_phen_cache[id].testcase_scores);
+  }
 }
 
 void LineageExp::SGP_Snapshot_SingleFile(size_t update) {
@@ -1319,41 +2008,52 @@ void LineageExp::SGP_Snapshot_SingleFile(size_t update) {
 #include "LineageExp__InstructionImpl.h"
 
 void LineageExp::ConfigSGP() {
+  // Instruction arguments are memory keys on the evaluation hardware.
+  if (SGP_PROG_MAX_ARG_VAL < 1 || (size_t)SGP_PROG_MAX_ARG_VAL > SGP__MEM_SIZE) {
+    std::cout << "SGP_PROG_MAX_ARG_VAL must be between 1 and " << SGP__MEM_SIZE << " (SignalGP memory size). Exiting..." << std::endl;
+    exit(-1);
+  }
   // Configure the world.
   sgp_world->Reset();
   sgp_world->SetWellMixed(true);
 
   // Setup mutation function.
   if (SGP_VARIABLE_LENGTH) {
-    sgp_world->SetMutFun([this](SignalGPAgent & agent, emp::Random & rnd) { return this->SGP__Mutate_VariableLength(agent, rnd); }, ELITE_SELECT__ELITE_CNT);
+    sgp_mutate = [this](SGP__genome_t & program, CounterRandom & rnd, MutatorState & mstate) { return this->SGP__Mutate_VariableLength(program, rnd, mstate); };
   } else {
-    // NOTE: second argument specifies that we're not mutating the first thing int the pop (we're doing elite selection in all of our stuff).
-    sgp_world->SetMutFun([this](SignalGPAgent & agent, emp::Random & rnd) { return this->SGP__Mutate_FixedLength(agent, rnd); }, ELITE_SELECT__ELITE_CNT);
+    sgp_mutate = [this](SGP__genome_t & program, CounterRandom & rnd, MutatorState & mstate) { return this->SGP__Mutate_FixedLength(program, rnd, mstate); };
   }
+  // NOTE: second argument specifies that we're not mutating the first thing int the pop (we're doing elite selection in all of our stuff).
+  // Mutations come from stream (update, birth_cnt, mutation) rather than the world's generator.
+  sgp_world->SetMutFun([this](SignalGPAgent & agent, emp::Random &) {
+    if (repro_premutated) return (size_t)0; // Batched reproduction already mutated this one.
+    rng.SetStream(update, birth_cnt++, RANDOM_PURPOSE_ID__MUTATION);
+    const size_t mut_cnt = sgp_mutate(agent.GetGenome(), rng, mutator);
+    last_mutation = mutator.muts;
+    return mut_cnt;
+  }, ELITE_SELECT__ELITE_CNT);
 
   sgp_world->SetFitFun([this](SignalGPAgent & agent) { return this->CalcFitness(agent); });
   sgp_world->OnGenotypeKnown([this](emp::Ptr<SGP__genotype_t> genotype, size_t pos) {
     // std::cout << "OnGenotypeKnown Mutations!" << std::endl;
     // for (size_t i = 0; i < MUTATION_TYPES.size(); ++i) {
-    //   std::cout << "  " << MUTATION_TYPES[i] << ":" << last_mutation[MUTATION_TYPES[i]] << std::endl;
+    //   std::cout << "  " << MUTATION_TYPES[i] << ":" << last_mutation[i] << std::endl;
     // }
     genotype->GetData().RecordMutation(last_mutation);
   });
 
-  ConfigSGP_InstLib();
+  ConfigSGP_InstLib<SGP__hardware_t>(*sgp_inst_lib);
+  ConfigSGP_InstLib<SGP__eval_base_t>(*sgp_eval_inst_lib);
 
-  sgp_eval_hw = emp::NewPtr<SGP__hardware_t>(sgp_inst_lib, sgp_event_lib, random);
-  sgp_eval_hw->SetMinBindThresh(SGP_HW_MIN_BIND_THRESH);
-  sgp_eval_hw->SetMaxCores(SGP_HW_MAX_CORES);
-  sgp_eval_hw->SetMaxCallDepth(SGP_HW_MAX_CALL_DEPTH);
+  sgp_eval_hw = SGP__NewEvalHW(random, eval_context);
+  sgp_eval_program = emp::NewPtr<SGP__program_t>(sgp_inst_lib);
+  for (emp::Ptr<DemeEvaluator> de : deme_evaluators) {
+    de->sgp_eval_hw = SGP__NewEvalHW(&de->random, de->context);
+  }
 
   // - Setup move evaluation signals/functors -
   // Setup begin_turn_signal action:
   //  - Reset the evaluation hardware. Give hardware accurate playerID, and update the dreamboard.
-  get_eval_agent_done = [this]() {
-    return (bool)sgp_eval_hw->GetTrait(TRAIT_ID__DONE);
-  };
-
   get_eval_agent_playerID = [this]() {
     return othello_dreamware->GetPlayerID();
   };
@@ -1384,9 +2084,12 @@ void LineageExp::ConfigSGP() {
     auto & fit_file = sgp_world->SetupFitnessFile(DATA_DIRECTORY + "fitness.csv");
     fit_file.SetTimingRepeat(FITNESS_INTERVAL);
     emp::AddPhylodiversityFile(*sgp_world, DATA_DIRECTORY + "phylodiversity.csv").SetTimingRepeat(SYSTEMATICS_INTERVAL);
-    emp::AddLineageMutationFile(*sgp_world, DATA_DIRECTORY + "lineage_mutations.csv", MUTATION_TYPES).SetTimingRepeat(SYSTEMATICS_INTERVAL);
+    AddLineageMutationCountFile(*sgp_world, DATA_DIRECTORY + "lineage_mutations.csv", MUTATION_TYPES).SetTimingRepeat(SYSTEMATICS_INTERVAL);
     AddDominantFile(*sgp_world, DATA_DIRECTORY + "dominant.csv", MUTATION_TYPES).SetTimingRepeat(SYSTEMATICS_INTERVAL);
     AddBestPhenotypeFile(*sgp_world, DATA_DIRECTORY+"best_phenotype.csv").SetTimingRepeat(SYSTEMATICS_INTERVAL);
+    if (ISLAND__DEME_CNT > 1 && ISLAND__DEME_SYSTEMATICS) {
+      AddDemeSystematicsFile(*sgp_world, DATA_DIRECTORY+"deme_systematics.csv").SetTimingRepeat(SYSTEMATICS_INTERVAL);
+    }
     // sgp_muller_file = emp::AddMullerPlotFile(*sgp_world, DATA_DIRECTORY + "muller_data.dat");
     // sgp_world->OnUpdate([this](size_t ud){ if (ud % SYSTEMATICS_INTERVAL == 0) sgp_muller_file.Update(); });
     record_fit_sig.AddAction([this](size_t pos, double fitness) { sgp_world->GetGenotypeAt(pos)->GetData().RecordFitness(fitness); } );
@@ -1400,13 +2103,16 @@ void LineageExp::ConfigSGP() {
   do_evaluation_sig.AddAction([this]() {
     double best_score = -32767;
     best_agent_id = 0;
+    if (deme_evaluators.size()) this->SGP__EvaluateDemes();
     for (size_t id = 0; id < sgp_world->GetSize(); ++id) {
-      // std::cout << "Evaluating agent: " << id << std::endl;
-      // Evaluate agent given by id.
-      SignalGPAgent & our_hero = sgp_world->GetOrg(id);
-      our_hero.SetID(id);
-      sgp_eval_hw->SetProgram(our_hero.GetGenome());
-      this->Evaluate(our_hero);
+      if (deme_evaluators.empty()) {
+        // std::cout << "Evaluating agent: " << id << std::endl;
+        // Evaluate agent given by id.
+        SignalGPAgent & our_hero = sgp_world->GetOrg(id);
+        our_hero.SetID(id);
+        SGP__SetEvalProgram(our_hero.GetGenome(), sgp_world->GetGenotypeAt(id)->GetData().sgp_compiled);
+        this->Evaluate(our_hero);
+      }
       Phenotype & phen = agent_phen_cache[id];
       if (phen.aggregate_score > best_score) {
         best_score = phen.aggregate_score;
@@ -1415,6 +2121,9 @@ void LineageExp::ConfigSGP() {
     }
     std::cout << "Update: " << update << " Max score: " << best_score << std::endl;
   });
+  if (SELECTION_METHOD == SELECTION_METHOD_ID__MAPELITES) {
+    do_evaluation_sig.AddAction([this]() { this->UpdateMapElitesArchive(*sgp_world); });
+  }
 
   // - Configure world upate.
   do_world_update_sig.AddAction([this]() { sgp_world->Update(); });
@@ -1423,98 +2132,64 @@ void LineageExp::ConfigSGP() {
   do_pop_snapshot_sig.AddAction([this](size_t update) { this->SGP_Snapshot_SingleFile(update); });
 
   // - Configure selection
-  switch (SELECTION_METHOD) {
-    case SELECTION_METHOD_ID__TOURNAMENT:
-      do_selection_sig.AddAction([this]() {
-        this->EliteSelect_MASK(*sgp_world, ELITE_SELECT__ELITE_CNT, 1);
-        emp::TournamentSelect(*sgp_world, TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT);
-      });
-      break;
-    case SELECTION_METHOD_ID__LEXICASE: {
-      sgp_lexicase_fit_set.resize(0);
-      for (size_t i = 0; i < testcases.GetSize(); ++i) {
-        sgp_lexicase_fit_set.push_back([i, this](SignalGPAgent & agent) {
-          Phenotype & phen = agent_phen_cache[agent.GetID()];
-          return phen.testcase_scores[i];
+  if (REPRO_THREADS > 0) {
+    // Batched reproduction: parents first, then offspring copied/mutated by REPRO_THREADS workers.
+    do_selection_sig.AddAction([this]() { this->DoBatchedReproduction(*sgp_world, sgp_offspring, sgp_mutate); });
+  } else {
+    switch (SELECTION_METHOD) {
+      case SELECTION_METHOD_ID__TOURNAMENT:
+        do_selection_sig.AddAction([this]() {
+          this->EliteSelect_MASK(*sgp_world, ELITE_SELECT__ELITE_CNT, 1);
+          this->CalcReproFitness(sgp_world->GetSize());
+          TournamentSelectArray(*sgp_world, repro_fitness, TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT, repro_parents);
+        });
+        break;
+      case SELECTION_METHOD_ID__LEXICASE: {
+        do_selection_sig.AddAction([this]() {
+          this->EliteSelect_MASK(*sgp_world, ELITE_SELECT__ELITE_CNT, 1);
+          this->PrepareLexicase(sgp_world->GetSize());
+          LexicaseSelectMatrix(*sgp_world, lexicase, POP_SIZE - ELITE_SELECT__ELITE_CNT, lexicase_parents);
         });
+        break;
       }
-      do_selection_sig.AddAction([this]() {
-        this->EliteSelect_MASK(*sgp_world, ELITE_SELECT__ELITE_CNT, 1);
-        emp::LexicaseSelect(*sgp_world, sgp_lexicase_fit_set, POP_SIZE - ELITE_SELECT__ELITE_CNT);
-      });
-      break;
-    }
-    case SELECTION_METHOD_ID__ECOEA: {
-      sgp_resource_fit_set.resize(0);
-      // Setup the fitness function set based on resource select mode.
-      switch (RESOURCE_SELECT__MODE) {
-        case RESOURCE_SELECT_MODE_ID__PHASES: {
-          // Add a resource fit function for each game phase.
-          for (size_t i = 0; i < testcases_by_phase.size(); ++i) {
-            sgp_resource_fit_set.push_back([i, this](SignalGPAgent & agent) {
-              double score = 0;
-              emp::vector<size_t> & phasecases = testcases_by_phase[i];
-              // Aggregate all relevant test scores.
-              for (size_t j = 0; j < phasecases.size(); ++j) {
-                score += agent_phen_cache[agent.GetID()].testcase_scores[phasecases[j]];
-              }
-              return score;
-            });
-          }
-          break;
-        }
-        case RESOURCE_SELECT_MODE_ID__INDIV: {
-          // Add a resource fit function for each testcase.
-          for (size_t i = 0; i < testcases.GetSize(); ++i) {
-            sgp_resource_fit_set.push_back([i, this](SignalGPAgent & agent) {
-              return agent_phen_cache[agent.GetID()].testcase_scores[i];
-            });
-          }
-          break;
-        }
-        default:
-          std::cout << "Unrecognized resource select mode. Exiting..." << std::endl;
-          exit(-1);
+      case SELECTION_METHOD_ID__ECOEA: {
+        // Resource scores (see CalcResourceScores) are computed once per generation, right after evaluation.
+        do_evaluation_sig.AddAction([this]() { this->CalcResourceScores(sgp_world->GetSize()); });
+        do_selection_sig.AddAction([this]() {
+          this->EliteSelect_MASK(*sgp_world, ELITE_SELECT__ELITE_CNT, 1);
+          ResourceSelectMatrix(*sgp_world, resource_selector, resources,
+                               TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT, RESOURCE_SELECT__FRAC,
+                               RESOURCE_SELECT__MAX_BONUS, RESOURCE_SELECT__COST);
+        });
+        break;
       }
-      // Setup the do selection signal action.
-      do_selection_sig.AddAction([this]() {
-        this->EliteSelect_MASK(*sgp_world, ELITE_SELECT__ELITE_CNT, 1);
-        emp::ResourceSelect(*sgp_world, sgp_resource_fit_set, resources,
-                            TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT, RESOURCE_SELECT__FRAC,
-                            RESOURCE_SELECT__MAX_BONUS, RESOURCE_SELECT__COST);
-      });
-      break;
-    }
-    case SELECTION_METHOD_ID__MAPELITES:
-      std::cout << "Map-Elites selection not setup yet..." << std::endl;
-      exit(-1);
-      break;
-    case SELECTION_METHOD_ID__ROULETTE: {
-      do_selection_sig.AddAction([this]() {
-        this->EliteSelect_MASK(*sgp_world, ELITE_SELECT__ELITE_CNT, 1);
-        emp::RouletteSelect(*sgp_world, POP_SIZE - ELITE_SELECT__ELITE_CNT);
-      });
-      break;
+      case SELECTION_METHOD_ID__ROULETTE: {
+        do_selection_sig.AddAction([this]() {
+          this->EliteSelect_MASK(*sgp_world, ELITE_SELECT__ELITE_CNT, 1);
+          this->CalcReproFitness(sgp_world->GetSize());
+          roulette_table.Build(repro_fitness);
+          RouletteSelectArray(*sgp_world, roulette_table, POP_SIZE - ELITE_SELECT__ELITE_CNT, repro_parents);
+        });
+        break;
+      }
+      default:
+        std::cout << "Unrecognized selection method! Exiting..." << std::endl;
+        exit(-1);
     }
-    default:
-      std::cout << "Unrecognized selection method! Exiting..." << std::endl;
-      exit(-1);
   }
 
   // ANALYSIS_TYPE ANALYSIS_TYPE_ID__DEBUGGING
   switch (RUN_MODE) {
     case RUN_ID__EXP: {
-      // Setup run-mode agent advance signal response.
-      agent_advance_sig.AddAction([this]() {
-        sgp_eval_hw->SingleProcess();
-      });
+      // Setup run-mode agent evaluation.
+      run_eval_agent = [this](size_t max_steps) {
+        return sgp_eval_hw->RunUntil(max_steps, SGP__IsEvalDone);
+      };
       // Setup run-mode begin turn signal response.
       begin_turn_sig.AddAction([this](const othello_t & game) {
         const player_t playerID = testcases[cur_testcase].GetInput().playerID;
         SGP__ResetHW();
-        othello_dreamware->Reset(game);
-        othello_dreamware->SetActiveDream(0);
-        othello_dreamware->SetPlayerID(playerID);
+        eval_context.BeginTurn(game, playerID);
       });
       // Setup non-verbose get move.
       get_eval_agent_move = [this]() {
@@ -1530,14 +2205,17 @@ void LineageExp::ConfigSGP() {
         case ANALYSIS_TYPE_ID__DEBUGGING: {
           // Debugging analysis signal response.
           do_analysis_sig.AddAction([this]() { this->SGP__Debugging_Analysis(); });
-          // Setup a verbose agent_advance_sig
-          agent_advance_sig.AddAction([this]() {
-            std::cout << "----- EVAL STEP: " << eval_time << " -----" << std::endl;
-            sgp_eval_hw->SingleProcess();
-            sgp_eval_hw->PrintState();
-            std::cout << "--- DREAMBOARD STATE ---" << std::endl;
-            othello_dreamware->GetActiveDreamOthello().Print();
-          });
+          // Setup a verbose (single-stepping) agent evaluation.
+          run_eval_agent = [this](size_t max_steps) {
+            for (eval_time = 0; eval_time < max_steps && !SGP__IsEvalDone(*sgp_eval_hw); ++eval_time) {
+              std::cout << "----- EVAL STEP: " << eval_time << " -----" << std::endl;
+              sgp_eval_hw->SingleProcess();
+              sgp_eval_hw->PrintState();
+              std::cout << "--- DREAMBOARD STATE ---" << std::endl;
+              othello_dreamware->GetActiveDreamOthello().Print();
+            }
+            return eval_time;
+          };
           // Setup a verbose begin_turn_sig response.
           begin_turn_sig.AddAction([this](const othello_t & game) {
             const player_t playerID = testcases[cur_testcase].GetInput().playerID;
@@ -1563,9 +2241,7 @@ void LineageExp::ConfigSGP() {
             } std::cout << std::endl;
 
             SGP__ResetHW();
-            othello_dreamware->Reset(game);
-            othello_dreamware->SetActiveDream(0);
-            othello_dreamware->SetPlayerID(playerID);
+            eval_context.BeginTurn(game, playerID);
           });
 
           get_eval_agent_move = [this]() {
@@ -1594,7 +2270,14 @@ void LineageExp::ConfigAGP() {
   agp_world->Reset();
   agp_world->SetWellMixed(true);
   // NOTE: second argument specifies that we're not mutating the first thing in the pop (we're doing elite selection in all of our stuff).
-  agp_world->SetMutFun([this](AvidaGPAgent &agent, emp::Random &rnd) { return this->AGP__Mutate(agent, rnd); }, ELITE_SELECT__ELITE_CNT);
+  // Mutations come from stream (update, birth_cnt, mutation) rather than the world's generator.
+  agp_world->SetMutFun([this](AvidaGPAgent &agent, emp::Random &) {
+    if (repro_premutated) return (size_t)0; // Batched reproduction already mutated this one.
+    rng.SetStream(update, birth_cnt++, RANDOM_PURPOSE_ID__MUTATION);
+    const size_t mut_cnt = this->AGP__Mutate(agent.GetGenome(), rng, mutator);
+    last_mutation = mutator.muts;
+    return mut_cnt;
+  }, ELITE_SELECT__ELITE_CNT);
   agp_world->SetFitFun([this](Agent &agent) { return this->CalcFitness(agent); });
   agp_world->OnGenotypeKnown([this](emp::Ptr<AGP__genotype_t> genotype, size_t pos) {
     genotype->GetData().RecordMutation(last_mutation);
@@ -1602,7 +2285,12 @@ void LineageExp::ConfigAGP() {
 
   ConfigAGP_InstLib();
 
-  agp_eval_hw = emp::NewPtr<AGP__hardware_t>(agp_inst_lib);
+  agp_eval_hw = emp::NewPtr<AGP__eval_hw_t>(agp_inst_lib);
+  agp_eval_hw->SetContext(&eval_context);
+  for (emp::Ptr<DemeEvaluator> de : deme_evaluators) {
+    de->agp_eval_hw = emp::NewPtr<AGP__eval_hw_t>(agp_inst_lib);
+    de->agp_eval_hw->SetContext(&de->context);
+  }
 
   // Setup triggers!
   // Configure initial run setup
@@ -1631,9 +2319,12 @@ void LineageExp::ConfigAGP() {
     auto & fit_file = agp_world->SetupFitnessFile(DATA_DIRECTORY + "fitness.csv");
     fit_file.SetTimingRepeat(FITNESS_INTERVAL);
     emp::AddPhylodiversityFile(*agp_world, DATA_DIRECTORY + "phylodiversity.csv").SetTimingRepeat(SYSTEMATICS_INTERVAL);
-    emp::AddLineageMutationFile(*agp_world, DATA_DIRECTORY + "lineage_mutations.csv", MUTATION_TYPES).SetTimingRepeat(SYSTEMATICS_INTERVAL);
+    AddLineageMutationCountFile(*agp_world, DATA_DIRECTORY + "lineage_mutations.csv", MUTATION_TYPES).SetTimingRepeat(SYSTEMATICS_INTERVAL);
     AddDominantFile(*agp_world, DATA_DIRECTORY + "dominant.csv", MUTATION_TYPES).SetTimingRepeat(SYSTEMATICS_INTERVAL);
     AddBestPhenotypeFile(*agp_world, DATA_DIRECTORY+"best_phenotype.csv").SetTimingRepeat(SYSTEMATICS_INTERVAL);
+    if (ISLAND__DEME_CNT > 1 && ISLAND__DEME_SYSTEMATICS) {
+      AddDemeSystematicsFile(*agp_world, DATA_DIRECTORY+"deme_systematics.csv").SetTimingRepeat(SYSTEMATICS_INTERVAL);
+    }
     // agp_muller_file = emp::AddMullerPlotFile(*agp_world, DATA_DIRECTORY + "muller_data.dat");
     // agp_world->OnUpdate([this](size_t ud){ if (ud % SYSTEMATICS_INTERVAL == 0) agp_muller_file.Update(); });
     record_fit_sig.AddAction([this](size_t pos, double fitness) { agp_world->GetGenotypeAt(pos)->GetData().RecordFitness(fitness); } );
@@ -1646,14 +2337,17 @@ void LineageExp::ConfigAGP() {
   do_evaluation_sig.AddAction([this]() {
     double best_score = -32767;
     best_agent_id = 0;
+    if (deme_evaluators.size()) this->AGP__EvaluateDemes();
     for (size_t id = 0; id < agp_world->GetSize(); ++id)
     {
-      //std::cout << "Evaluating agent: " << id << std::endl;
-      // Evaluate agent given by id.
-      AvidaGPAgent &our_hero = agp_world->GetOrg(id);
-      our_hero.SetID(id);
-      agp_eval_hw->SetGenome(our_hero.GetGenome());
-      this->Evaluate(our_hero);
+      if (deme_evaluators.empty()) {
+        //std::cout << "Evaluating agent: " << id << std::endl;
+        // Evaluate agent given by id.
+        AvidaGPAgent &our_hero = agp_world->GetOrg(id);
+        our_hero.SetID(id);
+        AGP__SetEvalGenome(our_hero.GetGenome(), agp_world->GetGenotypeAt(id)->GetData().agp_compiled);
+        this->Evaluate(our_hero);
+      }
       Phenotype & phen = agent_phen_cache[id];
       if (phen.aggregate_score > best_score) {
         best_score = phen.aggregate_score;
@@ -1662,83 +2356,59 @@ void LineageExp::ConfigAGP() {
     }
     std::cout << "Update: " << update << " Max score: " << best_score << std::endl;
   });
+  if (SELECTION_METHOD == SELECTION_METHOD_ID__MAPELITES) {
+    do_evaluation_sig.AddAction([this]() { this->UpdateMapElitesArchive(*agp_world); });
+  }
 
-  switch (SELECTION_METHOD)
-  {
-  case SELECTION_METHOD_ID__TOURNAMENT:
+  if (REPRO_THREADS > 0) {
+    // Batched reproduction: parents first, then offspring copied/mutated by REPRO_THREADS workers.
     do_selection_sig.AddAction([this]() {
-      this->EliteSelect_MASK(*agp_world, ELITE_SELECT__ELITE_CNT, 1);
-      emp::TournamentSelect(*agp_world, TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT);
+      this->DoBatchedReproduction(*agp_world, agp_offspring, [this](AGP__program_t & program, CounterRandom & rnd, MutatorState & mstate) {
+        return this->AGP__Mutate(program, rnd, mstate);
+      });
     });
-    break;
-  case SELECTION_METHOD_ID__LEXICASE: {
-    agp_lexicase_fit_set.resize(0);
-    for (size_t i = 0; i < testcases.GetSize(); ++i) {
-      agp_lexicase_fit_set.push_back([i, this](AvidaGPAgent & agent) {
-        return agent_phen_cache[agent.GetID()].testcase_scores[i];
+  } else {
+    switch (SELECTION_METHOD)
+    {
+    case SELECTION_METHOD_ID__TOURNAMENT:
+      do_selection_sig.AddAction([this]() {
+        this->EliteSelect_MASK(*agp_world, ELITE_SELECT__ELITE_CNT, 1);
+        this->CalcReproFitness(agp_world->GetSize());
+        TournamentSelectArray(*agp_world, repro_fitness, TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT, repro_parents);
+      });
+      break;
+    case SELECTION_METHOD_ID__LEXICASE: {
+      do_selection_sig.AddAction([this]() {
+        this->EliteSelect_MASK(*agp_world, ELITE_SELECT__ELITE_CNT, 1);
+        this->PrepareLexicase(agp_world->GetSize());
+        LexicaseSelectMatrix(*agp_world, lexicase, POP_SIZE - ELITE_SELECT__ELITE_CNT, lexicase_parents);
       });
+      break;
     }
-    do_selection_sig.AddAction([this]() {
-      this->EliteSelect_MASK(*agp_world, ELITE_SELECT__ELITE_CNT, 1);
-      emp::LexicaseSelect(*agp_world, agp_lexicase_fit_set, POP_SIZE - ELITE_SELECT__ELITE_CNT);
-    });
-    break;
-  }
-  case SELECTION_METHOD_ID__ECOEA: {
-    agp_resource_fit_set.resize(0);
-    // Setup the fitness function set based on resource select mode.
-    switch (RESOURCE_SELECT__MODE) {
-      case RESOURCE_SELECT_MODE_ID__PHASES: {
-        // Add a resource fit function for each game phase.
-        for (size_t i = 0; i < testcases_by_phase.size(); ++i) {
-          agp_resource_fit_set.push_back([i, this](AvidaGPAgent & agent) {
-            double score = 0;
-            emp::vector<size_t> & phasecases = testcases_by_phase[i];
-            // Aggregate all relevant test scores.
-            for (size_t j = 0; j < phasecases.size(); ++j) {
-              score += agent_phen_cache[agent.GetID()].testcase_scores[phasecases[j]];
-            }
-            return score;
-          });
-        }
-        break;
-      }
-      case RESOURCE_SELECT_MODE_ID__INDIV: {
-        // Add a resource fit function for each testcase.
-        for (size_t i = 0; i < testcases.GetSize(); ++i) {
-          agp_resource_fit_set.push_back([i, this](AvidaGPAgent & agent) {
-            return agent_phen_cache[agent.GetID()].testcase_scores[i];
-          });
-        }
-        break;
-      }
-      default:
-        std::cout << "Unrecognized resource select mode. Exiting..." << std::endl;
-        exit(-1);
+    case SELECTION_METHOD_ID__ECOEA: {
+      // Resource scores (see CalcResourceScores) are computed once per generation, right after evaluation.
+      do_evaluation_sig.AddAction([this]() { this->CalcResourceScores(agp_world->GetSize()); });
+      do_selection_sig.AddAction([this]() {
+        this->EliteSelect_MASK(*agp_world, ELITE_SELECT__ELITE_CNT, 1);
+        ResourceSelectMatrix(*agp_world, resource_selector, resources,
+                             TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT, RESOURCE_SELECT__FRAC,
+                             RESOURCE_SELECT__MAX_BONUS, RESOURCE_SELECT__COST);
+      });
+      break;
+    }
+    case SELECTION_METHOD_ID__ROULETTE: {
+      do_selection_sig.AddAction([this]() {
+        this->EliteSelect_MASK(*agp_world, ELITE_SELECT__ELITE_CNT, 1);
+        this->CalcReproFitness(agp_world->GetSize());
+        roulette_table.Build(repro_fitness);
+        RouletteSelectArray(*agp_world, roulette_table, POP_SIZE - ELITE_SELECT__ELITE_CNT, repro_parents);
+      });
+      break;
+    }
+    default:
+      std::cout << "Unrecognized selection method! Exiting..." << std::endl;
+      exit(-1);
     }
-    // Setup the do selection signal action.
-    do_selection_sig.AddAction([this]() {
-      this->EliteSelect_MASK(*agp_world, ELITE_SELECT__ELITE_CNT, 1);
-      emp::ResourceSelect(*agp_world, agp_resource_fit_set, resources,
-                          TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT, RESOURCE_SELECT__FRAC,
-                          RESOURCE_SELECT__MAX_BONUS, RESOURCE_SELECT__COST);
-    });
-    break;
-  }
-  case SELECTION_METHOD_ID__MAPELITES:
-    std::cout << "Map-Elites selection not setup yet..." << std::endl;
-    exit(-1);
-    break;
-  case SELECTION_METHOD_ID__ROULETTE: {
-    do_selection_sig.AddAction([this]() {
-      this->EliteSelect_MASK(*agp_world, ELITE_SELECT__ELITE_CNT, 1);
-      emp::RouletteSelect(*agp_world, POP_SIZE - ELITE_SELECT__ELITE_CNT);
-    });
-    break;
-  }
-  default:
-    std::cout << "Unrecognized selection method! Exiting..." << std::endl;
-    exit(-1);
   }
 
   // - Configure world upate.
@@ -1751,17 +2421,15 @@ void LineageExp::ConfigAGP() {
   switch (RUN_MODE) {
 
     case RUN_ID__EXP: {
-      // Setup run-mode agent advance signal response.
-      agent_advance_sig.AddAction([this]() {
-        agp_eval_hw->SingleProcess();
-      });
+      // Setup run-mode agent evaluation.
+      run_eval_agent = [this](size_t max_steps) {
+        return agp_eval_hw->RunUntil(max_steps, AGP__IsEvalDone);
+      };
       // Setup run-mode begin turn signal response.
       begin_turn_sig.AddAction([this](const othello_t & game) {
         const player_t playerID = testcases[cur_testcase].GetInput().playerID;
         AGP__ResetHW();
-        othello_dreamware->Reset(game);
-        othello_dreamware->SetActiveDream(0);
-        othello_dreamware->SetPlayerID(playerID);
+        eval_context.BeginTurn(game, playerID);
       });
       // Setup non-verbose get move.
       get_eval_agent_move = [this]() {
@@ -1781,10 +2449,6 @@ void LineageExp::ConfigAGP() {
       exit(-1);
   }
 
-  get_eval_agent_done = [this]() {
-    return (bool)agp_eval_hw->GetTrait(TRAIT_ID__DONE);
-  };
-
   get_eval_agent_playerID = [this]() {
     return othello_dreamware->GetPlayerID();
   };
@@ -3,120 +3,80 @@
 
 #include "LineageExp.h"
 
-void LineageExp::ConfigSGP_InstLib() {
+template<typename HW_T, typename INST_LIB_T>
+void LineageExp::ConfigSGP_InstLib(INST_LIB_T & inst_lib) {
   // Configure the instruction set.
   // - Default instruction set.
-  sgp_inst_lib->AddInst("Inc", SGP__hardware_t::Inst_Inc, 1, "Increment value in local memory Arg1");
-  sgp_inst_lib->AddInst("Dec", SGP__hardware_t::Inst_Dec, 1, "Decrement value in local memory Arg1");
-  sgp_inst_lib->AddInst("Not", SGP__hardware_t::Inst_Not, 1, "Logically toggle value in local memory Arg1");
-  sgp_inst_lib->AddInst("Add", SGP__hardware_t::Inst_Add, 3, "Local memory: Arg3 = Arg1 + Arg2");
-  sgp_inst_lib->AddInst("Sub", SGP__hardware_t::Inst_Sub, 3, "Local memory: Arg3 = Arg1 - Arg2");
-  sgp_inst_lib->AddInst("Mult", SGP__hardware_t::Inst_Mult, 3, "Local memory: Arg3 = Arg1 * Arg2");
-  sgp_inst_lib->AddInst("Div", SGP__hardware_t::Inst_Div, 3, "Local memory: Arg3 = Arg1 / Arg2");
-  sgp_inst_lib->AddInst("Mod", SGP__hardware_t::Inst_Mod, 3, "Local memory: Arg3 = Arg1 % Arg2");
-  sgp_inst_lib->AddInst("TestEqu", SGP__hardware_t::Inst_TestEqu, 3, "Local memory: Arg3 = (Arg1 == Arg2)");
-  sgp_inst_lib->AddInst("TestNEqu", SGP__hardware_t::Inst_TestNEqu, 3, "Local memory: Arg3 = (Arg1 != Arg2)");
-  sgp_inst_lib->AddInst("TestLess", SGP__hardware_t::Inst_TestLess, 3, "Local memory: Arg3 = (Arg1 < Arg2)");
-  sgp_inst_lib->AddInst("If", SGP__hardware_t::Inst_If, 1, "Local memory: If Arg1 != 0, proceed; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
-  sgp_inst_lib->AddInst("While", SGP__hardware_t::Inst_While, 1, "Local memory: If Arg1 != 0, loop; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
-  sgp_inst_lib->AddInst("Countdown", SGP__hardware_t::Inst_Countdown, 1, "Local memory: Countdown Arg1 to zero.", emp::ScopeType::BASIC, 0, {"block_def"});
-  sgp_inst_lib->AddInst("Close", SGP__hardware_t::Inst_Close, 0, "Close current block if there is a block to close.", emp::ScopeType::BASIC, 0, {"block_close"});
-  sgp_inst_lib->AddInst("Break", SGP__hardware_t::Inst_Break, 0, "Break out of current block.");
-  sgp_inst_lib->AddInst("Call", SGP__hardware_t::Inst_Call, 0, "Call function that best matches call affinity.", emp::ScopeType::BASIC, 0, {"affinity"});
-  sgp_inst_lib->AddInst("Return", SGP__hardware_t::Inst_Return, 0, "Return from current function if possible.");
-  sgp_inst_lib->AddInst("SetMem", SGP__hardware_t::Inst_SetMem, 2, "Local memory: Arg1 = numerical value of Arg2");
-  sgp_inst_lib->AddInst("CopyMem", SGP__hardware_t::Inst_CopyMem, 2, "Local memory: Arg1 = Arg2");
-  sgp_inst_lib->AddInst("SwapMem", SGP__hardware_t::Inst_SwapMem, 2, "Local memory: Swap values of Arg1 and Arg2.");
-  sgp_inst_lib->AddInst("Input", SGP__hardware_t::Inst_Input, 2, "Input memory Arg1 => Local memory Arg2.");
-  sgp_inst_lib->AddInst("Output", SGP__hardware_t::Inst_Output, 2, "Local memory Arg1 => Output memory Arg2.");
-  sgp_inst_lib->AddInst("Commit", SGP__hardware_t::Inst_Commit, 2, "Local memory Arg1 => Shared memory Arg2.");
-  sgp_inst_lib->AddInst("Pull", SGP__hardware_t::Inst_Pull, 2, "Shared memory Arg1 => Shared memory Arg2.");
-  sgp_inst_lib->AddInst("Nop", SGP__hardware_t::Inst_Nop, 0, "No operation.");
+  inst_lib.AddInst("Inc", HW_T::Inst_Inc, 1, "Increment value in local memory Arg1");
+  inst_lib.AddInst("Dec", HW_T::Inst_Dec, 1, "Decrement value in local memory Arg1");
+  inst_lib.AddInst("Not", HW_T::Inst_Not, 1, "Logically toggle value in local memory Arg1");
+  inst_lib.AddInst("Add", HW_T::Inst_Add, 3, "Local memory: Arg3 = Arg1 + Arg2");
+  inst_lib.AddInst("Sub", HW_T::Inst_Sub, 3, "Local memory: Arg3 = Arg1 - Arg2");
+  inst_lib.AddInst("Mult", HW_T::Inst_Mult, 3, "Local memory: Arg3 = Arg1 * Arg2");
+  inst_lib.AddInst("Div", HW_T::Inst_Div, 3, "Local memory: Arg3 = Arg1 / Arg2");
+  inst_lib.AddInst("Mod", HW_T::Inst_Mod, 3, "Local memory: Arg3 = Arg1 % Arg2");
+  inst_lib.AddInst("TestEqu", HW_T::Inst_TestEqu, 3, "Local memory: Arg3 = (Arg1 == Arg2)");
+  inst_lib.AddInst("TestNEqu", HW_T::Inst_TestNEqu, 3, "Local memory: Arg3 = (Arg1 != Arg2)");
+  inst_lib.AddInst("TestLess", HW_T::Inst_TestLess, 3, "Local memory: Arg3 = (Arg1 < Arg2)");
+  inst_lib.AddInst("If", HW_T::Inst_If, 1, "Local memory: If Arg1 != 0, proceed; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
+  inst_lib.AddInst("While", HW_T::Inst_While, 1, "Local memory: If Arg1 != 0, loop; else, skip block.", emp::ScopeType::BASIC, 0, {"block_def"});
+  inst_lib.AddInst("Countdown", HW_T::Inst_Countdown, 1, "Local memory: Countdown Arg1 to zero.", emp::ScopeType::BASIC, 0, {"block_def"});
+  inst_lib.AddInst("Close", HW_T::Inst_Close, 0, "Close current block if there is a block to close.", emp::ScopeType::BASIC, 0, {"block_close"});
+  inst_lib.AddInst("Break", HW_T::Inst_Break, 0, "Break out of current block.");
+  inst_lib.AddInst("Call", SGP__Inst_Call<HW_T>, 0, "Call function that best matches call affinity.", emp::ScopeType::BASIC, 0, {"affinity"});
+  inst_lib.AddInst("Return", HW_T::Inst_Return, 0, "Return from current function if possible.");
+  inst_lib.AddInst("SetMem", HW_T::Inst_SetMem, 2, "Local memory: Arg1 = numerical value of Arg2");
+  inst_lib.AddInst("CopyMem", HW_T::Inst_CopyMem, 2, "Local memory: Arg1 = Arg2");
+  inst_lib.AddInst("SwapMem", HW_T::Inst_SwapMem, 2, "Local memory: Swap values of Arg1 and Arg2.");
+  inst_lib.AddInst("Input", HW_T::Inst_Input, 2, "Input memory Arg1 => Local memory Arg2.");
+  inst_lib.AddInst("Output", HW_T::Inst_Output, 2, "Local memory Arg1 => Output memory Arg2.");
+  inst_lib.AddInst("Commit", HW_T::Inst_Commit, 2, "Local memory Arg1 => Shared memory Arg2.");
+  inst_lib.AddInst("Pull", HW_T::Inst_Pull, 2, "Shared memory Arg1 => Shared memory Arg2.");
+  inst_lib.AddInst("Nop", HW_T::Inst_Nop, 0, "No operation.");
   // - Non-default instruction set.
-  sgp_inst_lib->AddInst("Fork",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_Fork(hw, inst); },
-                        0, "Generate internally-handled signal tagged with instuction's tag (spawns another thread w/local memory as new thread's input memory).");
-  sgp_inst_lib->AddInst("GetBoardWidth",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP_Inst_GetBoardWidth(hw, inst); },
-                        1, "WM[ARG1] = Othello board width");
-  sgp_inst_lib->AddInst("EndTurn",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP_Inst_EndTurn(hw, inst); },
-                        0, "End current othello turn");
-  sgp_inst_lib->AddInst("SetMoveXY",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_SetMoveXY(hw, inst); },
-                        2, "MoveXY = (WM[ARG1], WM[ARG2])");
-  sgp_inst_lib->AddInst("SetMoveID",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_SetMoveID(hw, inst); },
-                        1, "MoveID = (WM[ARG1])");
-  sgp_inst_lib->AddInst("GetMoveXY",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_GetMoveXY(hw, inst); },
-                        2, "WM[ARG1] = Current moveX; WM[ARG2] = Current moveY");
-  sgp_inst_lib->AddInst("GetMoveID",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_GetMoveID(hw, inst); },
-                        1, "WM[ARG1] = Current moveID");
-  sgp_inst_lib->AddInst("IsValidXY-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_IsValidXY_HW(hw, inst); },
-                        3, "WM[ARG3] = IsValidMoveXY(WM[ARG1], WM[ARG2])");
-  sgp_inst_lib->AddInst("IsValidID-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_IsValidID_HW(hw, inst); },
-                        2, "WM[ARG2] = IsValidMoveID(WM[ARG1])");
-  sgp_inst_lib->AddInst("IsValidOppXY-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_IsValidOppXY_HW(hw, inst); },
-                        3, "WM[ARG3] = IsValidOppMoveXY(WM[ARG1], WM[ARG2])");
-  sgp_inst_lib->AddInst("IsValidOppID-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_IsValidOppID_HW(hw, inst); },
-                        2, "WM[ARG2] = IsValidOppMoveID(WM[ARG1])");
-  sgp_inst_lib->AddInst("AdjacentXY",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_AdjacentXY(hw, inst); },
-                        3, "Adjusts WM[ARG1], WM[ARG2] to give adjacent location (X,Y) in direction specified by WM[ARG3]");
-  sgp_inst_lib->AddInst("AdjacentID",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_AdjacentID(hw, inst); },
-                        2, "Adjusts WM[ARG1] to give adjacent location (ID) in direction specified by WM[ARG2]");
-  sgp_inst_lib->AddInst("ValidMoveCnt-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_ValidMoveCnt_HW(hw, inst); },
-                        1, "WM[ARG1] = Number of valid moves on active othello hardware board");
-  sgp_inst_lib->AddInst("ValidOppMoveCnt-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_ValidOppMoveCnt_HW(hw, inst); },
-                        1, "WM[ARG1] = Number of opponent's valid moves on active othello hardware board");
-  sgp_inst_lib->AddInst("GetBoardValueXY-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_GetBoardValueXY_HW(hw, inst); },
-                        3, "WM[ARG3] = owner of position X (WM[ARG1]), Y (WM[ARG2]) on othello hardware board");
-  sgp_inst_lib->AddInst("GetBoardValueID-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_GetBoardValueID_HW(hw, inst); },
-                        2, "WM[ARG2] = owner of position ID (WM[ARG1]) on othello hardware board");
-  sgp_inst_lib->AddInst("PlaceDiskXY-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_PlaceDiskXY_HW(hw, inst); },
-                        3, "Place disk (of own type) on hardware board at position X (WM[ARG1]), Y (WM[ARG2]). Only successful if valid. WM[ARG3] is used to indicate move success.");
-  sgp_inst_lib->AddInst("PlaceDiskID-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_PlaceDiskID_HW(hw, inst); },
-                        2, "Place disk (of own type) on hardware board at position ID (WM[ARG1]). Only successful if valid. WM[ARG3] is used to indicate move success");
-  sgp_inst_lib->AddInst("PlaceOppDiskXY-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_PlaceOppDiskXY_HW(hw, inst); },
-                        3, "Place disk (of opponent's type) on hardware board at position X (WM[ARG1]), Y (WM[ARG2]). Only successful if valid. WM[ARG3] is used to indicate move success");
-  sgp_inst_lib->AddInst("PlaceOppDiskID-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_PlaceOppDiskID_HW(hw, inst); },
-                        2, "Place disk (of opponent's type) on hardware board at position ID (WM[ARG1]). Only successful if valid. WM[ARG3] is used to indicate move success");
-  sgp_inst_lib->AddInst("FlipCntXY-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_FlipCntXY_HW(hw, inst); },
-                        3, "WM[ARG3] = Number of disk flips if agent places disk at X (WM[ARG1]), Y (WM[ARG2])");
-  sgp_inst_lib->AddInst("FlipCntID-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_FlipCntID_HW(hw, inst); },
-                        2, "WM[ARG3] = Number of disk flips if agent places disk at ID (WM[ARG1])");
-  sgp_inst_lib->AddInst("OppFlipCntXY-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_OppFlipCntXY_HW(hw, inst); },
-                        3, "WM[ARG3] = Number of disk flips if agent's opponent places disk at X (WM[ARG1]), Y (WM[ARG2])");
-  sgp_inst_lib->AddInst("OppFlipCntID-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_OppFlipCntID_HW(hw, inst); },
-                        2, "WM[ARG3] = Number of disk flips if agent's opponent places disk at ID (WM[ARG1])");
-  sgp_inst_lib->AddInst("FrontierCnt-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_FrontierCnt_HW(hw, inst); },
-                        1, "WM[ARG1] = Agent's frontier count on othello hardware board");
-  sgp_inst_lib->AddInst("ResetBoard-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_ResetBoard_HW(hw, inst); },
-                        0, "Reset active othello hardware board.");
-  sgp_inst_lib->AddInst("IsOver-HW",
-                        [this](SGP__hardware_t & hw, const SGP__inst_t & inst) { this->SGP__Inst_IsOver_HW(hw, inst); },
-                        1, "Is game over on active othello hardware board?");
+  inst_lib.AddInst("Fork", SGP__Inst_Fork<HW_T>, 0, "Generate internally-handled signal tagged with instuction's tag (spawns another thread w/local memory as new thread's input memory).");
+  inst_lib.AddInst("GetBoardWidth", SGP_Inst_GetBoardWidth<HW_T>, 1, "WM[ARG1] = Othello board width");
+  inst_lib.AddInst("EndTurn", SGP_Inst_EndTurn<HW_T>, 0, "End current othello turn");
+  inst_lib.AddInst("SetMoveXY", SGP__Inst_SetMoveXY<HW_T>, 2, "MoveXY = (WM[ARG1], WM[ARG2])");
+  inst_lib.AddInst("SetMoveID", SGP__Inst_SetMoveID<HW_T>, 1, "MoveID = (WM[ARG1])");
+  inst_lib.AddInst("GetMoveXY", SGP__Inst_GetMoveXY<HW_T>, 2, "WM[ARG1] = Current moveX; WM[ARG2] = Current moveY");
+  inst_lib.AddInst("GetMoveID", SGP__Inst_GetMoveID<HW_T>, 1, "WM[ARG1] = Current moveID");
+  inst_lib.AddInst("IsValidXY-HW", SGP__Inst_IsValidXY_HW<HW_T>, 3, "WM[ARG3] = IsValidMoveXY(WM[ARG1], WM[ARG2])");
+  inst_lib.AddInst("IsValidID-HW", SGP__Inst_IsValidID_HW<HW_T>, 2, "WM[ARG2] = IsValidMoveID(WM[ARG1])");
+  inst_lib.AddInst("IsValidOppXY-HW", SGP__Inst_IsValidOppXY_HW<HW_T>, 3, "WM[ARG3] = IsValidOppMoveXY(WM[ARG1], WM[ARG2])");
+  inst_lib.AddInst("IsValidOppID-HW", SGP__Inst_IsValidOppID_HW<HW_T>, 2, "WM[ARG2] = IsValidOppMoveID(WM[ARG1])");
+  inst_lib.AddInst("AdjacentXY", SGP__Inst_AdjacentXY<HW_T>, 3, "Adjusts WM[ARG1], WM[ARG2] to give adjacent location (X,Y) in direction specified by WM[ARG3]");
+  inst_lib.AddInst("AdjacentID", SGP__Inst_AdjacentID<HW_T>, 2, "Adjusts WM[ARG1] to give adjacent location (ID) in direction specified by WM[ARG2]");
+  inst_lib.AddInst("ValidMoveCnt-HW", SGP__Inst_ValidMoveCnt_HW<HW_T>, 1, "WM[ARG1] = Number of valid moves on active othello hardware board");
+  inst_lib.AddInst("ValidOppMoveCnt-HW", SGP__Inst_ValidOppMoveCnt_HW<HW_T>, 1, "WM[ARG1] = Number of opponent's valid moves on active othello hardware board");
+  inst_lib.AddInst("GetBoardValueXY-HW", SGP__Inst_GetBoardValueXY_HW<HW_T>, 3, "WM[ARG3] = owner of position X (WM[ARG1]), Y (WM[ARG2]) on othello hardware board");
+  inst_lib.AddInst("GetBoardValueID-HW", SGP__Inst_GetBoardValueID_HW<HW_T>, 2, "WM[ARG2] = owner of position ID (WM[ARG1]) on othello hardware board");
+  inst_lib.AddInst("PlaceDiskXY-HW", SGP__Inst_PlaceDiskXY_HW<HW_T>, 3, "Place disk (of own type) on hardware board at position X (WM[ARG1]), Y (WM[ARG2]). Only successful if valid. WM[ARG3] is used to indicate move success.");
+  inst_lib.AddInst("PlaceDiskID-HW", SGP__Inst_PlaceDiskID_HW<HW_T>, 2, "Place disk (of own type) on hardware board at position ID (WM[ARG1]). Only successful if valid. WM[ARG3] is used to indicate move success");
+  inst_lib.AddInst("PlaceOppDiskXY-HW", SGP__Inst_PlaceOppDiskXY_HW<HW_T>, 3, "Place disk (of opponent's type) on hardware board at position X (WM[ARG1]), Y (WM[ARG2]). Only successful if valid. WM[ARG3] is used to indicate move success");
+  inst_lib.AddInst("PlaceOppDiskID-HW", SGP__Inst_PlaceOppDiskID_HW<HW_T>, 2, "Place disk (of opponent's type) on hardware board at position ID (WM[ARG1]). Only successful if valid. WM[ARG3] is used to indicate move success");
+  inst_lib.AddInst("FlipCntXY-HW", SGP__Inst_FlipCntXY_HW<HW_T>, 3, "WM[ARG3] = Number of disk flips if agent places disk at X (WM[ARG1]), Y (WM[ARG2])");
+  inst_lib.AddInst("FlipCntID-HW", SGP__Inst_FlipCntID_HW<HW_T>, 2, "WM[ARG3] = Number of disk flips if agent places disk at ID (WM[ARG1])");
+  inst_lib.AddInst("OppFlipCntXY-HW", SGP__Inst_OppFlipCntXY_HW<HW_T>, 3, "WM[ARG3] = Number of disk flips if agent's opponent places disk at X (WM[ARG1]), Y (WM[ARG2])");
+  inst_lib.AddInst("OppFlipCntID-HW", SGP__Inst_OppFlipCntID_HW<HW_T>, 2, "WM[ARG3] = Number of disk flips if agent's opponent places disk at ID (WM[ARG1])");
+  inst_lib.AddInst("FrontierCnt-HW", SGP__Inst_FrontierCnt_HW<HW_T>, 1, "WM[ARG1] = Agent's frontier count on othello hardware board");
+  inst_lib.AddInst("ResetBoard-HW", SGP__Inst_ResetBoard_HW<HW_T>, 0, "Reset active othello hardware board.");
+  inst_lib.AddInst("IsOver-HW", SGP__Inst_IsOver_HW<HW_T>, 1, "Is game over on active othello hardware board?");
+  if (OTHELLO_HW_BOARDS > 1) {
+    inst_lib.AddInst("SetActiveDream-HW", SGP__Inst_SetActiveDream_HW<HW_T>, 1, "Active othello hardware board = WM[ARG1] (mod board count)");
+  }
+  if (OTHELLO_HW_CHECKPOINTS) {
+    inst_lib.AddInst("PushBoard-HW", SGP__Inst_PushBoard_HW<HW_T>, 1, "Checkpoint active othello hardware board. WM[ARG1] is used to indicate success.");
+    inst_lib.AddInst("PopBoard-HW", SGP__Inst_PopBoard_HW<HW_T>, 1, "Undo moves on active othello hardware board back to its last checkpoint. WM[ARG1] is used to indicate success.");
+  }
+  if (OTHELLO_HW_FEATURES) {
+    inst_lib.AddInst("DiscCnt-HW", SGP__Inst_DiscCnt_HW<HW_T>, 1, "WM[ARG1] = Number of agent's disks on active othello hardware board");
+    inst_lib.AddInst("OppDiscCnt-HW", SGP__Inst_OppDiscCnt_HW<HW_T>, 1, "WM[ARG1] = Number of opponent's disks on active othello hardware board");
+    inst_lib.AddInst("CornerCnt-HW", SGP__Inst_CornerCnt_HW<HW_T>, 1, "WM[ARG1] = Number of corners agent owns on active othello hardware board");
+    inst_lib.AddInst("OppCornerCnt-HW", SGP__Inst_OppCornerCnt_HW<HW_T>, 1, "WM[ARG1] = Number of corners opponent owns on active othello hardware board");
+    inst_lib.AddInst("GreedyMove-HW", SGP__Inst_GreedyMove_HW<HW_T>, 1, "WM[ARG1] = ID of agent's valid move that flips the most disks on active othello hardware board (-1 if none)");
+    inst_lib.AddInst("MobilityDiff-HW", SGP__Inst_MobilityDiff_HW<HW_T>, 1, "WM[ARG1] = Agent's valid move count - opponent's valid move count on active othello hardware board");
+  }
 }
 
 
@@ -133,12 +93,12 @@ void LineageExp::ConfigAGP_InstLib() {
   agp_inst_lib->AddInst("TestEqu", AGP__inst_lib_t::Inst_TestEqu, 3, "regs: Arg3 = (Arg1 == Arg2)");
   agp_inst_lib->AddInst("TestNEqu", AGP__inst_lib_t::Inst_TestNEqu, 3, "regs: Arg3 = (Arg1 != Arg2)");
   agp_inst_lib->AddInst("TestLess", AGP__inst_lib_t::Inst_TestLess, 3, "regs: Arg3 = (Arg1 < Arg2)");
-  agp_inst_lib->AddInst("If", AGP__inst_lib_t::Inst_If, 2, "If reg Arg1 != 0, scope -> Arg2; else skip scope", emp::ScopeType::BASIC, 1);
-  agp_inst_lib->AddInst("While", AGP__inst_lib_t::Inst_While, 2, "Until reg Arg1 != 0, repeat scope Arg2; else skip", emp::ScopeType::LOOP, 1);
-  agp_inst_lib->AddInst("Countdown", AGP__inst_lib_t::Inst_Countdown, 2, "Countdown reg Arg1 to zero; scope to Arg2", emp::ScopeType::LOOP, 1);
-  agp_inst_lib->AddInst("Break", AGP__inst_lib_t::Inst_Break, 1, "Break out of scope Arg1");
+  agp_inst_lib->AddInst("If", AGP__Inst_If, 2, "If reg Arg1 != 0, scope -> Arg2; else skip scope", emp::ScopeType::BASIC, 1);
+  agp_inst_lib->AddInst("While", AGP__Inst_While, 2, "Until reg Arg1 != 0, repeat scope Arg2; else skip", emp::ScopeType::LOOP, 1);
+  agp_inst_lib->AddInst("Countdown", AGP__Inst_Countdown, 2, "Countdown reg Arg1 to zero; scope to Arg2", emp::ScopeType::LOOP, 1);
+  agp_inst_lib->AddInst("Break", AGP__Inst_Break, 1, "Break out of scope Arg1");
   agp_inst_lib->AddInst("Scope", AGP__inst_lib_t::Inst_Scope, 1, "Enter scope Arg1", emp::ScopeType::BASIC, 0);
-  agp_inst_lib->AddInst("Define", AGP__inst_lib_t::Inst_Define, 2, "Build function Arg1 in scope Arg2", emp::ScopeType::FUNCTION, 1);
+  agp_inst_lib->AddInst("Define", AGP__Inst_Define, 2, "Build function Arg1 in scope Arg2", emp::ScopeType::FUNCTION, 1);
   agp_inst_lib->AddInst("Call", AGP__inst_lib_t::Inst_Call, 1, "Call previously defined function Arg1");
   agp_inst_lib->AddInst("Push", AGP__inst_lib_t::Inst_Push, 2, "Push reg Arg1 onto stack Arg2");
   agp_inst_lib->AddInst("Pop", AGP__inst_lib_t::Inst_Pop, 2, "Pop stack Arg1 into reg Arg2");
@@ -149,223 +109,215 @@ void LineageExp::ConfigAGP_InstLib() {
   agp_inst_lib->AddInst("Nop", [](AGP__hardware_t & hw, const AGP__inst_t & inst){ ; }, 0, "No operation.");
 
   // - Non-default instruction set.
-  agp_inst_lib->AddInst("GetBoardWidth",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_GetBoardWidth(hw, inst); },
-                        1, "...");
-  agp_inst_lib->AddInst("EndTurn",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_EndTurn(hw, inst); },
-                        0, "...");
-  agp_inst_lib->AddInst("SetMoveXY",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_SetMoveXY(hw, inst); },
-                        2, "...");
-  agp_inst_lib->AddInst("SetMoveID",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_SetMoveID(hw, inst); },
-                        1, "...");
-  agp_inst_lib->AddInst("GetMoveXY",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_GetMoveXY(hw, inst); },
-                        2, "...");
-  agp_inst_lib->AddInst("GetMoveID",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_GetMoveID(hw, inst); },
-                        1, "...");
-  agp_inst_lib->AddInst("IsValidOppXY-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_IsValidOppXY_HW(hw, inst); },
-                        3, "...");
-  agp_inst_lib->AddInst("IsValidOppID-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_IsValidOppID_HW(hw, inst); },
-                        2, "...");
-  agp_inst_lib->AddInst("IsValidXY-HW",
-                        [this](AGP__hardware_t &hw, const AGP__inst_t &inst) { this->AGP__Inst_IsValidXY_HW(hw, inst); },
-                        3, "...");
-  agp_inst_lib->AddInst("IsValidID-HW",
-                        [this](AGP__hardware_t &hw, const AGP__inst_t &inst) { this->AGP__Inst_IsValidID_HW(hw, inst); },
-                        2, "...");
-  agp_inst_lib->AddInst("AdjacentXY",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_AdjacentXY(hw, inst); },
-                        3, "...");
-  agp_inst_lib->AddInst("AdjacentID",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_AdjacentID(hw, inst); },
-                        2, "...");
-  agp_inst_lib->AddInst("ValidMoveCnt-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_ValidMoveCnt_HW(hw, inst); },
-                        1, "...");
-  agp_inst_lib->AddInst("ValidOppMoveCnt-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_ValidOppMoveCnt_HW(hw, inst); },
-                        1, "...");
-  agp_inst_lib->AddInst("GetBoardValueXY-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_GetBoardValueXY_HW(hw, inst); },
-                        3, "...");
-  agp_inst_lib->AddInst("GetBoardValueID-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_GetBoardValueID_HW(hw, inst); },
-                        2, "...");
-  agp_inst_lib->AddInst("PlaceDiskXY-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_PlaceDiskXY_HW(hw, inst); },
-                        3, "...");
-  agp_inst_lib->AddInst("PlaceDiskID-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_PlaceDiskID_HW(hw, inst); },
-                        2, "...");
-  agp_inst_lib->AddInst("PlaceOppDiskXY-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_PlaceOppDiskXY_HW(hw, inst); },
-                        3, "...");
-  agp_inst_lib->AddInst("PlaceOppDiskID-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_PlaceOppDiskID_HW(hw, inst); },
-                        2, "...");
-  agp_inst_lib->AddInst("FlipCntXY-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_FlipCntXY_HW(hw, inst); },
-                        3, "...");
-  agp_inst_lib->AddInst("FlipCntID-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_FlipCntID_HW(hw, inst); },
-                        2, "...");
-  agp_inst_lib->AddInst("OppFlipCntXY-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_OppFlipCntXY_HW(hw, inst); },
-                        3, "...");
-  agp_inst_lib->AddInst("OppFlipCntID-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_OppFlipCntID_HW(hw, inst); },
-                        2, "...");
-  agp_inst_lib->AddInst("FrontierCnt-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_FrontierCnt_HW(hw, inst); },
-                        1, "...");
-  agp_inst_lib->AddInst("ResetBoard-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_ResetBoard_HW(hw, inst); },
-                        0, "...");
-  agp_inst_lib->AddInst("IsOver-HW",
-                        [this](AGP__hardware_t & hw, const AGP__inst_t & inst) { this->AGP__Inst_IsOver_HW(hw, inst); },
-                        1, "...");
+  agp_inst_lib->AddInst("GetBoardWidth", AGP__Inst_GetBoardWidth, 1, "...");
+  agp_inst_lib->AddInst("EndTurn", AGP__Inst_EndTurn, 0, "...");
+  agp_inst_lib->AddInst("SetMoveXY", AGP__Inst_SetMoveXY, 2, "...");
+  agp_inst_lib->AddInst("SetMoveID", AGP__Inst_SetMoveID, 1, "...");
+  agp_inst_lib->AddInst("GetMoveXY", AGP__Inst_GetMoveXY, 2, "...");
+  agp_inst_lib->AddInst("GetMoveID", AGP__Inst_GetMoveID, 1, "...");
+  agp_inst_lib->AddInst("IsValidOppXY-HW", AGP__Inst_IsValidOppXY_HW, 3, "...");
+  agp_inst_lib->AddInst("IsValidOppID-HW", AGP__Inst_IsValidOppID_HW, 2, "...");
+  agp_inst_lib->AddInst("IsValidXY-HW", AGP__Inst_IsValidXY_HW, 3, "...");
+  agp_inst_lib->AddInst("IsValidID-HW", AGP__Inst_IsValidID_HW, 2, "...");
+  agp_inst_lib->AddInst("AdjacentXY", AGP__Inst_AdjacentXY, 3, "...");
+  agp_inst_lib->AddInst("AdjacentID", AGP__Inst_AdjacentID, 2, "...");
+  agp_inst_lib->AddInst("ValidMoveCnt-HW", AGP__Inst_ValidMoveCnt_HW, 1, "...");
+  agp_inst_lib->AddInst("ValidOppMoveCnt-HW", AGP__Inst_ValidOppMoveCnt_HW, 1, "...");
+  agp_inst_lib->AddInst("GetBoardValueXY-HW", AGP__Inst_GetBoardValueXY_HW, 3, "...");
+  agp_inst_lib->AddInst("GetBoardValueID-HW", AGP__Inst_GetBoardValueID_HW, 2, "...");
+  agp_inst_lib->AddInst("PlaceDiskXY-HW", AGP__Inst_PlaceDiskXY_HW, 3, "...");
+  agp_inst_lib->AddInst("PlaceDiskID-HW", AGP__Inst_PlaceDiskID_HW, 2, "...");
+  agp_inst_lib->AddInst("PlaceOppDiskXY-HW", AGP__Inst_PlaceOppDiskXY_HW, 3, "...");
+  agp_inst_lib->AddInst("PlaceOppDiskID-HW", AGP__Inst_PlaceOppDiskID_HW, 2, "...");
+  agp_inst_lib->AddInst("FlipCntXY-HW", AGP__Inst_FlipCntXY_HW, 3, "...");
+  agp_inst_lib->AddInst("FlipCntID-HW", AGP__Inst_FlipCntID_HW, 2, "...");
+  agp_inst_lib->AddInst("OppFlipCntXY-HW", AGP__Inst_OppFlipCntXY_HW, 3, "...");
+  agp_inst_lib->AddInst("OppFlipCntID-HW", AGP__Inst_OppFlipCntID_HW, 2, "...");
+  agp_inst_lib->AddInst("FrontierCnt-HW", AGP__Inst_FrontierCnt_HW, 1, "...");
+  agp_inst_lib->AddInst("ResetBoard-HW", AGP__Inst_ResetBoard_HW, 0, "...");
+  agp_inst_lib->AddInst("IsOver-HW", AGP__Inst_IsOver_HW, 1, "...");
+  if (OTHELLO_HW_BOARDS > 1) {
+    agp_inst_lib->AddInst("SetActiveDream-HW", AGP__Inst_SetActiveDream_HW, 1, "...");
+  }
+  if (OTHELLO_HW_CHECKPOINTS) {
+    agp_inst_lib->AddInst("PushBoard-HW", AGP__Inst_PushBoard_HW, 1, "...");
+    agp_inst_lib->AddInst("PopBoard-HW", AGP__Inst_PopBoard_HW, 1, "...");
+  }
+  if (OTHELLO_HW_FEATURES) {
+    agp_inst_lib->AddInst("DiscCnt-HW", AGP__Inst_DiscCnt_HW, 1, "...");
+    agp_inst_lib->AddInst("OppDiscCnt-HW", AGP__Inst_OppDiscCnt_HW, 1, "...");
+    agp_inst_lib->AddInst("CornerCnt-HW", AGP__Inst_CornerCnt_HW, 1, "...");
+    agp_inst_lib->AddInst("OppCornerCnt-HW", AGP__Inst_OppCornerCnt_HW, 1, "...");
+    agp_inst_lib->AddInst("GreedyMove-HW", AGP__Inst_GreedyMove_HW, 1, "...");
+    agp_inst_lib->AddInst("MobilityDiff-HW", AGP__Inst_MobilityDiff_HW, 1, "...");
+  }
 }
 
 // --- SGP instruction implementations ---
+// SGP__Inst_Call
+// Same as SGP__hardware_t::Inst_Call, but the called function comes from the program's binding table.
+template<typename HW_T>
+void LineageExp::SGP__Inst_Call(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  const size_t fID = ctx.sgp_bind_table->GetBinding(inst.affinity, hw.GetRandom());
+  if (fID != SGP__bind_table_t::NO_BINDING) hw.CallFunction(fID);
+}
 // SGP__Inst_Fork
-void LineageExp::SGP__Inst_Fork(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  hw.SpawnCore(inst.affinity, hw.GetMinBindThresh(), state.local_mem);
+template<typename HW_T>
+void LineageExp::SGP__Inst_Fork(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  if (hw.GetInactiveCores().empty()) return; // No cores to spare (checked before binding, as in SpawnCore).
+  const size_t fID = ctx.sgp_bind_table->GetBinding(inst.affinity, hw.GetRandom());
+  if (fID == SGP__bind_table_t::NO_BINDING) return;
+  auto & state = hw.GetCurState();
+  hw.SpawnCore(fID, state.local_mem);
 }
 // SGP_Inst_GetBoardWidth
-void LineageExp::SGP_Inst_GetBoardWidth(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
+template<typename HW_T>
+void LineageExp::SGP_Inst_GetBoardWidth(HW_T & hw, const SGP__inst_t & inst) {
+  auto & state = hw.GetCurState();
   state.SetLocal(inst.args[0], OTHELLO_BOARD_WIDTH);
 }
 // SGP_Inst_EndTurn
-void LineageExp::SGP_Inst_EndTurn(SGP__hardware_t & hw, const SGP__inst_t & inst) {
+template<typename HW_T>
+void LineageExp::SGP_Inst_EndTurn(HW_T & hw, const SGP__inst_t & inst) {
   hw.SetTrait(TRAIT_ID__DONE, 1);
 }
 // SGP__Inst_SetMoveXY
-void LineageExp::SGP__Inst_SetMoveXY(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
+template<typename HW_T>
+void LineageExp::SGP__Inst_SetMoveXY(HW_T & hw, const SGP__inst_t & inst) {
+  auto & state = hw.GetCurState();
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
   const othello_idx_t move(move_x, move_y);
   hw.SetTrait(TRAIT_ID__MOVE, move.pos);
 }
 // SGP__Inst_SetMoveID
-void LineageExp::SGP__Inst_SetMoveID(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
+template<typename HW_T>
+void LineageExp::SGP__Inst_SetMoveID(HW_T & hw, const SGP__inst_t & inst) {
+  auto & state = hw.GetCurState();
   const size_t move_id = (size_t)state.GetLocal(inst.args[0]);
   hw.SetTrait(TRAIT_ID__MOVE, move_id);
 }
 // SGP__Inst_GetMoveXY
-void LineageExp::SGP__Inst_GetMoveXY(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
+template<typename HW_T>
+void LineageExp::SGP__Inst_GetMoveXY(HW_T & hw, const SGP__inst_t & inst) {
+  auto & state = hw.GetCurState();
   const othello_idx_t move = GetOthelloIndex((size_t)hw.GetTrait(TRAIT_ID__MOVE));
   state.SetLocal(inst.args[0], move.x());
   state.SetLocal(inst.args[1], move.y());
 }
 // SGP__Inst_GetMoveID
-void LineageExp::SGP__Inst_GetMoveID(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
+template<typename HW_T>
+void LineageExp::SGP__Inst_GetMoveID(HW_T & hw, const SGP__inst_t & inst) {
+  auto & state = hw.GetCurState();
   const size_t move_id = hw.GetTrait(TRAIT_ID__MOVE);
   state.SetLocal(inst.args[0], move_id);
 }
 // SGP__Inst_IsValidXY
-void LineageExp::SGP__Inst_IsValidXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+template<typename HW_T>
+void LineageExp::SGP__Inst_IsValidXY_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
   const size_t move_x = state.GetLocal(inst.args[0]);
   const size_t move_y = state.GetLocal(inst.args[1]);
-  const int valid = (int)othello_lookup.IsValidMove(dreamboard, playerID, {move_x, move_y});
+  const int valid = (int)ctx.lookup->IsValidMove(dreamboard, playerID, {move_x, move_y});
   state.SetLocal(inst.args[2], valid);
 }
 // SGP__Inst_IsValidID_HW
-void LineageExp::SGP__Inst_IsValidID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+template<typename HW_T>
+void LineageExp::SGP__Inst_IsValidID_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
   const size_t move_id = state.GetLocal(inst.args[0]);
-  const int valid = (int)othello_lookup.IsValidMove(dreamboard, playerID, GetOthelloIndex(move_id));
+  const int valid = (int)ctx.lookup->IsValidMove(dreamboard, playerID, GetOthelloIndex(move_id));
   state.SetLocal(inst.args[1], valid);
 }
 // SGP__Inst_IsValidOppXY
-void LineageExp::SGP__Inst_IsValidOppXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+template<typename HW_T>
+void LineageExp::SGP__Inst_IsValidOppXY_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
   const size_t move_x = state.GetLocal(inst.args[0]);
   const size_t move_y = state.GetLocal(inst.args[1]);
-  const int valid = (int)othello_lookup.IsValidMove(dreamboard, oppID, {move_x, move_y});
+  const int valid = (int)ctx.lookup->IsValidMove(dreamboard, oppID, {move_x, move_y});
   state.SetLocal(inst.args[2], valid);
 }
 // SGP__Inst_IsValidOppID
-void LineageExp::SGP__Inst_IsValidOppID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+template<typename HW_T>
+void LineageExp::SGP__Inst_IsValidOppID_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
   const size_t move_id = state.GetLocal(inst.args[0]);
-  const int valid = (int)othello_lookup.IsValidMove(dreamboard, oppID, GetOthelloIndex(move_id));
+  const int valid = (int)ctx.lookup->IsValidMove(dreamboard, oppID, GetOthelloIndex(move_id));
   state.SetLocal(inst.args[1], valid);
 }
 // SGP__Inst_AdjacentXY
-void LineageExp::SGP__Inst_AdjacentXY(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_AdjacentXY(HW_T & hw, const SGP__inst_t & inst) {
+  auto & state = hw.GetCurState();
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
-  const facing_t dir  = IntToFacing(state.GetLocal(inst.args[2]));
-  const othello_idx_t neighbor = dreamboard.GetNeighbor({move_x, move_y}, dir);
-  if (!neighbor.IsValid()) {
+  const size_t neighbor = othello_geom_t::GetNeighbor(othello_geom_t::GetID(move_x, move_y), (int)state.GetLocal(inst.args[2]));
+  if (neighbor == othello_geom_t::INVALID) {
     state.SetLocal(inst.args[0], AGENT_VIEW__ILLEGAL_ID);
     state.SetLocal(inst.args[1], AGENT_VIEW__ILLEGAL_ID);
   } else {
-    state.SetLocal(inst.args[0], neighbor.x());
-    state.SetLocal(inst.args[1], neighbor.y());
+    state.SetLocal(inst.args[0], othello_geom_t::GetX(neighbor));
+    state.SetLocal(inst.args[1], othello_geom_t::GetY(neighbor));
   }
 }
 // SGP__Inst_AdjacentID
-void LineageExp::SGP__Inst_AdjacentID(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_AdjacentID(HW_T & hw, const SGP__inst_t & inst) {
+  auto & state = hw.GetCurState();
   const size_t move_id = (size_t)state.GetLocal(inst.args[0]);
-  const facing_t dir = IntToFacing(state.GetLocal(inst.args[1]));
-  const othello_idx_t neighbor = dreamboard.GetNeighbor(GetOthelloIndex(move_id), dir);
-  state.SetLocal(inst.args[0], (!neighbor.IsValid()) ? AGENT_VIEW__ILLEGAL_ID : neighbor.pos);
+  const size_t neighbor = othello_geom_t::GetNeighbor(move_id, (int)state.GetLocal(inst.args[1]));
+  state.SetLocal(inst.args[0], (neighbor == othello_geom_t::INVALID) ? AGENT_VIEW__ILLEGAL_ID : (int)neighbor);
 }
 // SGP_Inst_ValidMoveCnt_HW
-void LineageExp::SGP__Inst_ValidMoveCnt_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  state.SetLocal(inst.args[0], othello_lookup.GetMoveOptions(dreamboard, playerID).size());
+template<typename HW_T>
+void LineageExp::SGP__Inst_ValidMoveCnt_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  state.SetLocal(inst.args[0], ctx.lookup->GetMoveOptions(dreamboard, playerID).size());
 }
 // SGP_Inst_ValidOppMoveCnt_HW
-void LineageExp::SGP__Inst_ValidOppMoveCnt_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+template<typename HW_T>
+void LineageExp::SGP__Inst_ValidOppMoveCnt_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
-  state.SetLocal(inst.args[0], othello_lookup.GetMoveOptions(dreamboard, oppID).size());
+  state.SetLocal(inst.args[0], ctx.lookup->GetMoveOptions(dreamboard, oppID).size());
 }
 // SGP_Inst_GetBoardValueXY_HW
-void LineageExp::SGP__Inst_GetBoardValueXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_GetBoardValueXY_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
   const size_t move_x = state.GetLocal(inst.args[0]);
   const size_t move_y = state.GetLocal(inst.args[1]);
-  const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const size_t move = othello_geom_t::GetID(move_x, move_y);
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
   // If inputs are garbage, let the caller know.
-  if (move.IsValid()) {
-    const player_t owner = dreamboard.GetPosOwner({move_x, move_y});
+  if (move != othello_geom_t::INVALID) {
+    const player_t owner = dreamboard.GetPosOwner(othello_idx_t(move));
     if (owner == playerID) { state.SetLocal(inst.args[2], AGENT_VIEW__SELF_ID); }
     else if (owner == oppID) { state.SetLocal(inst.args[2], AGENT_VIEW__OPP_ID); }
     else { state.SetLocal(inst.args[2], AGENT_VIEW__OPEN_ID); }
@@ -374,16 +326,17 @@ void LineageExp::SGP__Inst_GetBoardValueXY_HW(SGP__hardware_t & hw, const SGP__i
   }
 }
 // SGP_Inst_GetBoardValueID_HW
-void LineageExp::SGP__Inst_GetBoardValueID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const size_t move_id = state.GetLocal(inst.args[0]);
-  const othello_idx_t move(GetOthelloIndex(move_id));
-  const player_t playerID = othello_dreamware->GetPlayerID();
+template<typename HW_T>
+void LineageExp::SGP__Inst_GetBoardValueID_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const size_t move = othello_geom_t::ClampID((size_t)state.GetLocal(inst.args[0]));
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
   // If inputs are garbage, let the caller know.
-  if (move.IsValid()) {
-    const player_t owner = dreamboard.GetPosOwner(move_id);
+  if (move != othello_geom_t::INVALID) {
+    const player_t owner = dreamboard.GetPosOwner(othello_idx_t(move));
     if (owner == playerID) { state.SetLocal(inst.args[1], AGENT_VIEW__SELF_ID); }
     else if (owner == oppID) { state.SetLocal(inst.args[1], AGENT_VIEW__OPP_ID); }
     else { state.SetLocal(inst.args[1], AGENT_VIEW__OPEN_ID); }
@@ -392,136 +345,272 @@ void LineageExp::SGP__Inst_GetBoardValueID_HW(SGP__hardware_t & hw, const SGP__i
   }
 }
 // SGP_Inst_PlaceDiskXY_HW
-void LineageExp::SGP__Inst_PlaceDiskXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_PlaceDiskXY_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  if (othello_lookup.IsValidMove(dreamboard, playerID, move)) {
-    dreamboard.DoMove(playerID, move);
+  const player_t playerID = ctx.playerID;
+  if (ctx.lookup->IsValidMove(dreamboard, playerID, move)) {
+    ctx.dreamware->DoActiveMove(playerID, move);
     state.SetLocal(inst.args[2], 1);
   } else {
     state.SetLocal(inst.args[2], 0);
   }
 }
 // SGP_Inst_PlaceDiskID_HW
-void LineageExp::SGP__Inst_PlaceDiskID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_PlaceDiskID_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
   const othello_idx_t move = GetOthelloIndex(state.GetLocal(inst.args[0]));
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  if (othello_lookup.IsValidMove(dreamboard, playerID, move)) {
-    dreamboard.DoMove(playerID, move);
+  const player_t playerID = ctx.playerID;
+  if (ctx.lookup->IsValidMove(dreamboard, playerID, move)) {
+    ctx.dreamware->DoActiveMove(playerID, move);
     state.SetLocal(inst.args[1], 1);
   } else {
     state.SetLocal(inst.args[1], 0);
   }
 }
 // SGP_Inst_PlaceOppDiskXY_HW
-void LineageExp::SGP__Inst_PlaceOppDiskXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_PlaceOppDiskXY_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
-  if (othello_lookup.IsValidMove(dreamboard, oppID, move)) {
-    dreamboard.DoMove(oppID, move);
+  if (ctx.lookup->IsValidMove(dreamboard, oppID, move)) {
+    ctx.dreamware->DoActiveMove(oppID, move);
     state.SetLocal(inst.args[2], 1);
   } else {
     state.SetLocal(inst.args[2], 0);
   }
 }
 // SGP_Inst_PlaceOppDiskID_HW
-void LineageExp::SGP__Inst_PlaceOppDiskID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_PlaceOppDiskID_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
   const othello_idx_t move = GetOthelloIndex(state.GetLocal(inst.args[0]));
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
-  if (othello_lookup.IsValidMove(dreamboard, oppID, move)) {
-    dreamboard.DoMove(oppID, move);
+  if (ctx.lookup->IsValidMove(dreamboard, oppID, move)) {
+    ctx.dreamware->DoActiveMove(oppID, move);
     state.SetLocal(inst.args[1], 1);
   } else {
     state.SetLocal(inst.args[1], 0);
   }
 }
 // SGP_Inst_FlipCntXY_HW
-void LineageExp::SGP__Inst_FlipCntXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_FlipCntXY_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  if (othello_lookup.IsValidMove(dreamboard, playerID, move)) {
-    state.SetLocal(inst.args[2], othello_lookup.GetFlipCount(dreamboard, playerID, move));
+  const player_t playerID = ctx.playerID;
+  if (ctx.lookup->IsValidMove(dreamboard, playerID, move)) {
+    state.SetLocal(inst.args[2], ctx.lookup->GetFlipCount(dreamboard, playerID, move));
   } else {
     state.SetLocal(inst.args[2], 0);
   }
 }
 // SGP_Inst_FlipCntID_HW
-void LineageExp::SGP__Inst_FlipCntID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_FlipCntID_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
   const othello_idx_t move = GetOthelloIndex((size_t)state.GetLocal(inst.args[0]));
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  if (othello_lookup.IsValidMove(dreamboard, playerID, move)) {
-    state.SetLocal(inst.args[1], othello_lookup.GetFlipCount(dreamboard, playerID, move));
+  const player_t playerID = ctx.playerID;
+  if (ctx.lookup->IsValidMove(dreamboard, playerID, move)) {
+    state.SetLocal(inst.args[1], ctx.lookup->GetFlipCount(dreamboard, playerID, move));
   } else {
     state.SetLocal(inst.args[1], 0);
   }
 }
 // SGP_Inst_OppFlipCntXY_HW
-void LineageExp::SGP__Inst_OppFlipCntXY_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_OppFlipCntXY_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
   const size_t move_x = (size_t)state.GetLocal(inst.args[0]);
   const size_t move_y = (size_t)state.GetLocal(inst.args[1]);
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
-  if (othello_lookup.IsValidMove(dreamboard, oppID, move)) {
-    state.SetLocal(inst.args[2], othello_lookup.GetFlipCount(dreamboard, oppID, move));
+  if (ctx.lookup->IsValidMove(dreamboard, oppID, move)) {
+    state.SetLocal(inst.args[2], ctx.lookup->GetFlipCount(dreamboard, oppID, move));
   } else {
     state.SetLocal(inst.args[2], 0);
   }
 }
 // SGP_Inst_OppFlipCntID_HW
-void LineageExp::SGP__Inst_OppFlipCntID_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_OppFlipCntID_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
   const othello_idx_t move = GetOthelloIndex((size_t)state.GetLocal(inst.args[0]));
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
-  if (othello_lookup.IsValidMove(dreamboard, oppID, move)) {
-    state.SetLocal(inst.args[1], othello_lookup.GetFlipCount(dreamboard, oppID, move));
+  if (ctx.lookup->IsValidMove(dreamboard, oppID, move)) {
+    state.SetLocal(inst.args[1], ctx.lookup->GetFlipCount(dreamboard, oppID, move));
   } else {
     state.SetLocal(inst.args[1], 0);
   }
 }
 // SGP_Inst_FrontierCnt_HW
-void LineageExp::SGP__Inst_FrontierCnt_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  state.SetLocal(inst.args[0], othello_lookup.CountFrontierPos(dreamboard, playerID));
+template<typename HW_T>
+void LineageExp::SGP__Inst_FrontierCnt_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  state.SetLocal(inst.args[0], ctx.lookup->CountFrontierPos(dreamboard, playerID));
 }
 // SGP_Inst_ResetBoard_HW
-void LineageExp::SGP__Inst_ResetBoard_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  othello_dreamware->ResetActive(testcases[cur_testcase].GetInput().game);
+template<typename HW_T>
+void LineageExp::SGP__Inst_ResetBoard_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  ctx.dreamware->ResetActive(*ctx.turn_board);
 }
 // SGP_Inst_IsOver_HW
-void LineageExp::SGP__Inst_IsOver_HW(SGP__hardware_t & hw, const SGP__inst_t & inst) {
-  SGP__state_t & state = hw.GetCurState();
-  othello_t & dreamboard = othello_dreamware->GetActiveDreamOthello();
+template<typename HW_T>
+void LineageExp::SGP__Inst_IsOver_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
   state.SetLocal(inst.args[0], (int)dreamboard.IsOver());
 }
+// SGP_Inst_SetActiveDream_HW
+template<typename HW_T>
+void LineageExp::SGP__Inst_SetActiveDream_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  const int dream = emp::Mod((int)state.GetLocal(inst.args[0]), (int)ctx.dreamware->GetDreamCnt());
+  ctx.dreamware->SetActiveDream((size_t)dream);
+  ctx.SyncDreamware();
+}
+// SGP_Inst_PushBoard_HW
+template<typename HW_T>
+void LineageExp::SGP__Inst_PushBoard_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  state.SetLocal(inst.args[0], (int)ctx.dreamware->PushActive());
+}
+// SGP_Inst_PopBoard_HW
+template<typename HW_T>
+void LineageExp::SGP__Inst_PopBoard_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  state.SetLocal(inst.args[0], (int)ctx.dreamware->PopActive());
+}
+// SGP_Inst_DiscCnt_HW
+template<typename HW_T>
+void LineageExp::SGP__Inst_DiscCnt_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  state.SetLocal(inst.args[0], features.GetDiscCnt(playerID));
+}
+// SGP_Inst_OppDiscCnt_HW
+template<typename HW_T>
+void LineageExp::SGP__Inst_OppDiscCnt_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const player_t oppID = dreamboard.GetOpponent(playerID);
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  state.SetLocal(inst.args[0], features.GetDiscCnt(oppID));
+}
+// SGP_Inst_CornerCnt_HW
+template<typename HW_T>
+void LineageExp::SGP__Inst_CornerCnt_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  state.SetLocal(inst.args[0], features.GetCornerCnt(playerID));
+}
+// SGP_Inst_OppCornerCnt_HW
+template<typename HW_T>
+void LineageExp::SGP__Inst_OppCornerCnt_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const player_t oppID = dreamboard.GetOpponent(playerID);
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  state.SetLocal(inst.args[0], features.GetCornerCnt(oppID));
+}
+// SGP_Inst_GreedyMove_HW
+template<typename HW_T>
+void LineageExp::SGP__Inst_GreedyMove_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  const size_t move = features.GetGreedyMove(playerID);
+  state.SetLocal(inst.args[0], (move == OthelloFeatures::NO_MOVE) ? AGENT_VIEW__ILLEGAL_ID : (int)move);
+}
+// SGP_Inst_MobilityDiff_HW
+template<typename HW_T>
+void LineageExp::SGP__Inst_MobilityDiff_HW(HW_T & hw, const SGP__inst_t & inst) {
+  EvalContext & ctx = GetEvalContext(hw);
+  auto & state = hw.GetCurState();
+  othello_t & dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const player_t oppID = dreamboard.GetOpponent(playerID);
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  state.SetLocal(inst.args[0], (int)features.GetMobility(playerID) - (int)features.GetMobility(oppID));
+}
 
 
+// AGP__Inst_If
+// Scope-bypassing instructions: see AGPCompiled_Inst_* (AGPCompiledProgram.h). They use the
+// compiled genome loaded on the eval hardware.
+void LineageExp::AGP__Inst_If(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  AGPCompiled_Inst_If(hw, inst, *GetEvalContext(hw).agp_compiled);
+}
+// AGP__Inst_While
+void LineageExp::AGP__Inst_While(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  AGPCompiled_Inst_While(hw, inst, *GetEvalContext(hw).agp_compiled);
+}
+// AGP__Inst_Countdown
+void LineageExp::AGP__Inst_Countdown(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  AGPCompiled_Inst_Countdown(hw, inst, *GetEvalContext(hw).agp_compiled);
+}
+// AGP__Inst_Break
+void LineageExp::AGP__Inst_Break(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  AGPCompiled_Inst_Break(hw, inst, *GetEvalContext(hw).agp_compiled);
+}
+// AGP__Inst_Define
+void LineageExp::AGP__Inst_Define(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  AGPCompiled_Inst_Define(hw, inst, *GetEvalContext(hw).agp_compiled);
+}
 // AGP_Inst_GetBoardWidth
 void LineageExp::AGP__Inst_GetBoardWidth(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
@@ -562,93 +651,94 @@ void LineageExp::AGP__Inst_GetMoveID(AGP__hardware_t &hw, const AGP__inst_t &ins
 // AGP__Inst_IsValidXY
 void LineageExp::AGP__Inst_IsValidXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
   const size_t move_x = hw.regs[inst.args[0]];
   const size_t move_y = hw.regs[inst.args[1]];
-  const int valid = (int)othello_lookup.IsValidMove(dreamboard, playerID, {move_x, move_y});
+  const int valid = (int)ctx.lookup->IsValidMove(dreamboard, playerID, {move_x, move_y});
   hw.regs[inst.args[2]] = valid;
 }
 // AGP__Inst_IsValidID_HW
 void LineageExp::AGP__Inst_IsValidID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
   const othello_idx_t move = GetOthelloIndex(hw.regs[inst.args[0]]);
-  const int valid = (int)othello_lookup.IsValidMove(dreamboard, playerID, move);
+  const int valid = (int)ctx.lookup->IsValidMove(dreamboard, playerID, move);
   hw.regs[inst.args[1]] = valid;
 }
 // AGP__Inst_IsValidXY
 void LineageExp::AGP__Inst_IsValidOppXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = dreamboard.GetOpponent(othello_dreamware->GetPlayerID());
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = dreamboard.GetOpponent(ctx.playerID);
   const size_t move_x = hw.regs[inst.args[0]];
   const size_t move_y = hw.regs[inst.args[1]];
-  const int valid = (int)othello_lookup.IsValidMove(dreamboard, playerID, {move_x, move_y});
+  const int valid = (int)ctx.lookup->IsValidMove(dreamboard, playerID, {move_x, move_y});
   hw.regs[inst.args[2]] = valid;
 }
 // AGP__Inst_IsValidID_HW
 void LineageExp::AGP__Inst_IsValidOppID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = dreamboard.GetOpponent(othello_dreamware->GetPlayerID());
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = dreamboard.GetOpponent(ctx.playerID);
   const othello_idx_t move = GetOthelloIndex(hw.regs[inst.args[0]]);
-  const int valid = (int)othello_lookup.IsValidMove(dreamboard, playerID, move);
+  const int valid = (int)ctx.lookup->IsValidMove(dreamboard, playerID, move);
   hw.regs[inst.args[1]] = valid;
 }
 // AGP__Inst_AdjacentXY
 void LineageExp::AGP__Inst_AdjacentXY(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
   const size_t move_x = hw.regs[inst.args[0]];
   const size_t move_y = hw.regs[inst.args[1]];
-  const facing_t dir  = IntToFacing(hw.regs[inst.args[2]]);
-  const othello_idx_t neighbor = dreamboard.GetNeighbor({move_x, move_y}, dir);
-  if (!neighbor.IsValid()) {
+  const size_t neighbor = othello_geom_t::GetNeighbor(othello_geom_t::GetID(move_x, move_y), (int)hw.regs[inst.args[2]]);
+  if (neighbor == othello_geom_t::INVALID) {
     hw.regs[inst.args[0]] = AGENT_VIEW__ILLEGAL_ID;
     hw.regs[inst.args[1]] = AGENT_VIEW__ILLEGAL_ID;
   } else {
-    hw.regs[inst.args[0]] = neighbor.x();
-    hw.regs[inst.args[1]] = neighbor.y();
+    hw.regs[inst.args[0]] = othello_geom_t::GetX(neighbor);
+    hw.regs[inst.args[1]] = othello_geom_t::GetY(neighbor);
   }
 }
 // AGP__Inst_AdjacentID
 void LineageExp::AGP__Inst_AdjacentID(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const othello_idx_t move = GetOthelloIndex(hw.regs[inst.args[0]]);
-  const facing_t dir  = IntToFacing(hw.regs[inst.args[1]]);
-  const othello_idx_t neighbor = dreamboard.GetNeighbor(move, dir);
-  hw.regs[inst.args[0]] = (!neighbor.IsValid()) ? AGENT_VIEW__ILLEGAL_ID : neighbor.pos;
+  const size_t move = hw.regs[inst.args[0]];
+  const size_t neighbor = othello_geom_t::GetNeighbor(move, (int)hw.regs[inst.args[1]]);
+  hw.regs[inst.args[0]] = (neighbor == othello_geom_t::INVALID) ? AGENT_VIEW__ILLEGAL_ID : (int)neighbor;
 }
 // AGP_Inst_ValidMoveCnt_HW
 void LineageExp::AGP__Inst_ValidMoveCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  hw.regs[inst.args[0]] = othello_lookup.GetMoveOptions(dreamboard, playerID).size();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  hw.regs[inst.args[0]] = ctx.lookup->GetMoveOptions(dreamboard, playerID).size();
 }
 // AGP_Inst_ValidOppMoveCnt_HW
 void LineageExp::AGP__Inst_ValidOppMoveCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
-  hw.regs[inst.args[0]] = othello_lookup.GetMoveOptions(dreamboard, oppID).size();
+  hw.regs[inst.args[0]] = ctx.lookup->GetMoveOptions(dreamboard, oppID).size();
 }
 // AGP_Inst_GetBoardValueXY_HW
 void LineageExp::AGP__Inst_GetBoardValueXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const size_t move_x = hw.regs[inst.args[0]];
-  const size_t move_y = hw.regs[inst.args[1]];
-  const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const size_t move = othello_geom_t::GetID(hw.regs[inst.args[0]], hw.regs[inst.args[1]]);
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
   // If inputs are garbage, let the caller know.
-  if (move.IsValid()) {
-    const player_t owner = dreamboard.GetPosOwner(move);
+  if (move != othello_geom_t::INVALID) {
+    const player_t owner = dreamboard.GetPosOwner(othello_idx_t(move));
     if (owner == playerID) {
       hw.regs[inst.args[2]] = AGENT_VIEW__SELF_ID;
     } else if (owner == oppID) {
@@ -663,13 +753,14 @@ void LineageExp::AGP__Inst_GetBoardValueXY_HW(AGP__hardware_t &hw, const AGP__in
 // AGP_Inst_GetBoardValueID_HW
 void LineageExp::AGP__Inst_GetBoardValueID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const othello_idx_t move = GetOthelloIndex(hw.regs[inst.args[0]]);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const size_t move = othello_geom_t::ClampID(hw.regs[inst.args[0]]);
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
   // If inputs are garbage, let the caller know.
-  if (move.IsValid()) {
-    const player_t owner = dreamboard.GetPosOwner(move);
+  if (move != othello_geom_t::INVALID) {
+    const player_t owner = dreamboard.GetPosOwner(othello_idx_t(move));
     if (owner == playerID) {
       hw.regs[inst.args[1]] = AGENT_VIEW__SELF_ID;
     } else if (owner == oppID) {
@@ -684,13 +775,14 @@ void LineageExp::AGP__Inst_GetBoardValueID_HW(AGP__hardware_t &hw, const AGP__in
 // AGP_Inst_PlaceDiskXY_HW
 void LineageExp::AGP__Inst_PlaceDiskXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
   const size_t move_x = (size_t)hw.regs[inst.args[0]];
   const size_t move_y = (size_t)hw.regs[inst.args[1]];
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  if (othello_lookup.IsValidMove(dreamboard, playerID, move)) {
-    dreamboard.DoMove(playerID, move);
+  const player_t playerID = ctx.playerID;
+  if (ctx.lookup->IsValidMove(dreamboard, playerID, move)) {
+    ctx.dreamware->DoActiveMove(playerID, move);
     hw.regs[inst.args[2]] = 1;
   } else {
     hw.regs[inst.args[2]] = 0;
@@ -699,11 +791,12 @@ void LineageExp::AGP__Inst_PlaceDiskXY_HW(AGP__hardware_t &hw, const AGP__inst_t
 // AGP_Inst_PlaceDiskID_HW
 void LineageExp::AGP__Inst_PlaceDiskID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
   const othello_idx_t move = GetOthelloIndex(hw.regs[inst.args[0]]);
-  if (othello_lookup.IsValidMove(dreamboard, playerID, move)) {
-    dreamboard.DoMove(playerID, move);
+  if (ctx.lookup->IsValidMove(dreamboard, playerID, move)) {
+    ctx.dreamware->DoActiveMove(playerID, move);
     hw.regs[inst.args[1]] = 1;
   } else {
     hw.regs[inst.args[1]] = 0;
@@ -712,15 +805,16 @@ void LineageExp::AGP__Inst_PlaceDiskID_HW(AGP__hardware_t &hw, const AGP__inst_t
 // AGP_Inst_PlaceOppDiskXY_HW
 void LineageExp::AGP__Inst_PlaceOppDiskXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
   const size_t move_x = (size_t)hw.regs[inst.args[0]];
   const size_t move_y = (size_t)hw.regs[inst.args[1]];
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
-  if (othello_lookup.IsValidMove(dreamboard, oppID, move))
+  if (ctx.lookup->IsValidMove(dreamboard, oppID, move))
   {
-    dreamboard.DoMove(oppID, move);
+    ctx.dreamware->DoActiveMove(oppID, move);
     hw.regs[inst.args[2]] = 1;
   }
   else
@@ -731,13 +825,14 @@ void LineageExp::AGP__Inst_PlaceOppDiskXY_HW(AGP__hardware_t &hw, const AGP__ins
 // AGP_Inst_PlaceOppDiskID_HW
 void LineageExp::AGP__Inst_PlaceOppDiskID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
   const othello_idx_t move = GetOthelloIndex((size_t)hw.regs[inst.args[0]]);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
-  if (othello_lookup.IsValidMove(dreamboard, oppID, move))
+  if (ctx.lookup->IsValidMove(dreamboard, oppID, move))
   {
-    dreamboard.DoMove(oppID, move);
+    ctx.dreamware->DoActiveMove(oppID, move);
     hw.regs[inst.args[1]] = 1;
   }
   else
@@ -748,14 +843,15 @@ void LineageExp::AGP__Inst_PlaceOppDiskID_HW(AGP__hardware_t &hw, const AGP__ins
 // AGP_Inst_FlipCntXY_HW
 void LineageExp::AGP__Inst_FlipCntXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
   const size_t move_x = (size_t)hw.regs[inst.args[0]];
   const size_t move_y = (size_t)hw.regs[inst.args[1]];
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  if (othello_lookup.IsValidMove(dreamboard, playerID, move))
+  const player_t playerID = ctx.playerID;
+  if (ctx.lookup->IsValidMove(dreamboard, playerID, move))
   {
-    hw.regs[inst.args[2]] = othello_lookup.GetFlipCount(dreamboard, playerID, move);
+    hw.regs[inst.args[2]] = ctx.lookup->GetFlipCount(dreamboard, playerID, move);
   }
   else
   {
@@ -765,12 +861,13 @@ void LineageExp::AGP__Inst_FlipCntXY_HW(AGP__hardware_t &hw, const AGP__inst_t &
 // AGP_Inst_FlipCntID_HW
 void LineageExp::AGP__Inst_FlipCntID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
   const othello_idx_t move = GetOthelloIndex((size_t)hw.regs[inst.args[0]]);
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  if (othello_lookup.IsValidMove(dreamboard, playerID, move))
+  const player_t playerID = ctx.playerID;
+  if (ctx.lookup->IsValidMove(dreamboard, playerID, move))
   {
-    hw.regs[inst.args[1]] = othello_lookup.GetFlipCount(dreamboard, playerID, move);
+    hw.regs[inst.args[1]] = ctx.lookup->GetFlipCount(dreamboard, playerID, move);
   }
   else
   {
@@ -780,15 +877,16 @@ void LineageExp::AGP__Inst_FlipCntID_HW(AGP__hardware_t &hw, const AGP__inst_t &
 // AGP_Inst_OppFlipCntXY_HW
 void LineageExp::AGP__Inst_OppFlipCntXY_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
   const size_t move_x = (size_t)hw.regs[inst.args[0]];
   const size_t move_y = (size_t)hw.regs[inst.args[1]];
   const othello_idx_t move(move_x, move_y);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
-  if (othello_lookup.IsValidMove(dreamboard, oppID, move))
+  if (ctx.lookup->IsValidMove(dreamboard, oppID, move))
   {
-    hw.regs[inst.args[2]] = othello_lookup.GetFlipCount(dreamboard, oppID, move);
+    hw.regs[inst.args[2]] = ctx.lookup->GetFlipCount(dreamboard, oppID, move);
   }
   else
   {
@@ -798,13 +896,14 @@ void LineageExp::AGP__Inst_OppFlipCntXY_HW(AGP__hardware_t &hw, const AGP__inst_
 // AGP_Inst_OppFlipCntID_HW
 void LineageExp::AGP__Inst_OppFlipCntID_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
   const othello_idx_t move = GetOthelloIndex((size_t)hw.regs[inst.args[0]]);
-  const player_t playerID = othello_dreamware->GetPlayerID();
+  const player_t playerID = ctx.playerID;
   const player_t oppID = dreamboard.GetOpponent(playerID);
-  if (othello_lookup.IsValidMove(dreamboard, oppID, move))
+  if (ctx.lookup->IsValidMove(dreamboard, oppID, move))
   {
-    hw.regs[inst.args[1]] = othello_lookup.GetFlipCount(dreamboard, oppID, move);
+    hw.regs[inst.args[1]] = ctx.lookup->GetFlipCount(dreamboard, oppID, move);
   }
   else
   {
@@ -814,20 +913,101 @@ void LineageExp::AGP__Inst_OppFlipCntID_HW(AGP__hardware_t &hw, const AGP__inst_
 // AGP_Inst_FrontierCnt_HW
 void LineageExp::AGP__Inst_FrontierCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
-  const player_t playerID = othello_dreamware->GetPlayerID();
-  hw.regs[inst.args[0]] = othello_lookup.CountFrontierPos(dreamboard, playerID);
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  hw.regs[inst.args[0]] = ctx.lookup->CountFrontierPos(dreamboard, playerID);
 }
 // AGP_Inst_ResetBoard_HW
 void LineageExp::AGP__Inst_ResetBoard_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_dreamware->ResetActive(testcases[cur_testcase].GetInput().game);
+  EvalContext & ctx = GetEvalContext(hw);
+  ctx.dreamware->ResetActive(*ctx.turn_board);
 }
 // AGP_Inst_IsOver_HW
 void LineageExp::AGP__Inst_IsOver_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
 {
-  othello_t &dreamboard = othello_dreamware->GetActiveDreamOthello();
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
   hw.regs[inst.args[0]] = (int)dreamboard.IsOver();
 }
+// AGP_Inst_SetActiveDream_HW
+void LineageExp::AGP__Inst_SetActiveDream_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  EvalContext & ctx = GetEvalContext(hw);
+  const int dream = emp::Mod((int)hw.regs[inst.args[0]], (int)ctx.dreamware->GetDreamCnt());
+  ctx.dreamware->SetActiveDream((size_t)dream);
+  ctx.SyncDreamware();
+}
+// AGP_Inst_PushBoard_HW
+void LineageExp::AGP__Inst_PushBoard_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  EvalContext & ctx = GetEvalContext(hw);
+  hw.regs[inst.args[0]] = (int)ctx.dreamware->PushActive();
+}
+// AGP_Inst_PopBoard_HW
+void LineageExp::AGP__Inst_PopBoard_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  EvalContext & ctx = GetEvalContext(hw);
+  hw.regs[inst.args[0]] = (int)ctx.dreamware->PopActive();
+}
+// AGP_Inst_DiscCnt_HW
+void LineageExp::AGP__Inst_DiscCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  hw.regs[inst.args[0]] = features.GetDiscCnt(playerID);
+}
+// AGP_Inst_OppDiscCnt_HW
+void LineageExp::AGP__Inst_OppDiscCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const player_t oppID = dreamboard.GetOpponent(playerID);
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  hw.regs[inst.args[0]] = features.GetDiscCnt(oppID);
+}
+// AGP_Inst_CornerCnt_HW
+void LineageExp::AGP__Inst_CornerCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  hw.regs[inst.args[0]] = features.GetCornerCnt(playerID);
+}
+// AGP_Inst_OppCornerCnt_HW
+void LineageExp::AGP__Inst_OppCornerCnt_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const player_t oppID = dreamboard.GetOpponent(playerID);
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  hw.regs[inst.args[0]] = features.GetCornerCnt(oppID);
+}
+// AGP_Inst_GreedyMove_HW
+void LineageExp::AGP__Inst_GreedyMove_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  const size_t move = features.GetGreedyMove(playerID);
+  hw.regs[inst.args[0]] = (move == OthelloFeatures::NO_MOVE) ? AGENT_VIEW__ILLEGAL_ID : (int)move;
+}
+// AGP_Inst_MobilityDiff_HW
+void LineageExp::AGP__Inst_MobilityDiff_HW(AGP__hardware_t &hw, const AGP__inst_t &inst)
+{
+  EvalContext & ctx = GetEvalContext(hw);
+  othello_t &dreamboard = *ctx.board;
+  const player_t playerID = ctx.playerID;
+  const player_t oppID = dreamboard.GetOpponent(playerID);
+  const OthelloFeatures & features = ctx.lookup->GetFeatures(dreamboard);
+  hw.regs[inst.args[0]] = (int)features.GetMobility(playerID) - (int)features.GetMobility(oppID);
+}
 
 #endif
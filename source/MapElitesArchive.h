@@ -0,0 +1,144 @@
+#ifndef MAP_ELITES_ARCHIVE_H
+#define MAP_ELITES_ARCHIVE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "base/vector.h"
+
+/// MAP-Elites archive: a dense, fixed-size grid over phenotype descriptors (one axis per
+/// descriptor, each split into equal-width bins). Each cell holds at most one elite: its fitness,
+/// its descriptors, and its position in the population (elites live in the population; the archive
+/// only indexes them). All storage is allocated by Reset, so Insert and lookups are O(1) and never
+/// allocate. Occupied cells are also kept in a list, so a uniformly random elite is O(1) too.
+class MapElitesArchive {
+public:
+  static constexpr size_t NO_SLOT = (size_t)-1;
+  static constexpr uint32_t BINARY_MAGIC = 0x4550414D; ///< "MAPE" (little-endian).
+  static constexpr uint32_t BINARY_VERSION = 1;
+
+protected:
+  emp::vector<size_t> bins;       ///< Bins by axis.
+  emp::vector<double> mins;       ///< Descriptor range by axis.
+  emp::vector<double> maxs;
+  emp::vector<size_t> strides;    ///< Cell index = sum(bin[axis] * strides[axis]).
+  size_t num_cells;
+
+  emp::vector<double> fitness;      ///< By cell.
+  emp::vector<size_t> elite_pos;    ///< By cell: elite's position in the population.
+  emp::vector<double> descriptors;  ///< [cell * num_dims + axis]
+  emp::vector<size_t> cell_slot;    ///< By cell: index in occupied (NO_SLOT if empty).
+  emp::vector<size_t> occupied;     ///< Occupied cells, in the order they were first filled.
+
+public:
+  MapElitesArchive() : num_cells(1) { ; }
+
+  size_t GetNumDims() const { return bins.size(); }
+  size_t GetNumCells() const { return num_cells; }
+  size_t GetNumOccupied() const { return occupied.size(); }
+  size_t GetOccupiedCell(size_t i) const { return occupied[i]; }
+  bool IsOccupied(size_t cell) const { return cell_slot[cell] != NO_SLOT; }
+  double GetFitness(size_t cell) const { return fitness[cell]; }
+  size_t GetElitePos(size_t cell) const { return elite_pos[cell]; }
+  const double * GetDescriptors(size_t cell) const { return descriptors.data() + cell * GetNumDims(); }
+
+  /// Elites move when the population turns over; keep their positions up to date.
+  void SetElitePos(size_t cell, size_t pos) { emp_assert(IsOccupied(cell)); elite_pos[cell] = pos; }
+
+  /// Add a descriptor axis: [min, max] in bin_cnt equal bins (values outside go in the edge bins).
+  /// Call Reset once all axes are added.
+  void AddAxis(double min, double max, size_t bin_cnt) {
+    emp_assert(bin_cnt > 0 && max > min, bin_cnt, min, max);
+    bins.emplace_back(bin_cnt);
+    mins.emplace_back(min);
+    maxs.emplace_back(max);
+  }
+
+  /// Empty the archive, and (re)allocate its storage for the current axes.
+  void Reset() {
+    strides.resize(bins.size());
+    num_cells = 1;
+    for (size_t axis = bins.size(); axis-- > 0;) {
+      strides[axis] = num_cells;
+      num_cells *= bins[axis];
+    }
+    fitness.assign(num_cells, 0.0);
+    elite_pos.assign(num_cells, 0);
+    descriptors.assign(num_cells * bins.size(), 0.0);
+    cell_slot.assign(num_cells, (size_t)NO_SLOT); // (Copy: NO_SLOT has no out-of-class definition.)
+    occupied.clear();
+    occupied.reserve(num_cells);
+  }
+
+  size_t GetBin(size_t axis, double value) const {
+    const double frac = (value - mins[axis]) / (maxs[axis] - mins[axis]);
+    if (!(frac > 0.0)) return 0; // (Also catches NaN.)
+    return std::min((size_t)(frac * (double)bins[axis]), bins[axis] - 1);
+  }
+
+  /// Cell for descriptors desc (one value per axis).
+  size_t GetCell(const double * desc) const {
+    size_t cell = 0;
+    for (size_t axis = 0; axis < bins.size(); ++axis) cell += GetBin(axis, desc[axis]) * strides[axis];
+    return cell;
+  }
+
+  /// Offer the organism at pos (with descriptors desc): it becomes its cell's elite if the cell is
+  /// empty or it's strictly fitter than the current elite. Returns whether it was placed.
+  bool Insert(const double * desc, double fit, size_t pos) {
+    const size_t cell = GetCell(desc);
+    if (IsOccupied(cell)) {
+      if (!(fit > fitness[cell])) return false;
+    } else {
+      cell_slot[cell] = occupied.size();
+      occupied.emplace_back(cell);
+    }
+    fitness[cell] = fit;
+    elite_pos[cell] = pos;
+    std::copy(desc, desc + GetNumDims(), descriptors.begin() + cell * GetNumDims());
+    return true;
+  }
+
+  /// Write the archive in binary (native byte order):
+  ///   uint32 magic ("MAPE"), uint32 version, uint64 update, uint32 num_dims,
+  ///   num_dims x {uint32 bins, double min, double max}, uint64 num_occupied,
+  ///   num_occupied x {uint64 cell, double fitness, num_dims x double descriptor} (by cell index).
+  /// Prints a message and returns false on failure.
+  bool WriteBinary(const std::string & fpath, size_t update) const {
+    std::ofstream os(fpath, std::ios::binary);
+    if (!os) {
+      std::cout << "Failed to open MAP-Elites archive file (" << fpath << ")." << std::endl;
+      return false;
+    }
+    auto write_u32 = [&os](uint32_t val) { os.write(reinterpret_cast<const char *>(&val), sizeof(val)); };
+    auto write_u64 = [&os](uint64_t val) { os.write(reinterpret_cast<const char *>(&val), sizeof(val)); };
+    auto write_dbl = [&os](double val) { os.write(reinterpret_cast<const char *>(&val), sizeof(val)); };
+    write_u32(BINARY_MAGIC);
+    write_u32(BINARY_VERSION);
+    write_u64(update);
+    write_u32((uint32_t)GetNumDims());
+    for (size_t axis = 0; axis < GetNumDims(); ++axis) {
+      write_u32((uint32_t)bins[axis]);
+      write_dbl(mins[axis]);
+      write_dbl(maxs[axis]);
+    }
+    write_u64(occupied.size());
+    for (size_t cell = 0; cell < num_cells; ++cell) {
+      if (!IsOccupied(cell)) continue;
+      write_u64(cell);
+      write_dbl(fitness[cell]);
+      os.write(reinterpret_cast<const char *>(GetDescriptors(cell)), sizeof(double) * GetNumDims());
+    }
+    if (!os) {
+      std::cout << "Failed to write MAP-Elites archive file (" << fpath << ")." << std::endl;
+      return false;
+    }
+    return true;
+  }
+};
+
+#endif
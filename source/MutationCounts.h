@@ -0,0 +1,83 @@
+#ifndef MUTATION_COUNTS_H
+#define MUTATION_COUNTS_H
+
+#include <array>
+#include <functional>
+#include <string>
+
+#include "base/Ptr.h"
+#include "base/vector.h"
+#include "Evolve/SystematicsAnalysis.h"
+
+/// Mutation bookkeeping with mutation types identified by index (0 to NUM_TYPES-1) instead of by
+/// name: counts are a fixed-size array (cheap to increment and to copy into every new genotype).
+/// Names (e.g. MUTATION_TYPES[i]) only come into it when writing output.
+template<size_t NUM_TYPES>
+using mut_counts_t = std::array<double, NUM_TYPES>;
+
+/// Genotype data: emp::mut_landscape_info (phenotype, fitness) with array-based mutation counts.
+/// (The base class's string-keyed mut_counts map is left empty.)
+template<typename PHEN_T, size_t NUM_TYPES>
+struct MutCountData : emp::mut_landscape_info<PHEN_T> {
+  mut_counts_t<NUM_TYPES> mut_array = {};
+
+  void RecordMutation(const mut_counts_t<NUM_TYPES> & muts) { mut_array = muts; }
+};
+
+/// Sum of mutations of type along taxon's lineage.
+template<typename TAXON_T>
+double CountLineageMuts(emp::Ptr<TAXON_T> taxon, size_t type) {
+  double count = 0;
+  while (taxon) {
+    count += taxon->GetData().mut_array[type];
+    taxon = taxon->GetParent();
+  }
+  return count;
+}
+
+/// Number of steps along taxon's lineage that involved a mutation of any of the given types.
+template<typename TAXON_T>
+int CountLineageMutSteps(emp::Ptr<TAXON_T> taxon, const emp::vector<size_t> & types) {
+  int count = 0;
+  while (taxon) {
+    for (size_t type : types) {
+      if (taxon->GetData().mut_array[type] > 0) { ++count; break; }
+    }
+    taxon = taxon->GetParent();
+  }
+  return count;
+}
+
+/// Setup a data_file with world that records mutations along the lineage of the organism in
+/// position 0 (array-based counterpart to emp::AddLineageMutationFile).
+/// mut_types[i] is the name of mutation type i.
+template <typename WORLD_TYPE>
+emp::DataFile & AddLineageMutationCountFile(WORLD_TYPE & world, const std::string & fpath, const emp::vector<std::string> & mut_types) {
+  auto & file = world.SetupFile(fpath);
+
+  std::function<size_t(void)> get_update = [&world](){return world.GetUpdate();};
+  file.AddFun(get_update, "update", "Update");
+
+  for (size_t i = 0; i < mut_types.size(); ++i) {
+    const std::string & mut_type = mut_types[i];
+    std::function<int(void)> mut_fun = [&world, i]() { return (int)CountLineageMuts(world.GetGenotypeAt(0), i); };
+    file.AddFun(mut_fun, "dominant_"+mut_type+"_mutation_count", "sum of "+mut_type+" mutations along dominant organism's lineage");
+  }
+
+  std::function<int(void)> dom_del_step = [&world](){
+    return emp::CountDeleteriousSteps(world.GetGenotypeAt(0));
+  };
+  std::function<size_t(void)> dom_phen_vol = [&world](){
+    return emp::CountPhenotypeChanges(world.GetGenotypeAt(0));
+  };
+  std::function<size_t(void)> dom_unique_phen = [&world](){
+    return emp::CountUniquePhenotypes(world.GetGenotypeAt(0));
+  };
+  file.AddFun(dom_del_step, "dominant_deleterious_steps", "count of deleterious steps along dominant organism's lineage");
+  file.AddFun(dom_phen_vol, "dominant_phenotypic_volatility", "count of changes in phenotype along dominant organism's lineage");
+  file.AddFun(dom_unique_phen, "dominant_unique_phenotypes", "count of unique phenotypes along dominant organism's lineage");
+  file.PrintHeaderKeys();
+  return file;
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef OTHELLO_FEATURES_H
+#define OTHELLO_FEATURES_H
+
+#include "base/vector.h"
+#include "games/Othello8.h"
+
+#include "OthelloGeometry.h"
+
+/// Whole-board summary statistics (for both players) that agents can query in a single step.
+/// Computed once per board: OthelloLookup keeps one per cached board; without the lookup table,
+/// they're computed directly from the board.
+struct OthelloFeatures {
+  using othello_t = emp::Othello8;
+  using idx_t = othello_t::Index;
+  using player_t = othello_t::Player;
+  using geom_t = OthelloGeometry<8>;
+
+  static constexpr size_t NO_MOVE = geom_t::NUM_CELLS; ///< greedy_move value if player has no moves.
+
+  size_t dark_disc_cnt = 0;
+  size_t light_disc_cnt = 0;
+  size_t dark_corner_cnt = 0;
+  size_t light_corner_cnt = 0;
+  size_t dark_mobility = 0;   ///< Number of valid moves.
+  size_t light_mobility = 0;
+  size_t dark_greedy_move = NO_MOVE;  ///< Valid move that flips the most disks (lowest position on ties).
+  size_t light_greedy_move = NO_MOVE;
+
+  static bool IsCorner(size_t pos) {
+    return pos == geom_t::GetID(0, 0) || pos == geom_t::GetID(7, 0)
+        || pos == geom_t::GetID(0, 7) || pos == geom_t::GetID(7, 7);
+  }
+
+  /// Compute features given a board, and a way of getting each player's move options and flip
+  /// counts (so OthelloLookup can reuse what it already has cached).
+  template<typename MOVES_FUN, typename FLIP_CNT_FUN>
+  void Compute(othello_t & othello, MOVES_FUN && get_moves, FLIP_CNT_FUN && get_flip_cnt) {
+    dark_disc_cnt = light_disc_cnt = dark_corner_cnt = light_corner_cnt = 0;
+    for (size_t pos = 0; pos < geom_t::NUM_CELLS; ++pos) {
+      const player_t owner = othello.GetPosOwner(pos);
+      if (owner == player_t::DARK) {
+        ++dark_disc_cnt;
+        if (IsCorner(pos)) ++dark_corner_cnt;
+      } else if (owner == player_t::LIGHT) {
+        ++light_disc_cnt;
+        if (IsCorner(pos)) ++light_corner_cnt;
+      }
+    }
+    ComputeMoves(player_t::DARK, get_moves(player_t::DARK), get_flip_cnt, dark_mobility, dark_greedy_move);
+    ComputeMoves(player_t::LIGHT, get_moves(player_t::LIGHT), get_flip_cnt, light_mobility, light_greedy_move);
+  }
+
+  /// Compute features straight from the board.
+  void Compute(othello_t & othello) {
+    Compute(othello,
+            [&othello](player_t player) { return othello.GetMoveOptions(player); },
+            [&othello](player_t player, idx_t pos) { return othello.GetFlipList(player, pos).size(); });
+  }
+
+  size_t GetDiscCnt(player_t player) const { return (player == player_t::DARK) ? dark_disc_cnt : light_disc_cnt; }
+  size_t GetCornerCnt(player_t player) const { return (player == player_t::DARK) ? dark_corner_cnt : light_corner_cnt; }
+  size_t GetMobility(player_t player) const { return (player == player_t::DARK) ? dark_mobility : light_mobility; }
+  size_t GetGreedyMove(player_t player) const { return (player == player_t::DARK) ? dark_greedy_move : light_greedy_move; }
+
+protected:
+  template<typename FLIP_CNT_FUN>
+  static void ComputeMoves(player_t player, const emp::vector<idx_t> & moves, FLIP_CNT_FUN && get_flip_cnt,
+                           size_t & mobility, size_t & greedy_move) {
+    mobility = moves.size();
+    greedy_move = NO_MOVE;
+    size_t best_flips = 0;
+    for (size_t i = 0; i < moves.size(); ++i) {
+      const size_t flips = get_flip_cnt(player, moves[i]);
+      if (greedy_move == NO_MOVE || flips > best_flips || (flips == best_flips && moves[i].pos < greedy_move)) {
+        greedy_move = moves[i].pos;
+        best_flips = flips;
+      }
+    }
+  }
+};
+
+#endif
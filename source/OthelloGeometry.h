@@ -0,0 +1,66 @@
+#ifndef OTHELLO_GEOMETRY_H
+#define OTHELLO_GEOMETRY_H
+
+#include <stddef.h>
+
+/// Board geometry (XY <=> ID conversions, neighbors) for a WIDTH x WIDTH Othello board,
+/// built at compile time. Positions are IDs in [0, NUM_CELLS); INVALID (= NUM_CELLS) stands in
+/// for anything off the board (and is a valid table row, so invalid positions can be chained).
+/// Directions are numbered as emp::Othello8's Facing: N, NE, E, SE, S, SW, W, NW.
+template<size_t WIDTH>
+class OthelloGeometry {
+public:
+  static constexpr size_t NUM_CELLS = WIDTH * WIDTH;
+  static constexpr size_t NUM_DIRECTIONS = 8;
+  static constexpr size_t INVALID = NUM_CELLS;
+
+protected:
+  struct Tables {
+    size_t neighbors[NUM_CELLS + 1][NUM_DIRECTIONS]; ///< [pos][dir] => neighboring position.
+    size_t x[NUM_CELLS + 1];                          ///< [pos] => x
+    size_t y[NUM_CELLS + 1];                          ///< [pos] => y
+
+    constexpr Tables() : neighbors(), x(), y() {
+      const int dx[NUM_DIRECTIONS] = { 0,  1, 1, 1, 0, -1, -1, -1};
+      const int dy[NUM_DIRECTIONS] = {-1, -1, 0, 1, 1,  1,  0, -1};
+      for (size_t pos = 0; pos < NUM_CELLS; ++pos) {
+        x[pos] = pos % WIDTH;
+        y[pos] = pos / WIDTH;
+        for (size_t dir = 0; dir < NUM_DIRECTIONS; ++dir) {
+          const int nx = (int)x[pos] + dx[dir];
+          const int ny = (int)y[pos] + dy[dir];
+          const bool on_board = nx >= 0 && ny >= 0 && nx < (int)WIDTH && ny < (int)WIDTH;
+          neighbors[pos][dir] = on_board ? (size_t)ny * WIDTH + (size_t)nx : INVALID;
+        }
+      }
+      x[INVALID] = INVALID;
+      y[INVALID] = INVALID;
+      for (size_t dir = 0; dir < NUM_DIRECTIONS; ++dir) neighbors[INVALID][dir] = INVALID;
+    }
+  };
+
+  static constexpr Tables tables{};
+
+public:
+  /// Position ID of (x, y) (INVALID if off the board).
+  static constexpr size_t GetID(size_t x, size_t y) {
+    return (x < WIDTH && y < WIDTH) ? y * WIDTH + x : INVALID;
+  }
+  /// Clamp any position to [0, INVALID].
+  static constexpr size_t ClampID(size_t pos) { return (pos > INVALID) ? INVALID : pos; }
+
+  static size_t GetX(size_t pos) { return tables.x[ClampID(pos)]; }
+  static size_t GetY(size_t pos) { return tables.y[ClampID(pos)]; }
+
+  /// Neighbor of pos in direction dir (any int; taken mod NUM_DIRECTIONS).
+  static size_t GetNeighbor(size_t pos, int dir) {
+    int d = dir % (int)NUM_DIRECTIONS;
+    if (d < 0) d += (int)NUM_DIRECTIONS;
+    return tables.neighbors[ClampID(pos)][d];
+  }
+};
+
+template<size_t WIDTH>
+constexpr typename OthelloGeometry<WIDTH>::Tables OthelloGeometry<WIDTH>::tables;
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef OTHELLO_HW_H
 #define OTHELLO_HW_H
 
+#include "base/Ptr.h"
 #include "base/vector.h"
 #include "games/Othello8.h"
 #include "tools/random_utils.h"
@@ -8,21 +9,70 @@
 #include "tools/string_utils.h"
 
 // NOTE: we don't actually need this for test case evaluations...
+/// Dream boards are copy-on-first-use: resetting to a board only remembers which board to start
+/// from (the turn root). A dream is copied from the root the first time it's accessed, so agents
+/// with several dream boards only pay for the ones their programs actually switch to.
+///
+/// Each dream also has a checkpoint stack. While a checkpoint is open, moves made through
+/// DoActiveMove are logged as (placed square, flip mask) diffs, so popping a checkpoint
+/// undoes moves in place instead of resetting and replaying the dream.
 class OthelloHardware {
+public:
+  static constexpr size_t MAX_CHECKPOINTS = 64; ///< Max open checkpoints per dream.
 
 protected:
   using othello_t = emp::Othello8;
   using player_t = othello_t::Player;
+  using idx_t = othello_t::Index;
+
+  /// One logged move.
+  struct MoveDiff {
+    uint64_t placed; ///< Bit of the square the disk was placed on.
+    uint64_t flips;  ///< Bits of the disks that were flipped.
+  };
+
+  /// Undo log for one dream.
+  struct DreamLog {
+    emp::vector<MoveDiff> moves;     ///< Moves made since the oldest open checkpoint.
+    emp::vector<size_t> checkpoints; ///< Open checkpoints (positions in moves).
+
+    void Clear() { moves.clear(); checkpoints.clear(); }
+  };
+
   emp::vector<othello_t> dreams; ///< Let's lean into that whole 'othello dream' terminology...
+  emp::vector<size_t> dream_stamps; ///< Dream i is materialized iff dream_stamps[i] == cur_stamp.
+  emp::vector<DreamLog> dream_logs;
+  size_t cur_stamp;
+  emp::Ptr<const othello_t> root; ///< Board unmaterialized dreams start from (nullptr => fresh game).
   size_t active_dream;
   player_t playerID;
 
+  /// Make sure dream id has been copied from the root since the last reset.
+  othello_t & Materialize(size_t id) {
+    emp_assert(id < dreams.size());
+    if (dream_stamps[id] != cur_stamp) {
+      dreams[id].Reset();
+      if (root != nullptr) dreams[id].SetBoard(root->GetBoard());
+      dream_stamps[id] = cur_stamp;
+      dream_logs[id].Clear();
+    }
+    return dreams[id];
+  }
+
+  /// Forget all materialized dreams (O(1)).
+  void Invalidate() { ++cur_stamp; }
+
 public:
   OthelloHardware(size_t dream_cnt, player_t pID=player_t::DARK)
-  : dreams(dream_cnt), active_dream(0), playerID(pID)
+  : dreams(dream_cnt), dream_stamps(dream_cnt, 0), dream_logs(dream_cnt), cur_stamp(1), root(nullptr),
+    active_dream(0), playerID(pID)
   { emp_assert(dream_cnt > 0); }
 
-  othello_t & GetActiveDreamOthello() { return dreams[active_dream]; }
+  size_t GetDreamCnt() const { return dreams.size(); }
+  size_t GetActiveDream() const { return active_dream; }
+  bool IsMaterialized(size_t id) const { return dream_stamps[id] == cur_stamp; }
+
+  othello_t & GetActiveDreamOthello() { return Materialize(active_dream); }
 
   void SetActiveDream(size_t id) {
     emp_assert(id < dreams.size());
@@ -33,26 +83,85 @@ public:
   player_t GetPlayerID() const { return playerID; }
 
   void Reset() {
-    for (size_t i = 0; i < dreams.size(); ++i) dreams[i].Reset();
+    root = nullptr;
+    Invalidate();
   }
 
+  /// Reset all dreams to other's board. Dreams are copied lazily, so other must stay alive
+  /// (and unchanged) until the next Reset.
   void Reset(const othello_t & other) {
-    for (size_t i = 0; i < dreams.size(); ++i) {
-      dreams[i].Reset();
-      dreams[i].SetBoard(other.GetBoard());
-    }
+    root = &other;
+    Invalidate();
   }
 
   void ResetActive() {
     dreams[active_dream].Reset();
+    dream_stamps[active_dream] = cur_stamp;
+    dream_logs[active_dream].Clear();
   }
 
   void ResetActive(const othello_t & other) {
     dreams[active_dream].Reset();
     dreams[active_dream].SetBoard(other.GetBoard());
+    dream_stamps[active_dream] = cur_stamp;
+    dream_logs[active_dream].Clear();
   }
 
-};
+  /// Make a move on the active dream (logging it if there are open checkpoints).
+  /// Move validity is the caller's responsibility (same as othello_t::DoMove).
+  void DoActiveMove(player_t player, idx_t move) {
+    othello_t & dream = Materialize(active_dream);
+    DreamLog & log = dream_logs[active_dream];
+    if (log.checkpoints.empty()) {
+      dream.DoMove(player, move);
+      return;
+    }
+    const uint64_t pre_occupied = dream.GetBoard().occupied;
+    const uint64_t pre_player = dream.GetBoard().player;
+    dream.DoMove(player, move);
+    const uint64_t placed = dream.GetBoard().occupied & ~pre_occupied;
+    const uint64_t flips = (dream.GetBoard().player ^ pre_player) & pre_occupied;
+    log.moves.emplace_back(MoveDiff{placed, flips});
+  }
 
+  /// Open a checkpoint on the active dream. Returns false if too many are already open.
+  bool PushActive() {
+    Materialize(active_dream);
+    DreamLog & log = dream_logs[active_dream];
+    if (log.checkpoints.size() >= MAX_CHECKPOINTS) return false;
+    log.checkpoints.emplace_back(log.moves.size());
+    return true;
+  }
+
+  /// Undo all moves made on the active dream since its most recent checkpoint, and close that
+  /// checkpoint. Returns false if there's no open checkpoint.
+  /// Like ResetActive, this restores the board's disks (othello_t's turn bookkeeping is reset).
+  bool PopActive() {
+    othello_t & dream = Materialize(active_dream);
+    DreamLog & log = dream_logs[active_dream];
+    if (log.checkpoints.empty()) return false;
+    const size_t mark = log.checkpoints.back();
+    log.checkpoints.pop_back();
+    if (log.moves.size() == mark) return true;
+    auto board = dream.GetBoard();
+    while (log.moves.size() > mark) {
+      const MoveDiff & diff = log.moves.back();
+      board.occupied &= ~diff.placed;
+      board.player &= ~diff.placed;
+      board.player ^= diff.flips;
+      log.moves.pop_back();
+    }
+    dream.Reset();
+    dream.SetBoard(board);
+    return true;
+  }
+
+  /// (A dream that hasn't been touched since the last reset has no checkpoints, whatever its stale
+  /// log says.)
+  size_t GetActiveCheckpointCnt() const {
+    return IsMaterialized(active_dream) ? dream_logs[active_dream].checkpoints.size() : 0;
+  }
+
+};
 
 #endif
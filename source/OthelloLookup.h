@@ -7,6 +7,8 @@
 #include "games/Othello8.h"
 #include "tools/map_utils.h"
 
+#include "OthelloFeatures.h"
+
 
 class OthelloLookup {
   using othello_t = emp::Othello8;
@@ -26,6 +28,8 @@ public:
     emp::vector<idx_t> light_move_options;
     emp::vector<char> light_is_valid_move_by_pos;
 
+    bool has_features = false;  ///< Features are only computed if someone asks for them.
+    OthelloFeatures features;
 
     size_t GetFrontierCnt(player_t player) {
       return (player == player_t::DARK) ? dark_frontier_cnt : light_frontier_cnt;
@@ -149,6 +153,21 @@ public:
     return othello.IsValidMove(player, index);
   }
 
+  // GetFeatures
+  const OthelloFeatures & GetFeatures(othello_t & othello) {
+    const uint64_t o = othello.GetBoard().occupied;
+    const uint64_t p = othello.GetBoard().player;
+    if (!emp::Has(lookup, o) || !emp::Has(lookup[o], p)) CacheBoard(othello);
+    OthelloInfo & info = lookup[o][p];
+    if (!info.has_features) {
+      info.features.Compute(othello,
+        [&info](player_t player) -> const emp::vector<idx_t> & { return info.GetMoveOptions(player); },
+        [&info](player_t player, idx_t index) { return info.GetFlipList(player, index).size(); });
+      info.has_features = true;
+    }
+    return info.features;
+  }
+
 };
 
 
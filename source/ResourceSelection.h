@@ -0,0 +1,131 @@
+#ifndef RESOURCE_SELECTION_H
+#define RESOURCE_SELECTION_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/vector.h"
+#include "Evolve/Resource.h"
+#include "tools/math.h"
+
+/// Eco-EA resource selection over a population x resource score matrix (stand-in for
+/// emp::ResourceSelect with one fitness function per resource). Scores are filled in once per
+/// generation (e.g. right after evaluation) instead of being recomputed by std::function calls.
+/// - Scores are stored by organism (row): all of an organism's resource scores are contiguous, so
+///   its consumption of every resource is one branch-free pass over dense arrays (the resource
+///   amounts are mirrored in a plain array for the duration).
+/// - Each resource's inflow share (inflow / number of organisms) is computed once per generation.
+/// - Resource-adjusted fitness is computed once, then tournaments read it from an array.
+/// Consumption, bonuses, and tournaments follow emp::ResourceSelect step for step (same order of
+/// floating point operations, same random number draws), so results are identical.
+class ResourceSelector {
+protected:
+  size_t pop_size;
+  size_t num_resources;
+  emp::vector<double> scores;     ///< [orgID * num_resources + resID]
+  emp::vector<double> sq_scores;  ///< Scratch: squared scores (same layout).
+  emp::vector<double> amounts;    ///< Scratch: resource amounts during consumption.
+  emp::vector<double> inflows;    ///< Scratch: inflow per organism, by resource.
+  emp::vector<double> bonuses;    ///< Scratch: one organism's bonus from each resource.
+  emp::vector<double> fitness;    ///< Resource-adjusted fitness by position.
+
+public:
+  ResourceSelector() : pop_size(0), num_resources(0) { ; }
+
+  size_t GetPopSize() const { return pop_size; }
+  size_t GetNumResources() const { return num_resources; }
+
+  /// Set matrix dimensions (keeps storage for reuse). Scores must be (re)filled afterwards.
+  void Resize(size_t _pop_size, size_t _num_resources) {
+    pop_size = _pop_size;
+    num_resources = _num_resources;
+    scores.resize(pop_size * num_resources);
+    sq_scores.resize(pop_size * num_resources);
+    amounts.resize(num_resources);
+    inflows.resize(num_resources);
+    bonuses.resize(num_resources);
+    fitness.resize(pop_size);
+  }
+
+  void SetScore(size_t orgID, size_t resID, double score) {
+    emp_assert(orgID < pop_size && resID < num_resources, orgID, resID);
+    scores[orgID * num_resources + resID] = score;
+  }
+  double GetScore(size_t orgID, size_t resID) const { return scores[orgID * num_resources + resID]; }
+  /// All of orgID's resource scores (num_resources of them).
+  double * GetOrgScores(size_t orgID) { return scores.data() + orgID * num_resources; }
+
+  const emp::vector<double> & GetFitness() const { return fitness; }
+
+  /// Let every organism (in position order) consume from pools, and compute resource-adjusted
+  /// fitness: base fitness (world's fitness function) x 2^(bonus from each resource).
+  template<typename WORLD_TYPE>
+  void CalcFitness(WORLD_TYPE & world, emp::vector<emp::Resource> & pools,
+                   double frac, double max_bonus, double cost) {
+    emp_assert(pools.size() == num_resources && world.GetSize() == pop_size);
+    const double num_orgs = (double)world.GetNumOrgs();
+    for (size_t resID = 0; resID < num_resources; ++resID) {
+      amounts[resID] = pools[resID].GetAmount();
+      inflows[resID] = pools[resID].GetInflow() / num_orgs;
+    }
+    // Scores usually take few distinct values (e.g. move scores), so reuse the last square.
+    double last_score = 0.0, last_sq = emp::Pow(0.0, 2.0);
+    for (size_t i = 0; i < scores.size(); ++i) {
+      if (scores[i] != last_score) { last_score = scores[i]; last_sq = emp::Pow(last_score, 2.0); }
+      sq_scores[i] = last_sq;
+    }
+    double * amount = amounts.data();
+    const double * inflow = inflows.data();
+    double * bonus = bonuses.data();
+    for (size_t orgID = 0; orgID < pop_size; ++orgID) {
+      if (!world.IsOccupied(orgID)) { fitness[orgID] = 0; continue; }
+      const double * sq_score = sq_scores.data() + orgID * num_resources;
+      for (size_t resID = 0; resID < num_resources; ++resID) {
+        amount[resID] += inflow[resID];
+        double cur_fit = sq_score[resID];
+        cur_fit *= frac * (amount[resID] - cost);
+        cur_fit = (cur_fit > 0) ? cur_fit - cost : 0;
+        cur_fit = std::min(cur_fit, max_bonus);
+        bonus[resID] = cur_fit;
+        amount[resID] -= std::abs(cur_fit);
+      }
+      double fit = world.CalcFitnessID(orgID);
+      for (size_t resID = 0; resID < num_resources; ++resID) {
+        if (bonus[resID] != 0) fit *= emp::Pow2(bonus[resID]); // (2^0 == 1: skipping is exact.)
+      }
+      fitness[orgID] = fit;
+    }
+    for (size_t resID = 0; resID < num_resources; ++resID) pools[resID].SetAmount(amounts[resID]);
+  }
+
+  /// tourny_count tournaments of t_size random organisms (with replacement) on resource-adjusted
+  /// fitness; the first highest-fitness entrant of each reproduces into world.
+  template<typename WORLD_TYPE>
+  void DoTournaments(WORLD_TYPE & world, size_t t_size, size_t tourny_count) {
+    emp_assert(t_size > 0, t_size);
+    for (size_t t = 0; t < tourny_count; ++t) {
+      size_t best_id = world.GetRandomOrgID();
+      double best_fit = fitness[best_id];
+      for (size_t i = 1; i < t_size; ++i) {
+        const size_t id = world.GetRandomOrgID();
+        if (fitness[id] > best_fit) {
+          best_fit = fitness[id];
+          best_id = id;
+        }
+      }
+      world.DoBirth(world.GetGenomeAt(best_id), best_id, 1);
+    }
+  }
+};
+
+/// Eco-EA selection into world (as emp::ResourceSelect): res must hold this generation's scores by
+/// world position, one column per pool.
+template<typename WORLD_TYPE>
+void ResourceSelectMatrix(WORLD_TYPE & world, ResourceSelector & res, emp::vector<emp::Resource> & pools,
+                          size_t t_size, size_t tourny_count, double frac, double max_bonus, double cost) {
+  res.CalcFitness(world, pools, frac, max_bonus, cost);
+  res.DoTournaments(world, t_size, tourny_count);
+  for (emp::Resource & pool : pools) pool.Update();
+}
+
+#endif
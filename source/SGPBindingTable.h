@@ -0,0 +1,104 @@
+#ifndef SGP_BINDING_TABLE_H
+#define SGP_BINDING_TABLE_H
+
+#include <limits>
+
+#include "base/vector.h"
+#include "hardware/EventDrivenGP.h"
+#include "tools/Random.h"
+
+#include "SGPCompiledProgram.h"
+
+/// Per-program cache of SignalGP tag bindings.
+/// A program's function tags are fixed while it's being evaluated, so every tag the program
+/// can reference is resolved once (when the program is loaded onto the evaluation hardware)
+/// and calls/forks become a table lookup. Matching mirrors EventDrivenGP::FindBestFuncMatch:
+/// simple match coefficient, minimum binding threshold, and ties broken at call time using
+/// the hardware's random number generator.
+template<size_t TAG_WIDTH>
+class SGPBindingTable {
+public:
+  using hardware_t = emp::EventDrivenGP_AW<TAG_WIDTH>;
+  using tag_t = typename hardware_t::affinity_t;
+
+  static constexpr size_t NO_BINDING = (size_t)-1;
+
+protected:
+  static_assert(TAG_WIDTH <= 16, "SGPBindingTable is dense over tag values; tags must be 16 bits or fewer.");
+  static constexpr size_t TABLE_SIZE = ((size_t)1) << TAG_WIDTH;
+  static constexpr uint32_t TAG_MASK = (uint32_t)(TABLE_SIZE - 1);
+  static constexpr uint32_t UNRESOLVED = std::numeric_limits<uint32_t>::max();
+
+  struct Binding {
+    uint32_t start; ///< Position of first matching function in matches (UNRESOLVED if not yet resolved).
+    uint32_t cnt;   ///< How many functions tied for best match?
+  };
+
+  emp::vector<Binding> table;       ///< Packed tag => binding.
+  emp::vector<uint32_t> matches;    ///< Matching function IDs for all resolved tags (flattened).
+  emp::vector<uint32_t> resolved;   ///< Which table entries have been resolved for the current program?
+  emp::vector<uint32_t> func_tags;  ///< Packed function tags of the current program.
+  double min_bind_thresh;
+
+  static uint32_t Pack(const tag_t & tag) { return tag.GetUInt(0) & TAG_MASK; }
+
+  /// Find best matching function(s) for packed tag, key.
+  void Resolve(uint32_t key) {
+    double thresh = min_bind_thresh;
+    Binding & binding = table[key];
+    binding.start = (uint32_t)matches.size();
+    binding.cnt = 0;
+    for (size_t fID = 0; fID < func_tags.size(); ++fID) {
+      const size_t mismatches = (size_t)__builtin_popcount(key ^ func_tags[fID]);
+      const double bind = (double)(TAG_WIDTH - mismatches) / (double)TAG_WIDTH;
+      if (bind == thresh) {
+        matches.emplace_back((uint32_t)fID);
+        ++binding.cnt;
+      } else if (bind > thresh) {
+        matches.resize(binding.start);
+        matches.emplace_back((uint32_t)fID);
+        binding.cnt = 1;
+        thresh = bind;
+      }
+    }
+    resolved.emplace_back(key);
+  }
+
+public:
+  SGPBindingTable()
+    : table(), matches(), resolved(), func_tags(), min_bind_thresh(0.0)
+  {
+    table.resize(TABLE_SIZE, Binding{UNRESOLVED, 0});
+  }
+
+  /// Rebuild bindings for a newly loaded (compiled) program.
+  template<typename HW_T>
+  void SetProgram(const SGPCompiledProgram<HW_T> & program, double thresh) {
+    for (size_t i = 0; i < resolved.size(); ++i) table[resolved[i]].start = UNRESOLVED;
+    resolved.clear();
+    matches.clear();
+    min_bind_thresh = thresh;
+    func_tags.resize(program.GetSize());
+    for (size_t fID = 0; fID < program.GetSize(); ++fID) {
+      func_tags[fID] = Pack(program[fID].affinity);
+    }
+    for (size_t fID = 0; fID < program.GetSize(); ++fID) {
+      for (const auto & op : program[fID].ops) {
+        const uint32_t key = Pack(op.inst.affinity);
+        if (table[key].start == UNRESOLVED) Resolve(key);
+      }
+    }
+  }
+
+  /// Get function ID bound to tag (NO_BINDING if nothing binds). Ties are broken randomly.
+  size_t GetBinding(const tag_t & tag, emp::Random & rnd) {
+    const uint32_t key = Pack(tag);
+    if (table[key].start == UNRESOLVED) Resolve(key);
+    const Binding & binding = table[key];
+    if (binding.cnt == 0) return NO_BINDING;
+    if (binding.cnt == 1) return matches[binding.start];
+    return matches[binding.start + rnd.GetUInt(binding.cnt)];
+  }
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef SGP_COMPILED_PROGRAM_H
+#define SGP_COMPILED_PROGRAM_H
+
+#include "base/vector.h"
+#include "hardware/EventDrivenGP.h"
+#include "tools/math.h"
+
+/// SignalGP program lowered for SGPHardware (HARDWARE_T) to run directly.
+/// Every function is a flat array of ops, and each op has everything executing its instruction
+/// needs, resolved once:
+///  - fun: the instruction's function (a plain function pointer; no instruction library lookup),
+///  - inst: the instruction itself (its arguments are memory keys, so they're used as is; and its tag),
+///  - block_end: for block-defining instructions, where their block ends (matching Close, or the
+///    end of the function if there isn't one), so If/While/Countdown never scan for it.
+/// Compile once per genotype; a program never changes while it's being evaluated.
+template<typename HARDWARE_T>
+class SGPCompiledProgram {
+public:
+  using hardware_t = HARDWARE_T;
+  using program_t = typename hardware_t::source_program_t;
+  using inst_t = typename hardware_t::inst_t;
+  using tag_t = typename hardware_t::affinity_t;
+  using inst_lib_t = typename hardware_t::inst_lib_t;
+  using fun_t = typename inst_lib_t::fun_t;
+
+  struct Op {
+    fun_t fun;
+    inst_t inst;
+    size_t block_end;   ///< Only meaningful for block-defining instructions.
+  };
+
+  struct Function {
+    tag_t affinity;
+    emp::vector<Op> ops;
+
+    size_t GetSize() const { return ops.size(); }
+  };
+
+protected:
+  emp::vector<Function> functions;
+  size_t max_blocks;  ///< Most block-defining instructions in any one function.
+  bool compiled;
+
+public:
+  SGPCompiledProgram() : functions(), max_blocks(0), compiled(false) { ; }
+
+  bool IsCompiled() const { return compiled; }
+
+  void Clear() { functions.clear(); max_blocks = 0; compiled = false; }
+
+  size_t GetSize() const { return functions.size(); }
+  const Function & operator[](size_t fID) const { emp_assert(fID < functions.size()); return functions[fID]; }
+
+  /// Get end of block opened by the block-defining instruction at fID, ip.
+  size_t GetBlockEnd(size_t fID, size_t ip) const {
+    emp_assert(fID < functions.size() && ip < functions[fID].ops.size());
+    return functions[fID].ops[ip].block_end;
+  }
+
+  /// Open blocks in a call are nested blocks of one function, so no call can have more open blocks
+  /// than this.
+  size_t GetMaxBlocks() const { return max_blocks; }
+
+  /// Lower program, with instruction functions from inst_lib (instruction IDs have to mean the
+  /// same thing in inst_lib as in the program's own instruction library).
+  /// Block ends are equivalent to EventDrivenGP's FindEndOfBlock: unclosed blocks end at the end
+  /// of the function.
+  void Compile(const program_t & program, const inst_lib_t & inst_lib) {
+    functions.resize(program.GetSize());
+    max_blocks = 0;
+    emp::vector<size_t> open_blocks;
+    for (size_t fID = 0; fID < program.GetSize(); ++fID) {
+      const auto & inst_seq = program.program[fID].inst_seq;
+      Function & function = functions[fID];
+      function.affinity = program.program[fID].affinity;
+      function.ops.resize(inst_seq.size());
+      open_blocks.clear();
+      size_t blocks = 0;
+      for (size_t ip = 0; ip < inst_seq.size(); ++ip) {
+        const inst_t & inst = inst_seq[ip];
+        emp_assert(inst.id < inst_lib.GetSize());
+        function.ops[ip] = Op{inst_lib.GetFunction(inst.id), inst, inst_seq.size()};
+        if (inst_lib.IsBlockDef(inst.id)) {
+          open_blocks.emplace_back(ip);
+          ++blocks;
+        } else if (inst_lib.IsBlockClose(inst.id) && open_blocks.size()) {
+          function.ops[open_blocks.back()].block_end = ip;
+          open_blocks.pop_back();
+        }
+      }
+      max_blocks = emp::Max(max_blocks, blocks);
+    }
+    compiled = true;
+  }
+};
+
+#endif
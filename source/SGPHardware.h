@@ -0,0 +1,572 @@
+#ifndef SGP_HARDWARE_H
+#define SGP_HARDWARE_H
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "base/Ptr.h"
+#include "base/vector.h"
+#include "hardware/EventDrivenGP.h"
+#include "hardware/InstLib.h"
+#include "tools/Random.h"
+#include "tools/math.h"
+
+#include "SGPCompiledProgram.h"
+#include "SGPMemory.h"
+
+/// Instruction library for SGPHardware: plain function pointers instead of std::functions, with
+/// emp::InstLib's AddInst interface, so one configuration function can fill either kind of library.
+template<typename HARDWARE_T>
+class SGPInstLib {
+public:
+  using hardware_t = HARDWARE_T;
+  using inst_t = typename hardware_t::inst_t;
+  using fun_t = void (*)(hardware_t &, const inst_t &);
+  using inst_properties_t = std::unordered_set<std::string>;
+
+  struct InstDef {
+    std::string name;
+    fun_t fun_call;
+    size_t num_args;
+    std::string desc;
+    inst_properties_t properties;
+    bool block_def;    ///< Has property "block_def"?
+    bool block_close;  ///< Has property "block_close"?
+  };
+
+protected:
+  emp::vector<InstDef> inst_lib;
+  std::unordered_map<std::string, size_t> name_map;
+
+public:
+  SGPInstLib() : inst_lib(), name_map() { ; }
+
+  size_t GetSize() const { return inst_lib.size(); }
+  const std::string & GetName(size_t id) const { return inst_lib[id].name; }
+  fun_t GetFunction(size_t id) const { return inst_lib[id].fun_call; }
+  size_t GetNumArgs(size_t id) const { return inst_lib[id].num_args; }
+  const std::string & GetDesc(size_t id) const { return inst_lib[id].desc; }
+  bool HasProperty(size_t id, const std::string & property) const { return inst_lib[id].properties.count(property); }
+  bool IsBlockDef(size_t id) const { return inst_lib[id].block_def; }
+  bool IsBlockClose(size_t id) const { return inst_lib[id].block_close; }
+  bool IsInst(const std::string & name) const { return name_map.count(name); }
+
+  size_t GetID(const std::string & name) const {
+    emp_assert(IsInst(name), name);
+    return name_map.find(name)->second;
+  }
+
+  /// Same arguments as emp::InstLib::AddInst. Scope arguments are accepted (and ignored) so that
+  /// instruction sets can be configured identically for both; SignalGP uses properties instead.
+  void AddInst(const std::string & name, fun_t fun_call, size_t num_args=0, const std::string & desc="",
+               emp::ScopeType scope_type=emp::ScopeType::NONE, size_t scope_arg=(size_t)-1,
+               const inst_properties_t & properties=inst_properties_t())
+  {
+    name_map[name] = inst_lib.size();
+    inst_lib.emplace_back(InstDef{name, fun_call, num_args, desc, properties,
+                                  (bool)properties.count("block_def"), (bool)properties.count("block_close")});
+  }
+
+  void ProcessInst(hardware_t & hw, const inst_t & inst) const { inst_lib[inst.id].fun_call(hw, inst); }
+};
+
+/// SignalGP virtual hardware for evaluating programs, parameterized on its memory type (MEMORY_T:
+/// see SGPMemory.h). It runs emp::EventDrivenGP_AW<TAG_WIDTH> programs, compiled for it (see
+/// SGPCompiledProgram.h), with EventDrivenGP's execution model:
+///  - Each SingleProcess gives every active core one instruction, in the order cores were spawned.
+///    Cores spawned by SpawnCore become active at the end of the SingleProcess after they're spawned.
+///  - Running off the end of a function closes its innermost open block (LOOP blocks jump back to
+///    their beginning), or returns if no blocks are open. A core whose last call returns dies.
+///  - Call pushes a call state whose input memory is the caller's local memory (unless the core is
+///    already at max call depth); Return copies the callee's output memory into the caller's local memory.
+/// Cores and call states are pooled up front (see CallStack), so once a program is loaded, running
+/// it doesn't allocate (with SGPDenseMemory; hash map memory allocates as it goes).
+/// Unlike EventDrivenGP, it has no events (nothing dispatches events on evaluation hardware), no
+/// tag-based Call/Fork (the experiment resolves tags through an SGPBindingTable), and unwritten
+/// memory always reads as 0 (EventDrivenGP's default memory value).
+template<size_t TAG_WIDTH, typename MEMORY_T>
+class SGPHardware {
+public:
+  using hardware_t = SGPHardware<TAG_WIDTH, MEMORY_T>;
+  using program_hw_t = emp::EventDrivenGP_AW<TAG_WIDTH>;  ///< Hardware type whose programs we run.
+  using source_program_t = typename program_hw_t::Program;
+  using program_t = SGPCompiledProgram<hardware_t>;       ///< What the hardware actually runs.
+  using inst_t = typename program_hw_t::inst_t;
+  using affinity_t = typename program_hw_t::affinity_t;
+  using memory_t = MEMORY_T;
+  using mem_key_t = typename memory_t::mem_key_t;
+  using mem_val_t = typename memory_t::mem_val_t;
+  using inst_lib_t = SGPInstLib<hardware_t>;
+  using trait_t = double;
+
+  static constexpr size_t MAX_INST_ARGS = program_hw_t::MAX_INST_ARGS;
+  static constexpr size_t DEFAULT_MAX_CORES = 64;
+  static constexpr size_t DEFAULT_MAX_CALL_DEPTH = 128;
+
+  enum class BlockType { NONE=0, BASIC, LOOP };
+
+  struct Block {
+    size_t begin;
+    size_t end;
+    BlockType type;
+
+    Block(size_t _begin=0, size_t _end=0, BlockType _type=BlockType::BASIC)
+      : begin(_begin), end(_end), type(_type) { ; }
+  };
+
+  /// A single call's state: memory, function/instruction pointers, and open blocks.
+  struct State {
+    memory_t local_mem;
+    memory_t input_mem;
+    memory_t output_mem;
+    emp::Ptr<memory_t> shared_mem_ptr;
+    size_t func_ptr;
+    size_t inst_ptr;
+    emp::vector<Block> block_stack;
+    bool is_main;
+
+    State(emp::Ptr<memory_t> _shared_mem_ptr=nullptr, bool _is_main=false)
+      : local_mem(), input_mem(), output_mem(), shared_mem_ptr(_shared_mem_ptr),
+        func_ptr(0), inst_ptr(0), block_stack(), is_main(_is_main) { ; }
+
+    /// Reset for a new call (keeping block_stack's storage).
+    void Reset(bool _is_main=false) {
+      local_mem.Clear();
+      input_mem.Clear();
+      output_mem.Clear();
+      func_ptr = 0;
+      inst_ptr = 0;
+      block_stack.clear();
+      is_main = _is_main;
+    }
+
+    size_t GetFP() const { return func_ptr; }
+    size_t GetIP() const { return inst_ptr; }
+    void SetFP(size_t fp) { func_ptr = fp; }
+    void SetIP(size_t ip) { inst_ptr = ip; }
+    void AdvanceIP(size_t inc=1) { inst_ptr += inc; }
+    bool IsMain() const { return is_main; }
+
+    memory_t & GetLocalMemory() { return local_mem; }
+    memory_t & GetInputMemory() { return input_mem; }
+    memory_t & GetOutputMemory() { return output_mem; }
+    memory_t & GetSharedMemory() { return *shared_mem_ptr; }
+
+    mem_val_t GetLocal(mem_key_t key) const { return local_mem.Get(key); }
+    mem_val_t GetInput(mem_key_t key) const { return input_mem.Get(key); }
+    mem_val_t GetOutput(mem_key_t key) const { return output_mem.Get(key); }
+    mem_val_t GetShared(mem_key_t key) const { return shared_mem_ptr->Get(key); }
+
+    void SetLocal(mem_key_t key, mem_val_t value) { local_mem.Set(key, value); }
+    void SetInput(mem_key_t key, mem_val_t value) { input_mem.Set(key, value); }
+    void SetOutput(mem_key_t key, mem_val_t value) { output_mem.Set(key, value); }
+    void SetShared(mem_key_t key, mem_val_t value) { shared_mem_ptr->Set(key, value); }
+
+    mem_val_t & AccessLocal(mem_key_t key) { return local_mem.Access(key); }
+    mem_val_t & AccessInput(mem_key_t key) { return input_mem.Access(key); }
+    mem_val_t & AccessOutput(mem_key_t key) { return output_mem.Access(key); }
+    mem_val_t & AccessShared(mem_key_t key) { return shared_mem_ptr->Access(key); }
+  };
+
+  /// A core's call stack, with the same interface as EventDrivenGP's (a vector of call states).
+  /// Call states are pooled: a stack owns all of the call states it can ever hold, and calls and
+  /// returns just move its depth, so spawning, calling, and returning reuse call states (and their
+  /// block stacks' storage) instead of building and destroying them.
+  class CallStack {
+  protected:
+    emp::vector<State> states;  ///< Pool of call states; states[0, depth) are in use.
+    size_t depth;
+
+  public:
+    CallStack() : states(), depth(0) { ; }
+
+    size_t size() const { return depth; }
+    bool empty() const { return depth == 0; }
+    State & back() { emp_assert(depth); return states[depth - 1]; }
+    const State & back() const { emp_assert(depth); return states[depth - 1]; }
+    State & operator[](size_t i) { emp_assert(i < depth); return states[i]; }
+    const State & operator[](size_t i) const { emp_assert(i < depth); return states[i]; }
+
+    size_t GetCapacity() const { return states.size(); }
+
+    /// Pool capacity call states that use shared_mem_ptr as shared memory (and empty the stack).
+    void Allocate(size_t capacity, emp::Ptr<memory_t> shared_mem_ptr) {
+      depth = 0;
+      states.resize(capacity);
+      for (State & state : states) state.shared_mem_ptr = shared_mem_ptr;
+    }
+    /// Make sure every pooled call state can hold block_cnt open blocks without allocating.
+    void ReserveBlocks(size_t block_cnt) {
+      for (State & state : states) state.block_stack.reserve(block_cnt);
+    }
+
+    /// Start a new (reset) call state on top of the stack.
+    State & Push(bool is_main=false) {
+      emp_assert(depth < states.size());
+      State & state = states[depth++];
+      state.Reset(is_main);
+      return state;
+    }
+    void Pop() { emp_assert(depth); --depth; }
+    void Clear() { depth = 0; }
+  };
+
+  using exec_stk_t = CallStack;
+
+protected:
+  emp::Ptr<const inst_lib_t> inst_lib;
+  emp::Ptr<emp::Random> random_ptr;
+  emp::Ptr<const program_t> program;  ///< Program being run (not owned).
+  memory_t shared_mem;
+  emp::vector<trait_t> traits;
+  size_t errors;
+  size_t max_cores;
+  size_t max_call_depth;
+  emp::vector<exec_stk_t> cores;
+  emp::vector<size_t> active_cores;
+  emp::vector<size_t> inactive_cores;
+  emp::vector<size_t> pending_cores;
+  size_t block_capacity;  ///< Open blocks every pooled call state can hold without allocating.
+  size_t exec_core_id;
+  bool is_executing;
+
+  /// (Re)build the core/call state pools for max_cores and max_call_depth, and reset.
+  void AllocateCores() {
+    emp_assert(!is_executing);
+    cores.resize(max_cores);
+    for (exec_stk_t & core : cores) {
+      core.Allocate(emp::Max(max_call_depth, (size_t)1), &shared_mem);  // Spawning always takes a call state.
+      core.ReserveBlocks(block_capacity);
+    }
+    active_cores.reserve(max_cores);
+    inactive_cores.reserve(max_cores);
+    pending_cores.reserve(max_cores);
+    ResetHardware();
+  }
+
+public:
+  SGPHardware(emp::Ptr<const inst_lib_t> _inst_lib, emp::Ptr<emp::Random> rnd)
+    : inst_lib(_inst_lib), random_ptr(rnd), program(nullptr), shared_mem(), traits(), errors(0),
+      max_cores(DEFAULT_MAX_CORES), max_call_depth(DEFAULT_MAX_CALL_DEPTH),
+      cores(), active_cores(), inactive_cores(), pending_cores(), block_capacity(0),
+      exec_core_id((size_t)-1), is_executing(false)
+  {
+    emp_assert(random_ptr != nullptr);
+    AllocateCores();
+  }
+  SGPHardware(const SGPHardware &) = delete;   // Call states point at our shared memory.
+  SGPHardware & operator=(const SGPHardware &) = delete;
+
+  /// Reset everything but the program and traits: shared memory, errors, and cores (all inactive).
+  void ResetHardware() {
+    emp_assert(!is_executing);
+    shared_mem.Clear();
+    errors = 0;
+    for (exec_stk_t & core : cores) core.Clear();
+    active_cores.clear();
+    pending_cores.clear();
+    inactive_cores.resize(max_cores);
+    for (size_t i = 0; i < max_cores; ++i) inactive_cores[i] = max_cores - 1 - i;
+    exec_core_id = (size_t)-1;
+  }
+
+  /// Set (compiled) program to run. The hardware doesn't copy it: it has to stay put while it's
+  /// loaded. Pooled call states get room for as many open blocks as any call in it can have.
+  void SetProgram(const program_t & _program) {
+    emp_assert(!is_executing && _program.IsCompiled());
+    program = &_program;
+    if (program->GetMaxBlocks() > block_capacity) {
+      block_capacity = program->GetMaxBlocks();
+      for (exec_stk_t & core : cores) core.ReserveBlocks(block_capacity);
+    }
+  }
+  const program_t & GetProgram() const { emp_assert(program != nullptr); return *program; }
+
+  /// Changing max cores or max call depth rebuilds the core pools (which resets the hardware).
+  void SetMaxCores(size_t n) {
+    emp_assert(n > 0);
+    max_cores = n;
+    AllocateCores();
+  }
+  void SetMaxCallDepth(size_t depth) {
+    max_call_depth = depth;
+    AllocateCores();
+  }
+  size_t GetMaxCores() const { return max_cores; }
+  size_t GetMaxCallDepth() const { return max_call_depth; }
+
+  const inst_lib_t & GetInstLib() const { return *inst_lib; }
+  emp::Random & GetRandom() { return *random_ptr; }
+
+  trait_t GetTrait(size_t id) const { emp_assert(id < traits.size()); return traits[id]; }
+  void SetTrait(size_t id, trait_t value) {
+    if (id >= traits.size()) traits.resize(id + 1, 0.0);
+    traits[id] = value;
+  }
+  size_t GetNumTraits() const { return traits.size(); }
+  size_t GetNumErrors() const { return errors; }
+
+  memory_t & GetSharedMemory() { return shared_mem; }
+  mem_val_t GetShared(mem_key_t key) const { return shared_mem.Get(key); }
+  void SetShared(mem_key_t key, mem_val_t value) { shared_mem.Set(key, value); }
+  mem_val_t & AccessShared(mem_key_t key) { return shared_mem.Access(key); }
+
+  const emp::vector<exec_stk_t> & GetCores() const { return cores; }
+  const emp::vector<size_t> & GetActiveCores() const { return active_cores; }
+  const emp::vector<size_t> & GetInactiveCores() const { return inactive_cores; }
+  const emp::vector<size_t> & GetPendingCores() const { return pending_cores; }
+  size_t GetCurCoreID() const { return exec_core_id; }
+  exec_stk_t & GetCurCore() { emp_assert(exec_core_id < cores.size()); return cores[exec_core_id]; }
+  State & GetCurState() { emp_assert(GetCurCore().size()); return GetCurCore().back(); }
+
+  bool ValidPosition(size_t fp, size_t ip) const {
+    return fp < program->GetSize() && ip < (*program)[fp].GetSize();
+  }
+
+  /// Start a new core running function fID (with input_mem as its input memory) at the end of the
+  /// next SingleProcess. Does nothing if every core is already in use.
+  void SpawnCore(size_t fID, const memory_t & input_mem=memory_t(), bool is_main=false) {
+    if (inactive_cores.empty()) return;
+    const size_t core_id = inactive_cores.back();
+    inactive_cores.pop_back();
+    exec_stk_t & core = cores[core_id];
+    core.Clear();
+    State & state = core.Push(is_main);
+    state.input_mem = input_mem;
+    state.SetFP(fID);
+    pending_cores.emplace_back(core_id);
+  }
+
+  /// Call function fID on the current core (if it isn't at max call depth).
+  void CallFunction(size_t fID) {
+    emp_assert(is_executing);
+    exec_stk_t & core = GetCurCore();
+    if (core.size() >= max_call_depth) return;
+    State & callee = core.Push();
+    callee.input_mem = core[core.size() - 2].local_mem;
+    callee.SetFP(fID);
+  }
+
+  /// Return from the current function: its output memory goes to the caller's local memory.
+  void ReturnFunction() {
+    emp_assert(is_executing);
+    exec_stk_t & core = GetCurCore();
+    if (core.size() > 1) {
+      State & caller = core[core.size() - 2];
+      core.back().output_mem.ForEach([&caller](mem_key_t key, mem_val_t value) { caller.SetLocal(key, value); });
+    }
+    core.Pop();
+  }
+
+  void OpenBlock(size_t begin, size_t end, BlockType type) {
+    GetCurState().block_stack.emplace_back(begin, end, type);
+  }
+
+  /// Close the current block (LOOP blocks jump back to their beginning).
+  void CloseBlock() {
+    State & state = GetCurState();
+    if (state.block_stack.empty()) return;
+    const Block & block = state.block_stack.back();
+    if (block.type == BlockType::LOOP) state.SetIP(block.begin);
+    state.block_stack.pop_back();
+  }
+
+  /// Break out of the current block: continue after its end.
+  void BreakBlock() {
+    State & state = GetCurState();
+    if (state.block_stack.empty()) return;
+    const Block & block = state.block_stack.back();
+    state.SetIP(block.end);
+    if (ValidPosition(state.GetFP(), block.end)) state.AdvanceIP();
+    state.block_stack.pop_back();
+  }
+
+  /// Where does the block opened by the block_def at fp, ip end? (Resolved when the program was compiled.)
+  size_t GetBlockEnd(size_t fp, size_t ip) const { return program->GetBlockEnd(fp, ip); }
+
+  /// Advance the hardware by one time step.
+  void SingleProcess() {
+    emp_assert(program != nullptr && program->GetSize());
+    const size_t core_cnt = active_cores.size();
+    size_t adjust = 0;   // How many cores have died so far (active cores shift down to fill the gaps).
+    for (size_t i = 0; i < core_cnt; ++i) {
+      exec_core_id = active_cores[i];
+      if (adjust) active_cores[i - adjust] = exec_core_id;
+      is_executing = true;
+      State & state = cores[exec_core_id].back();
+      const auto & function = (*program)[state.GetFP()];
+      if (state.GetIP() < function.GetSize()) {
+        const auto & op = function.ops[state.GetIP()];
+        state.AdvanceIP();
+        op.fun(*this, op.inst);
+      } else if (state.block_stack.size()) {
+        CloseBlock();
+      } else {
+        ReturnFunction();
+      }
+      is_executing = false;
+      if (cores[exec_core_id].empty()) {
+        inactive_cores.emplace_back(exec_core_id);
+        ++adjust;
+      }
+    }
+    active_cores.resize(core_cnt - adjust);
+    for (size_t core_id : pending_cores) active_cores.emplace_back(core_id);
+    pending_cores.clear();
+    exec_core_id = active_cores.size() ? active_cores[0] : (size_t)-1;
+  }
+
+  void Process(size_t num_steps) { for (size_t i = 0; i < num_steps; ++i) SingleProcess(); }
+
+  void PrintMemory(const memory_t & mem, std::ostream & os=std::cout) const {
+    os << "{";
+    bool first = true;
+    mem.ForEach([&os, &first](mem_key_t key, mem_val_t value) {
+      if (!first) os << ", ";
+      os << key << ":" << value;
+      first = false;
+    });
+    os << "}";
+  }
+
+  void PrintState(std::ostream & os=std::cout) const {
+    os << "Shared memory: "; PrintMemory(shared_mem, os); os << "\n";
+    os << "Traits: [";
+    for (size_t i = 0; i < traits.size(); ++i) os << (i ? ", " : "") << traits[i];
+    os << "]\n";
+    os << "Errors: " << errors << "\n";
+    os << "Active cores: " << active_cores.size() << " (pending: " << pending_cores.size() << ")\n";
+    for (size_t i = 0; i < active_cores.size(); ++i) {
+      const exec_stk_t & core = cores[active_cores[i]];
+      os << "Core " << i << " (call depth " << core.size() << "):\n";
+      for (size_t d = core.size(); d-- > 0; ) {
+        const State & state = core[d];
+        os << "  --- Call " << d << (state.IsMain() ? " (main)" : "") << ": function " << state.GetFP()
+           << ", instruction " << state.GetIP();
+        if (ValidPosition(state.GetFP(), state.GetIP())) {
+          os << " (" << inst_lib->GetName((*program)[state.GetFP()].ops[state.GetIP()].inst.id) << ")";
+        }
+        os << "; open blocks: " << state.block_stack.size() << "\n";
+        os << "    Local memory: "; PrintMemory(state.local_mem, os); os << "\n";
+        os << "    Input memory: "; PrintMemory(state.input_mem, os); os << "\n";
+        os << "    Output memory: "; PrintMemory(state.output_mem, os); os << "\n";
+      }
+    }
+  }
+
+  // -- Standard instructions (same behavior as EventDrivenGP's) --
+  static void Inst_Inc(hardware_t & hw, const inst_t & inst) {
+    ++hw.GetCurState().AccessLocal(inst.args[0]);
+  }
+  static void Inst_Dec(hardware_t & hw, const inst_t & inst) {
+    --hw.GetCurState().AccessLocal(inst.args[0]);
+  }
+  static void Inst_Not(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], state.GetLocal(inst.args[0]) == 0.0);
+  }
+  static void Inst_Add(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) + state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_Sub(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) - state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_Mult(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) * state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_Div(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const mem_val_t denom = state.AccessLocal(inst.args[1]);
+    if (denom == 0.0) ++hw.errors;
+    else state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) / denom);
+  }
+  static void Inst_Mod(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const int base = (int)state.AccessLocal(inst.args[1]);
+    if (base == 0) ++hw.errors;
+    else state.SetLocal(inst.args[2], (int)state.AccessLocal(inst.args[0]) % base);
+  }
+  static void Inst_TestEqu(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) == state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_TestNEqu(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) != state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_TestLess(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[2], state.AccessLocal(inst.args[0]) < state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_If(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const size_t eob = hw.GetBlockEnd(state.GetFP(), state.GetIP() - 1);
+    if (state.AccessLocal(inst.args[0]) == 0.0) {
+      state.SetIP(eob);
+      if (hw.ValidPosition(state.GetFP(), eob)) state.AdvanceIP();
+    } else {
+      hw.OpenBlock(state.GetIP() - 1, eob, BlockType::BASIC);
+    }
+  }
+  static void Inst_While(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const size_t eob = hw.GetBlockEnd(state.GetFP(), state.GetIP() - 1);
+    if (state.AccessLocal(inst.args[0]) == 0.0) {
+      state.SetIP(eob);
+      if (hw.ValidPosition(state.GetFP(), eob)) state.AdvanceIP();
+    } else {
+      hw.OpenBlock(state.GetIP() - 1, eob, BlockType::LOOP);
+    }
+  }
+  static void Inst_Countdown(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const size_t eob = hw.GetBlockEnd(state.GetFP(), state.GetIP() - 1);
+    if (state.AccessLocal(inst.args[0]) == 0.0) {
+      state.SetIP(eob);
+      if (hw.ValidPosition(state.GetFP(), eob)) state.AdvanceIP();
+    } else {
+      --state.AccessLocal(inst.args[0]);
+      hw.OpenBlock(state.GetIP() - 1, eob, BlockType::LOOP);
+    }
+  }
+  static void Inst_Close(hardware_t & hw, const inst_t & inst) { hw.CloseBlock(); }
+  static void Inst_Break(hardware_t & hw, const inst_t & inst) { hw.BreakBlock(); }
+  static void Inst_Return(hardware_t & hw, const inst_t & inst) { hw.ReturnFunction(); }
+  static void Inst_SetMem(hardware_t & hw, const inst_t & inst) {
+    hw.GetCurState().SetLocal(inst.args[0], (mem_val_t)inst.args[1]);
+  }
+  static void Inst_CopyMem(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[0], state.AccessLocal(inst.args[1]));
+  }
+  static void Inst_SwapMem(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    const mem_val_t val0 = state.AccessLocal(inst.args[0]);
+    state.SetLocal(inst.args[0], state.AccessLocal(inst.args[1]));
+    state.SetLocal(inst.args[1], val0);
+  }
+  static void Inst_Input(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[1], state.AccessInput(inst.args[0]));
+  }
+  static void Inst_Output(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetOutput(inst.args[1], state.AccessLocal(inst.args[0]));
+  }
+  static void Inst_Commit(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    hw.SetShared(inst.args[1], state.AccessLocal(inst.args[0]));
+  }
+  static void Inst_Pull(hardware_t & hw, const inst_t & inst) {
+    State & state = hw.GetCurState();
+    state.SetLocal(inst.args[1], hw.AccessShared(inst.args[0]));
+  }
+  static void Inst_Nop(hardware_t & hw, const inst_t & inst) { ; }
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef SGP_MEMORY_H
+#define SGP_MEMORY_H
+
+#include <array>
+#include <stdint.h>
+#include <unordered_map>
+
+#include "base/assert.h"
+
+/// SignalGP memory types for SGPHardware. Both map integer keys (instruction arguments) to values
+/// with EventDrivenGP's semantics: reading a key that was never written gives 0, and a key "exists"
+/// once it's been written or accessed (that's what Return copies out of output memory).
+
+/// Hash map memory (EventDrivenGP's memory_t): any int key.
+class SGPMapMemory {
+public:
+  using mem_key_t = int;
+  using mem_val_t = double;
+
+protected:
+  std::unordered_map<mem_key_t, mem_val_t> values;
+
+public:
+  static bool IsValidKey(mem_key_t key) { return true; }
+
+  size_t GetSize() const { return values.size(); }
+  bool Has(mem_key_t key) const { return values.find(key) != values.end(); }
+
+  mem_val_t Get(mem_key_t key) const {
+    const auto it = values.find(key);
+    return (it == values.end()) ? 0.0 : it->second;
+  }
+  void Set(mem_key_t key, mem_val_t value) { values[key] = value; }
+  mem_val_t & Access(mem_key_t key) { return values[key]; }
+
+  void Clear() { values.clear(); }
+
+  /// Call fun(key, value) for every key that exists.
+  template<typename FUN>
+  void ForEach(FUN && fun) const {
+    for (const auto & entry : values) fun(entry.first, entry.second);
+  }
+};
+
+/// Dense memory: one array slot per key in [0, SIZE), plus a bitmask of which keys exist. Reads and
+/// writes are an array index, and copying memory (a caller's local memory into its callee's input
+/// memory on Call, or into a new core's input memory on Fork) is a memcpy.
+template<size_t SIZE>
+class SGPDenseMemory {
+public:
+  using mem_key_t = int;
+  using mem_val_t = double;
+
+  static constexpr size_t CAPACITY = SIZE;
+
+protected:
+  static_assert(SIZE <= 64, "SGPDenseMemory tracks which keys exist in a 64-bit mask.");
+
+  std::array<mem_val_t, SIZE> values; ///< Keys that don't exist hold 0.
+  uint64_t written;                   ///< Bit k set => key k exists.
+
+  static uint64_t Bit(mem_key_t key) { return ((uint64_t)1) << key; }
+
+public:
+  SGPDenseMemory() : values(), written(0) { ; }
+
+  static bool IsValidKey(mem_key_t key) { return key >= 0 && (size_t)key < SIZE; }
+
+  size_t GetSize() const { return (size_t)__builtin_popcountll(written); }
+  bool Has(mem_key_t key) const { emp_assert(IsValidKey(key)); return written & Bit(key); }
+
+  mem_val_t Get(mem_key_t key) const { emp_assert(IsValidKey(key)); return values[(size_t)key]; }
+  void Set(mem_key_t key, mem_val_t value) {
+    emp_assert(IsValidKey(key));
+    values[(size_t)key] = value;
+    written |= Bit(key);
+  }
+  mem_val_t & Access(mem_key_t key) {
+    emp_assert(IsValidKey(key));
+    written |= Bit(key);
+    return values[(size_t)key];
+  }
+
+  void Clear() { values.fill(0.0); written = 0; }
+
+  /// Call fun(key, value) for every key that exists, in key order.
+  template<typename FUN>
+  void ForEach(FUN && fun) const {
+    for (uint64_t keys = written; keys; keys &= keys - 1) {
+      const mem_key_t key = (mem_key_t)__builtin_ctzll(keys);
+      fun(key, values[(size_t)key]);
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef SHARED_SGP_PROGRAM_H
+#define SHARED_SGP_PROGRAM_H
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+#include "base/Ptr.h"
+#include "base/vector.h"
+#include "hardware/EventDrivenGP.h"
+
+/// SignalGP program stored as a sequence of reference-counted, immutable function blocks.
+/// Copying a program (e.g. at birth, or into a systematics taxon) only copies block pointers, so
+/// parents, offspring, and ancestors share every function that hasn't been mutated since they
+/// diverged. EditFunction gives copy-on-write access to a single function. Hardware still needs a
+/// flat program: use Materialize to (re)fill one.
+/// Blocks whose last owner lets go of them go into a pool (shared by all threads), and new blocks
+/// copy-assign into pooled ones, so a mutated function reuses a dead function's instruction storage.
+template<typename HARDWARE_T>
+class SharedSGPProgram {
+public:
+  using hardware_t = HARDWARE_T;
+  using program_t = typename hardware_t::Program;
+  using function_t = typename hardware_t::Function;
+  using inst_lib_t = typename hardware_t::inst_lib_t;
+  using block_t = std::shared_ptr<function_t>;  ///< Only ever written through EditFunction.
+
+protected:
+  emp::Ptr<const inst_lib_t> inst_lib;
+  emp::vector<block_t> functions;
+
+  struct BlockPool {
+    std::mutex mutex;
+    emp::vector<block_t> blocks;
+  };
+
+  static BlockPool & GetBlockPool() {
+    static BlockPool * pool = new BlockPool(); // Never destroyed: programs may outlive any static.
+    return *pool;
+  }
+
+  /// A new (unshared) block holding a copy of fun, built in a pooled block if there is one.
+  static block_t NewBlock(const function_t & fun) {
+    BlockPool & pool = GetBlockPool();
+    block_t block;
+    {
+      std::lock_guard<std::mutex> lock(pool.mutex);
+      if (!pool.blocks.empty()) {
+        block = std::move(pool.blocks.back());
+        pool.blocks.pop_back();
+      }
+    }
+    if (!block) return std::make_shared<function_t>(fun);
+    *block = fun;
+    return block;
+  }
+
+  /// Let go of block; if nobody else holds it, it goes into the pool.
+  /// (If use_count is 1, no one else can be copying it.)
+  static void ReleaseBlock(block_t & block) {
+    if (block && block.use_count() == 1) {
+      BlockPool & pool = GetBlockPool();
+      std::lock_guard<std::mutex> lock(pool.mutex);
+      pool.blocks.emplace_back(std::move(block));
+    }
+    block.reset();
+  }
+
+  /// Release functions [size, end) and drop them.
+  void Truncate(size_t size) {
+    for (size_t fID = size; fID < functions.size(); ++fID) ReleaseBlock(functions[fID]);
+    functions.resize(size);
+  }
+
+public:
+  SharedSGPProgram(emp::Ptr<const inst_lib_t> _ilib)
+    : inst_lib(_ilib), functions() { ; }
+
+  SharedSGPProgram(const program_t & program)
+    : inst_lib(program.GetInstLib()), functions(program.GetSize())
+  {
+    for (size_t fID = 0; fID < program.GetSize(); ++fID) {
+      functions[fID] = NewBlock(program.program[fID]);
+    }
+  }
+
+  SharedSGPProgram(const SharedSGPProgram &) = default;
+  SharedSGPProgram(SharedSGPProgram &&) = default;
+  ~SharedSGPProgram() { Clear(); }
+
+  /// Reuses this program's storage.
+  SharedSGPProgram & operator=(const SharedSGPProgram & in) {
+    if (this == &in) return *this;
+    inst_lib = in.inst_lib;
+    Truncate(std::min(functions.size(), in.functions.size()));
+    for (size_t fID = 0; fID < functions.size(); ++fID) {
+      if (functions[fID] == in.functions[fID]) continue;
+      ReleaseBlock(functions[fID]);
+      functions[fID] = in.functions[fID];
+    }
+    functions.insert(functions.end(), in.functions.begin() + functions.size(), in.functions.end());
+    return *this;
+  }
+
+  SharedSGPProgram & operator=(SharedSGPProgram && in) {
+    if (this == &in) return *this;
+    Clear();
+    inst_lib = in.inst_lib;
+    functions.swap(in.functions);  // in keeps our (empty) storage.
+    return *this;
+  }
+
+  /// Storage held for function block pointers.
+  size_t GetCapacity() const { return functions.capacity(); }
+
+  /// How many dead blocks are waiting to be reused?
+  static size_t GetBlockPoolSize() {
+    BlockPool & pool = GetBlockPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    return pool.blocks.size();
+  }
+
+  /// Programs are equal if their functions are; shared blocks are equal without looking inside.
+  bool operator==(const SharedSGPProgram & in) const {
+    if (functions.size() != in.functions.size()) return false;
+    for (size_t fID = 0; fID < functions.size(); ++fID) {
+      if (functions[fID] != in.functions[fID] && !(*functions[fID] == *in.functions[fID])) return false;
+    }
+    return true;
+  }
+  bool operator!=(const SharedSGPProgram & in) const { return !(*this == in); }
+
+  emp::Ptr<const inst_lib_t> GetInstLib() const { return inst_lib; }
+  size_t GetSize() const { return functions.size(); }
+
+  /// Get total number of instructions across all functions.
+  size_t GetInstCnt() const {
+    size_t cnt = 0;
+    for (size_t fID = 0; fID < functions.size(); ++fID) cnt += functions[fID]->inst_seq.size();
+    return cnt;
+  }
+
+  /// Read-only access to a function (never copies).
+  const function_t & operator[](size_t fID) const {
+    emp_assert(fID < functions.size());
+    return *functions[fID];
+  }
+  const function_t & GetFunction(size_t fID) const { return (*this)[fID]; }
+
+  /// Writable access to a function. Copies the function first if anyone else shares it.
+  function_t & EditFunction(size_t fID) {
+    emp_assert(fID < functions.size());
+    if (functions[fID].use_count() > 1) functions[fID] = NewBlock(*functions[fID]);
+    return *functions[fID];
+  }
+
+  /// Is function fID's block shared with another program?
+  bool IsShared(size_t fID) const { return functions[fID].use_count() > 1; }
+
+  /// Append a copy of function fID (shares its block until either copy is edited).
+  void DuplicateFunction(size_t fID) {
+    emp_assert(fID < functions.size());
+    functions.emplace_back(functions[fID]);
+  }
+
+  /// Replace function fID with function other_fID (shares its block).
+  void ReplaceFunction(size_t fID, size_t other_fID) {
+    emp_assert(fID < functions.size() && other_fID < functions.size());
+    if (fID == other_fID) return;
+    ReleaseBlock(functions[fID]);
+    functions[fID] = functions[other_fID];
+  }
+
+  /// Drop all functions (keeps storage for reuse).
+  void Clear() { Truncate(0); }
+
+  void PushFunction(const function_t & fun) { functions.emplace_back(NewBlock(fun)); }
+
+  void ResizeFunctions(size_t size) {
+    emp_assert(size <= functions.size());
+    Truncate(size);
+  }
+
+  /// Fill program (which must use the same instruction library) with a flat copy of this program.
+  /// Reuses program's storage.
+  void Materialize(program_t & program) const {
+    emp_assert(program.GetInstLib() == inst_lib);
+    program.program.resize(functions.size());
+    for (size_t fID = 0; fID < functions.size(); ++fID) program.program[fID] = *functions[fID];
+  }
+
+  program_t ToProgram() const {
+    program_t program(inst_lib);
+    Materialize(program);
+    return program;
+  }
+
+  void PrintProgramFull(std::ostream & os=std::cout) const { ToProgram().PrintProgramFull(os); }
+};
+
+#endif
@@ -25,6 +25,11 @@
 #include "tools/math.h"
 #include "tools/string_utils.h"
 
+#include "MutationCounts.h"
+#include "CounterRandom.h"
+#include "LexicaseSelection.h"
+#include "FitnessSelection.h"
+#include "MapElitesArchive.h"
 #include "toy-config.h"
 
 #include "cec2013.h"
@@ -41,6 +46,17 @@ constexpr size_t SELECTION_METHOD_ID__MAPELITES = 3;
 constexpr size_t SELECTION_METHOD_ID__ROULETTE = 4;
 constexpr size_t SELECTION_METHOD_ID__DRIFT = 5;
 
+constexpr size_t MUTATION_ID__NORMAL = 0;
+constexpr size_t MUTATION_ID__NORMAL_X = 1;
+constexpr size_t MUTATION_ID__NORMAL_Y = 2;
+constexpr size_t NUM_MUTATION_TYPES = 3;
+
+/// What a CounterRandom stream is for: streams are (update, agent, purpose).
+constexpr size_t RANDOM_PURPOSE_ID__INIT = 0;
+constexpr size_t RANDOM_PURPOSE_ID__SELECTION = 1;
+constexpr size_t RANDOM_PURPOSE_ID__MUTATION = 2;
+
+/// Output names for mutation types (indexed by MUTATION_ID__*).
 const emp::vector<std::string> MUTATION_TYPES = {"normal", "normal_x", "normal_y"};
 
 // Available problems: (1-indexed in cpp library)
@@ -56,36 +72,6 @@ const emp::vector<size_t> PROBLEM_MAP = {4,5,6,7,10,11,12,13};
 const emp::vector<std::string> PROBLEM_DESC = {"F4 (2D)","F5 (2D)","F6 (2D)","F7 (2D)","F8 (2D)","F9 (2D)","F10 (2D)","F11 (2D)"};
 
 
-namespace emp {
-  /// ==ROULETTE== Selection (aka Fitness-Proportional Selection) chooses organisms to
-  /// reproduce based on their current fitness.
-  /// @param world The emp::World object with the organisms to be selected.
-  /// @param count How many organims should be selected for replication? (with replacement)
-  template<typename ORG, typename DATA_TYPE>
-  void NastyRouletteSelect(World<ORG, DATA_TYPE> & world, size_t count, typename World<ORG, DATA_TYPE>::fun_calc_fitness_t & fit_fun) {
-    emp_assert(count > 0);
-
-    Random & random = world.GetRandom();
-
-    // Load fitnesses from current population.
-    IndexMap fitness_index(world.GetSize());
-    for (size_t id = 0; id < world.GetSize(); id++) {
-      fitness_index.Adjust(id, fit_fun(world.GetOrg(id)));
-      // fitness_index.Adjust(id, world.CalcFitnessID(id));
-    }
-
-    for (size_t n = 0; n < count; n++) {
-      const double fit_pos = random.GetDouble(fitness_index.GetWeight());
-      const size_t parent_id = fitness_index.Index(fit_pos);
-      const size_t offspring_id = world.DoBirth( world.GetGenomeAt(parent_id), parent_id ).GetIndex();
-      if (world.IsSynchronous() == false) {
-        fitness_index.Adjust(offspring_id, fit_fun(world.GetOrg(offspring_id)));
-        // fitness_index.Adjust(offspring_id, world.CalcFitnessID(offspring_id));
-      }
-    }
-  }
-}
-
 class ToyProblemExp {
 public:
   using genome_t = emp::vector<double>;
@@ -126,8 +112,8 @@ public:
   };
 
   using phenotype_t = emp::vector<double>;
-  using mut_count_t = std::unordered_map<std::string, double>;
-  using data_t = emp::mut_landscape_info<phenotype_t>;
+  using mut_count_t = mut_counts_t<NUM_MUTATION_TYPES>;
+  using data_t = MutCountData<phenotype_t, NUM_MUTATION_TYPES>;
   using world_t = emp::World<Agent, data_t>;
   using genotype_t = world_t::genotype_t;
 
@@ -150,6 +136,8 @@ protected:
   double RESOURCE_SELECT__FRAC;
   double RESOURCE_SELECT__MAX_BONUS;
   double RESOURCE_SELECT__COST;
+  size_t MAP_ELITES__BINS;
+  size_t MAP_ELITES__ARCHIVE_INTERVAL;
 
   double MUTATION_STD;    ///< Given as ratio of dimension domain.
 
@@ -165,6 +153,11 @@ protected:
   size_t best_agent_id;
 
   emp::vector<std::function<double(Agent &)>> fit_set;
+  LexicaseSelector lexicase;             ///< Population x test case scores for lexicase selection.
+  emp::vector<size_t> lexicase_parents;  ///< Scratch: parents picked by lexicase selection.
+  emp::vector<double> select_fitness;    ///< Tournament/roulette selection: fitness by position.
+  AliasTable roulette_table;             ///< Roulette selection: built from select_fitness.
+  emp::vector<size_t> select_parents;    ///< Scratch: parents picked by tournament/roulette selection.
   emp::vector<emp::Resource> resources;                 ///< Resources for emp::ResourceSelect.
   emp::vector<emp::vector<double>> key_points;
   emp::vector<double> mid_point;
@@ -180,6 +173,12 @@ protected:
 
   emp::vector<Phenotype> agent_phen_cache;
   mut_count_t last_mutation;
+  CounterRandom rng;  ///< Mutation/initialization randomness, keyed by the run's seed.
+  size_t birth_cnt;   ///< Mutations so far this update (agent ID for their streams).
+  bool repro_premutated;  ///< Are the offspring being born already mutated?
+
+  MapElitesArchive mape_archive;      ///< MAP-Elites: elites by genome (x, y).
+  emp::vector<size_t> mape_parents;   ///< Scratch: parents picked by MAP-Elites selection.
 
   emp::Ptr<world_t> world;
 
@@ -199,8 +198,6 @@ protected:
   std::function<void(Agent &)> evaluate_agent; ///< Evaluate agent on everything required for selection. Cache results.
   std::function<double(Agent &)> fit_fun;       ///< Fitness function given to world.
 
-  std::function<double(Agent &)> special_roulette_fit_fun;       ///< Fitness function given to world.
-
 
   // Elite select mask.
   template<typename WORLD_TYPE>
@@ -221,7 +218,7 @@ protected:
 
 public:
   ToyProblemExp(const ToyConfig & config)   // @constructor
-    : min_score(0), score_ceil(0), score_floor(0)
+    : min_score(0), score_ceil(0), score_floor(0), birth_cnt(0), repro_premutated(false)
   {
     RUN_MODE = config.RUN_MODE();
     RANDOM_SEED = config.RANDOM_SEED();
@@ -241,6 +238,8 @@ public:
     RESOURCE_SELECT__FRAC = config.RESOURCE_SELECT__FRAC();
     RESOURCE_SELECT__MAX_BONUS = config.RESOURCE_SELECT__MAX_BONUS();
     RESOURCE_SELECT__COST = config.RESOURCE_SELECT__COST();
+    MAP_ELITES__BINS = config.MAP_ELITES__BINS();
+    MAP_ELITES__ARCHIVE_INTERVAL = config.MAP_ELITES__ARCHIVE_INTERVAL();
 
     MUTATION_STD = config.MUTATION_STD();
 
@@ -258,11 +257,10 @@ public:
     //   eval_function.Delete();
     // }
 
-    for (size_t i = 0; i < MUTATION_TYPES.size(); ++i) {
-      last_mutation.emplace(MUTATION_TYPES[i], 0);
-    }
+    last_mutation.fill(0);
 
     random = emp::NewPtr<emp::Random>(RANDOM_SEED);
+    rng.SetSeed((uint64_t)random->GetSeed());
 
     eval_function = emp::NewPtr<CEC2013>(PROBLEM_MAP[PROBLEM]); // Prepare eval function.
 
@@ -326,14 +324,18 @@ public:
     do_begin_run_setup_sig.AddAction([this]() {
       std::cout << "Doing initial run setup." << std::endl;
       world->SetFitFun(fit_fun);
-      world->SetMutFun([this](Agent & agent, emp::Random & rnd) { return this->Mutate(agent, rnd); }, ELITE_SELECT__ELITE_CNT);
+      world->SetMutFun([this](Agent & agent, emp::Random &) {
+        if (repro_premutated) return (size_t)0; // Already mutated (MAP-Elites).
+        rng.SetStream(update, birth_cnt++, RANDOM_PURPOSE_ID__MUTATION);
+        return this->Mutate(agent, rng);
+      }, ELITE_SELECT__ELITE_CNT);
       // Setup systematics/fitness tracking.
       auto & sys_file = world->SetupSystematicsFile(DATA_DIRECTORY + "systematics.csv");
       sys_file.SetTimingRepeat(SYSTEMATICS_INTERVAL);
       auto & fit_file = world->SetupFitnessFile(DATA_DIRECTORY + "fitness.csv");
       fit_file.SetTimingRepeat(FITNESS_INTERVAL);
       emp::AddPhylodiversityFile(*world, DATA_DIRECTORY + "phylodiversity.csv").SetTimingRepeat(SYSTEMATICS_INTERVAL);
-      emp::AddLineageMutationFile(*world, DATA_DIRECTORY + "lineage_mutations.csv", MUTATION_TYPES).SetTimingRepeat(SYSTEMATICS_INTERVAL);
+      AddLineageMutationCountFile(*world, DATA_DIRECTORY + "lineage_mutations.csv", MUTATION_TYPES).SetTimingRepeat(SYSTEMATICS_INTERVAL);
       AddDominantFile(*world, DATA_DIRECTORY + "dominant.csv", MUTATION_TYPES).SetTimingRepeat(SYSTEMATICS_INTERVAL);
       world->OnGenotypeKnown([this](emp::Ptr<genotype_t> genotype, size_t pos) {
         genotype->GetData().RecordMutation(last_mutation);
@@ -377,8 +379,7 @@ public:
         ConfigEcoEASelection();
         break;
       case SELECTION_METHOD_ID__MAPELITES:
-        std::cout << "Map elites not implemented! Exiting..." << std::endl;
-        exit(-1);
+        ConfigMapElitesSelection();
         break;
       case SELECTION_METHOD_ID__ROULETTE:
         ConfigRouletteSelection();
@@ -395,16 +396,18 @@ public:
     do_pop_init_sig.AddAction([this]() {
       // Init from single (in middle), mutate with crazy high mutation rate, run for single generation.
       Agent ancestor(mid_point);
-      world->SetMutFun([this](Agent & agent, emp::Random & r) {
+      birth_cnt = 0;
+      world->SetMutFun([this](Agent & agent, emp::Random &) {
         genome_t & genome = agent.GetGenome();
+        rng.SetStream(0, birth_cnt++, RANDOM_PURPOSE_ID__INIT);
 
-        double new_x = r.GetDouble(lbounds[0], ubounds[0]);
-        double new_y = r.GetDouble(lbounds[1], ubounds[1]);
+        double new_x = rng.GetDouble(lbounds[0], ubounds[0]);
+        double new_y = rng.GetDouble(lbounds[1], ubounds[1]);
 
 
-        last_mutation["normal"] = CalcDist(genome, {new_x, new_y});
-        last_mutation["normal_x"] = emp::Abs(genome[0]-new_x);
-        last_mutation["normal_y"] = emp::Abs(genome[1]-new_y);
+        last_mutation[MUTATION_ID__NORMAL] = CalcDist(genome, {new_x, new_y});
+        last_mutation[MUTATION_ID__NORMAL_X] = emp::Abs(genome[0]-new_x);
+        last_mutation[MUTATION_ID__NORMAL_Y] = emp::Abs(genome[1]-new_y);
 
         genome[0] = new_x;
         genome[1] = new_y;
@@ -417,7 +420,11 @@ public:
       emp::TournamentSelect(*world, 1, POP_SIZE);
       world->Update();
       // Fix the mutation function.
-      world->SetMutFun([this](Agent & agent, emp::Random & rnd) { return this->Mutate(agent, rnd); }, ELITE_SELECT__ELITE_CNT);
+      world->SetMutFun([this](Agent & agent, emp::Random &) {
+        if (repro_premutated) return (size_t)0; // Already mutated (MAP-Elites).
+        rng.SetStream(update, birth_cnt++, RANDOM_PURPOSE_ID__MUTATION);
+        return this->Mutate(agent, rng);
+      }, ELITE_SELECT__ELITE_CNT);
     });
 
     // do_world_update_sig
@@ -501,6 +508,10 @@ public:
         for (update = world->GetUpdate(); update <= GENERATIONS; ++update) {
           RunStep();
           if (update % POP_SNAPSHOT_INTERVAL == 0) do_pop_snapshot_sig.Trigger(update);
+          if (SELECTION_METHOD == SELECTION_METHOD_ID__MAPELITES && MAP_ELITES__ARCHIVE_INTERVAL
+              && update % MAP_ELITES__ARCHIVE_INTERVAL == 0) {
+            mape_archive.WriteBinary(DATA_DIRECTORY + "map_elites_" + emp::to_string((int)update) + ".bin", update);
+          }
         }
 
         std::clock_t base_tot_time = std::clock() - base_start_time;
@@ -520,12 +531,13 @@ public:
 
   /// Do a single step of evolution.
   void RunStep() {
+    birth_cnt = 0;
     do_evaluation_sig.Trigger();
     do_selection_sig.Trigger();
     do_world_update_sig.Trigger();
   }
 
-  size_t Mutate(Agent & agent, emp::Random & rnd);
+  size_t Mutate(Agent & agent, CounterRandom & rnd);
 
   void Snapshot(size_t u);
 
@@ -535,17 +547,16 @@ public:
   void ConfigTournamentSelection();
   void ConfigLexicaseSelection();
   void ConfigEcoEASelection();
+  void ConfigMapElitesSelection();
   void ConfigRouletteSelection();
   void ConfigDriftSelection();
 
 };
 
 /// NOTE: assumes (at least) 2 dimensions
-size_t ToyProblemExp::Mutate(Agent & agent, emp::Random & rnd) {
+size_t ToyProblemExp::Mutate(Agent & agent, CounterRandom & rnd) {
   genome_t & genome = agent.GetGenome();
-  for (size_t i = 0; i < MUTATION_TYPES.size(); ++i) {
-    last_mutation[MUTATION_TYPES[i]] = 0;
-  }
+  last_mutation.fill(0);
   genome_t new_vals(genome.size());
   for (size_t d = 0; d < genome.size(); ++d) {
     double new_val = rnd.GetRandNormal(genome[d], mut_std[d]);
@@ -555,9 +566,9 @@ size_t ToyProblemExp::Mutate(Agent & agent, emp::Random & rnd) {
     new_vals[d] = new_val;
   }
   // Record last mutation info.
-  last_mutation["normal"] = CalcDist(genome, new_vals);
-  last_mutation["normal_x"] = emp::Abs(genome[0]-new_vals[0]);
-  last_mutation["normal_y"] = emp::Abs(genome[1]-new_vals[1]);
+  last_mutation[MUTATION_ID__NORMAL] = CalcDist(genome, new_vals);
+  last_mutation[MUTATION_ID__NORMAL_X] = emp::Abs(genome[0]-new_vals[0]);
+  last_mutation[MUTATION_ID__NORMAL_Y] = emp::Abs(genome[1]-new_vals[1]);
   // Update genome with new values
   for (size_t d = 0; d < genome.size(); ++d) { genome[d] = new_vals[d]; }
   return genome.size();
@@ -602,7 +613,7 @@ emp::DataFile & ToyProblemExp::AddDominantFile(WORLD_TYPE & world, const std::st
 
   for (size_t i = 0; i < mut_types.size(); ++i) {
     std::string mut_type = mut_types[i];
-    std::function<int(void)> mut_fun = [&world, this, mut_type]() { return emp::CountMuts(world.GetGenotypeAt(this->best_agent_id), mut_type); };
+    std::function<int(void)> mut_fun = [&world, this, i]() { return (int)CountLineageMuts(world.GetGenotypeAt(this->best_agent_id), i); };
     file.AddFun(mut_fun, "dominant_"+mut_type+"_mutation_magnitude", "magnitude of "+mut_type+" mutations along dominant organism's lineage");
   }
 
@@ -610,13 +621,13 @@ emp::DataFile & ToyProblemExp::AddDominantFile(WORLD_TYPE & world, const std::st
     return emp::LineageLength(world.GetGenotypeAt(this->best_agent_id));
   };
   std::function<int(void)> dom_lin_len_norm = [&world, this](){
-    return emp::CountMutSteps(world.GetGenotypeAt(this->best_agent_id), "normal");
+    return CountLineageMutSteps(world.GetGenotypeAt(this->best_agent_id), {MUTATION_ID__NORMAL});
   };
   std::function<int(void)> dom_lin_len_normx = [&world, this](){
-    return emp::CountMutSteps(world.GetGenotypeAt(this->best_agent_id), "normal_x");
+    return CountLineageMutSteps(world.GetGenotypeAt(this->best_agent_id), {MUTATION_ID__NORMAL_X});
   };
   std::function<int(void)> dom_lin_len_normy = [&world, this](){
-    return emp::CountMutSteps(world.GetGenotypeAt(this->best_agent_id), "normal_y");
+    return CountLineageMutSteps(world.GetGenotypeAt(this->best_agent_id), {MUTATION_ID__NORMAL_Y});
   };
   std::function<int(void)> dom_del_step = [&world, this](){
     return emp::CountDeleteriousSteps(world.GetGenotypeAt(this->best_agent_id));
@@ -659,7 +670,9 @@ void ToyProblemExp::ConfigTournamentSelection() {
   // 3) Setup do_selection_sig
   do_selection_sig.AddAction([this]() {
     this->EliteSelect_MASK(*world, ELITE_SELECT__ELITE_CNT, 1);
-    emp::TournamentSelect(*world, TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT);
+    select_fitness.resize(world->GetSize());
+    for (size_t id = 0; id < world->GetSize(); ++id) select_fitness[id] = agent_phen_cache[id].score;
+    TournamentSelectArray(*world, select_fitness, TOURNAMENT_SIZE, POP_SIZE - ELITE_SELECT__ELITE_CNT, select_parents);
   });
 }
 
@@ -684,23 +697,19 @@ void ToyProblemExp::ConfigLexicaseSelection() {
     const size_t id = agent.GetID();
     return agent_phen_cache[id].score;
   };
-  // 2.5) Fill out fit set.
-  for (size_t i = 0; i < key_points.size(); ++i) {
-    fit_set.push_back([this, i](Agent & agent) {
-      const size_t id = agent.GetID();
-      const Phenotype & phen = agent_phen_cache[id];
-      return phen.testcase_scores[i];
-    });
-  }
-  fit_set.push_back([this](Agent & agent) {
-    const size_t id = agent.GetID();
-    const Phenotype & phen = agent_phen_cache[id];
-    return phen.score;
-  });
-  // 3) Setup do_selection_sig
+  // 3) Setup do_selection_sig: test cases are distance-weighted scores for each key point, plus
+  //    raw score.
   do_selection_sig.AddAction([this]() {
     this->EliteSelect_MASK(*world, ELITE_SELECT__ELITE_CNT, 1);
-    emp::LexicaseSelect(*world, fit_set, POP_SIZE - ELITE_SELECT__ELITE_CNT, 0, adjusted_lexicase_epsilon);
+    const size_t pop_size = world->GetSize();
+    lexicase.Resize(pop_size, key_points.size() + 1);
+    for (size_t id = 0; id < pop_size; ++id) {
+      const Phenotype & phen = agent_phen_cache[id];
+      for (size_t i = 0; i < key_points.size(); ++i) lexicase.SetScore(i, id, phen.testcase_scores[i]);
+      lexicase.SetScore(key_points.size(), id, phen.score);
+    }
+    lexicase.Prepare(adjusted_lexicase_epsilon);
+    LexicaseSelectMatrix(*world, lexicase, POP_SIZE - ELITE_SELECT__ELITE_CNT, lexicase_parents);
   });
 }
 
@@ -754,6 +763,61 @@ void ToyProblemExp::ConfigEcoEASelection() {
   });
 }
 
+void ToyProblemExp::ConfigMapElitesSelection() {
+  // 0) Setup archive: MAP_ELITES__BINS x MAP_ELITES__BINS over the genome's (x, y).
+  for (size_t dim = 0; dim < DIMENSIONS; ++dim) mape_archive.AddAxis(lbounds[dim], ubounds[dim], MAP_ELITES__BINS);
+  mape_archive.Reset();
+  // Every elite is carried over into the next population, so they all have to fit (with room for offspring).
+  if (mape_archive.GetNumCells() >= POP_SIZE) {
+    std::cout << "MAP-Elites archive (" << mape_archive.GetNumCells() << " cells) must be smaller than POP_SIZE. Exiting..." << std::endl;
+    exit(-1);
+  }
+  // 1) Fill out evaluate function.
+  evaluate_agent = [this](Agent & agent) {
+    const size_t id = agent.GetID();
+    Phenotype & phen = agent_phen_cache[id];
+    phen.score = eval_function->evaluate(agent.genome);
+    record_phen_sig.Trigger(id, {phen.score});
+    record_fit_sig.Trigger(id, phen.score);
+  };
+  // 2) Fill out fit fun.
+  fit_fun = [this](Agent & agent) {
+    const size_t id = agent.GetID();
+    return agent_phen_cache[id].score;
+  };
+  // 3) Setup do_selection_sig
+  do_selection_sig.AddAction([this]() {
+    // Offer everyone to the archive.
+    for (size_t id = 0; id < world->GetSize(); ++id) {
+      mape_archive.Insert(world->GetOrg(id).genome.data(), agent_phen_cache[id].score, id);
+    }
+    // Every elite is carried over unmutated (so the archive always points at live agents); the
+    // rest of the population is offspring of uniformly random elites.
+    const size_t elite_cnt = mape_archive.GetNumOccupied();
+    mape_parents.clear();
+    for (size_t i = 0; i < elite_cnt; ++i) {
+      const size_t cell = mape_archive.GetOccupiedCell(i);
+      mape_parents.emplace_back(mape_archive.GetElitePos(cell));
+      mape_archive.SetElitePos(cell, i); // Where it'll be born.
+    }
+    rng.SetStream(update, 0, RANDOM_PURPOSE_ID__SELECTION);
+    for (size_t i = elite_cnt; i < POP_SIZE; ++i) mape_parents.emplace_back(mape_parents[rng.GetUInt(elite_cnt)]);
+    // Offspring i is mutated with stream (update, i, mutation).
+    repro_premutated = true;
+    for (size_t i = 0; i < mape_parents.size(); ++i) {
+      Agent offspring(world->GetGenomeAt(mape_parents[i]));
+      if (i < elite_cnt) {
+        last_mutation.fill(0);
+      } else {
+        rng.SetStream(update, i, RANDOM_PURPOSE_ID__MUTATION);
+        this->Mutate(offspring, rng);
+      }
+      world->DoBirth(offspring, mape_parents[i]);
+    }
+    repro_premutated = false;
+  });
+}
+
 void ToyProblemExp::ConfigRouletteSelection() {
   // Add another action to do_evaluation_sig ==> Transform scores if necessary.
   do_evaluation_sig.AddAction([this]() {
@@ -772,6 +836,7 @@ void ToyProblemExp::ConfigRouletteSelection() {
     const size_t id = agent.GetID();
     Phenotype & phen = agent_phen_cache[id];
     phen.score = eval_function->evaluate(agent.genome);
+    phen.transformed_score = phen.score; // (Shifted after evaluation if any score is negative.)
     record_phen_sig.Trigger(id, {phen.score});
     record_fit_sig.Trigger(id, phen.score);
   };
@@ -781,14 +846,13 @@ void ToyProblemExp::ConfigRouletteSelection() {
     const size_t id = agent.GetID();
     return agent_phen_cache[id].score;
   };
-  special_roulette_fit_fun = [this](Agent & agent) {
-    const size_t id = agent.GetID();
-    return agent_phen_cache[id].transformed_score;
-  };
-  // 3) Setup do_selection_sig -- TODO, fix rs
+  // 3) Setup do_selection_sig: roulette on transformed scores.
   do_selection_sig.AddAction([this]() {
     this->EliteSelect_MASK(*world, ELITE_SELECT__ELITE_CNT, 1);
-    emp::NastyRouletteSelect(*world, POP_SIZE - ELITE_SELECT__ELITE_CNT, special_roulette_fit_fun);
+    select_fitness.resize(world->GetSize());
+    for (size_t id = 0; id < world->GetSize(); ++id) select_fitness[id] = agent_phen_cache[id].transformed_score;
+    roulette_table.Build(select_fitness);
+    RouletteSelectArray(*world, roulette_table, POP_SIZE - ELITE_SELECT__ELITE_CNT, select_parents);
   });
 }
 
@@ -0,0 +1,94 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "base/assert.h"
+#include "base/vector.h"
+
+/// Fixed set of workers that lives as long as the pool (i.e., the whole run), so running a job
+/// doesn't start or join any threads. Worker 0 is whichever thread calls Run; workers
+/// [1, GetSize()) are threads that sleep between jobs.
+class WorkerPool {
+protected:
+  using job_fun_t = void (*)(void *, size_t);
+
+  emp::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable start_cv;  ///< Signaled when there's a new job (or the pool is stopping).
+  std::condition_variable done_cv;   ///< Signaled when the last worker finishes its part of a job.
+  job_fun_t job_fun;                 ///< Calls the current job for a worker.
+  void * job;                        ///< The current job.
+  size_t job_workers;                ///< How many workers the current job runs on.
+  size_t job_cnt;                    ///< Jobs started so far (so workers can tell a new one from the last).
+  size_t running;                    ///< Thread workers still running the current job.
+  bool stopping;
+
+  void WorkerLoop(size_t workerID) {
+    size_t seen_cnt = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      start_cv.wait(lock, [this, &seen_cnt]() { return stopping || job_cnt != seen_cnt; });
+      if (stopping) return;
+      seen_cnt = job_cnt;
+      if (workerID >= job_workers) continue;
+      const job_fun_t fun = job_fun;
+      void * const cur_job = job;
+      lock.unlock();
+      fun(cur_job, workerID);
+      lock.lock();
+      if (--running == 0) done_cv.notify_one();
+    }
+  }
+
+public:
+  explicit WorkerPool(size_t num_workers=1)
+    : threads(), mutex(), start_cv(), done_cv(), job_fun(nullptr), job(nullptr),
+      job_workers(0), job_cnt(0), running(0), stopping(false)
+  {
+    emp_assert(num_workers > 0);
+    for (size_t w = 1; w < num_workers; ++w) threads.emplace_back([this, w]() { WorkerLoop(w); });
+  }
+
+  WorkerPool(const WorkerPool &) = delete;   // Threads point at it.
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    start_cv.notify_all();
+    for (std::thread & thread : threads) thread.join();
+  }
+
+  size_t GetSize() const { return threads.size() + 1; }
+
+  /// Call fun(workerID) for each worker in [0, num_workers), concurrently; returns once they've
+  /// all finished. A single worker never involves the pool's threads.
+  template<typename FUN>
+  void Run(size_t num_workers, FUN && fun) {
+    using fun_t = typename std::remove_reference<FUN>::type;
+    emp_assert(num_workers > 0 && num_workers <= GetSize());
+    if (num_workers > 1) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        job_fun = [](void * f, size_t w) { (*static_cast<fun_t *>(f))(w); };
+        job = const_cast<void *>(static_cast<const void *>(&fun));
+        job_workers = num_workers;
+        running = num_workers - 1;
+        ++job_cnt;
+      }
+      start_cv.notify_all();
+    }
+    fun(0);
+    if (num_workers > 1) {
+      std::unique_lock<std::mutex> lock(mutex);
+      done_cv.wait(lock, [this]() { return running == 0; });
+    }
+  }
+};
+
+#endif
@@ -26,12 +26,24 @@ EMP_BUILD_CONFIG( LineageConfig,
   VALUE(RESOURCE_SELECT__MAX_BONUS, double, 5.0, "What's the max bonus someone can get for consuming a resource?"),
   VALUE(RESOURCE_SELECT__COST, double, 0.0, "Cost of using a resource?"),
   VALUE(RESOURCE_SELECT__GAME_PHASE_LEN, size_t, 10, "Game phase interval (defines the number of rounds in each phase)"),
+  VALUE(REPRO_THREADS, size_t, 0, "Batched reproduction: pick all parents first, then copy and mutate offspring on this many threads (each with its own random number stream). 0: reproduce serially inside the world (Eco-EA always does)."),
+  VALUE(MAP_ELITES__PHASE_BINS, size_t, 3, "MAP-Elites: bins on each game phase axis (axis value: expert move rate on that phase's test cases). 0: no phase axes."),
+  VALUE(MAP_ELITES__LENGTH_BINS, size_t, 0, "MAP-Elites: bins on the program length axis. 0: no length axis."),
+  VALUE(MAP_ELITES__ARCHIVE_INTERVAL, size_t, 1000, "MAP-Elites: write the archive (binary) every this many updates. 0: never."),
+  GROUP(ISLAND_GROUP, "Island Model Settings"),
+  VALUE(ISLAND__DEME_CNT, size_t, 1, "Island model: split the population into this many equal demes (selection and elites are per deme; each deme is evaluated on its own worker). Demes are blocks of one world and share its systematics. 1: one well-mixed population."),
+  VALUE(ISLAND__MIGRATION_INTERVAL, size_t, 50, "Island model: exchange migrants every this many updates. 0: never."),
+  VALUE(ISLAND__MIGRANT_CNT, size_t, 5, "Island model: offspring per deme (at each migration) whose parents are picked in another deme."),
+  VALUE(ISLAND__TOPOLOGY, size_t, 0, "Island model: where migrants come from. \n0: Ring (previous deme)\n1: Fully connected (random other deme)"),
+  VALUE(ISLAND__DEME_SYSTEMATICS, bool, false, "Island model: also write per-deme summaries (deme_systematics.csv)? Demes have no systematics of their own: there is one phylogeny across all demes."),
   GROUP(MOVE_SCORING_GROUP, "Move scoring group."),
   VALUE(SCORE_MOVE__ILLEGAL_MOVE_VALUE, double, -5.0, "Score for making illegal move"),
   VALUE(SCORE_MOVE__LEGAL_MOVE_VALUE, double, 1.0, "Score for making a legal move, but not the expert's move"),
   VALUE(SCORE_MOVE__EXPERT_MOVE_VALUE, double, 2.0, "Score for making an expert move"),
   GROUP(OTHELLO_GROUP, "Othello-specific Settings"),
   VALUE(OTHELLO_HW_BOARDS, size_t, 1, "How many dream boards are given to agents for them to manipulate?"),
+  VALUE(OTHELLO_HW_CHECKPOINTS, bool, false, "Give agents PushBoard/PopBoard instructions to checkpoint and undo moves on their active dream board?"),
+  VALUE(OTHELLO_HW_FEATURES, bool, false, "Give agents whole-board feature instructions (disk counts, corners, greedy move, mobility difference)?"),
   GROUP(AGP_PROGRAM_GROUP, "AvidaGP Program Settings"),
   VALUE(AGP_GENOME_SIZE, size_t, 200, "How long should genome be?"),
   GROUP(SGP_PROGRAM_GROUP, "SignalGP program Settings"),
@@ -46,7 +58,7 @@ EMP_BUILD_CONFIG( LineageConfig,
   VALUE(AGP_PER_INST__SUB_RATE, double, 0.005, "Per-instruction subsitution mutation rate."),
   GROUP(SGP_MUTATION_GROUP, "SignalGP Mutation Settings"),
   VALUE(SGP_VARIABLE_LENGTH, bool, true, "Are SGP programs variable or fixed length?"),
-  VALUE(SGP_PROG_MAX_ARG_VAL, int, 16, "Maximum argument value for instructions."),
+  VALUE(SGP_PROG_MAX_ARG_VAL, int, 16, "Instruction arguments are in [0, SGP_PROG_MAX_ARG_VAL) (memory keys: at most 16)."),
   VALUE(SGP_PER_BIT__TAG_BFLIP_RATE, double, 0.005, "Per-bit mutation rate of tag bit flips."),
   VALUE(SGP_PER_INST__SUB_RATE, double, 0.005, "Per-instruction/argument subsitution rate."),
   VALUE(SGP_PER_INST__INS_RATE, double, 0.005, "Per-instruction insertion mutation rate."),
@@ -0,0 +1,37 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <iostream>
+#include <string>
+
+/// Checks for the standalone tests in this directory: every failed check says what failed and is
+/// counted, and CheckResult turns the count into main's return value.
+
+/// How many checks have failed so far?
+inline size_t & CheckFailures() {
+  static size_t failures = 0;
+  return failures;
+}
+
+/// Check that ok holds (what: what's wrong if it doesn't).
+inline void Check(bool ok, const std::string & what) {
+  if (ok) return;
+  std::cout << "Oh no! " << what << std::endl;
+  ++CheckFailures();
+}
+
+/// Check that ok holds in a randomized test's trial.
+inline void Check(bool ok, const std::string & what, size_t trial) {
+  if (ok) return;
+  std::cout << "Oh no! " << what << " (trial " << trial << ")" << std::endl;
+  ++CheckFailures();
+}
+
+/// Report how many checks failed; return value for main.
+inline int CheckResult() {
+  std::cout << "Failed checks: " << CheckFailures() << std::endl;
+  std::cout << (CheckFailures() ? "FAILED" : "PASSED") << std::endl;
+  return CheckFailures() ? 1 : 0;
+}
+
+#endif
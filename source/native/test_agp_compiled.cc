@@ -0,0 +1,126 @@
+// Differential test: AvidaGP with compiled (jump table) scope bypassing vs. stock emp::AvidaGP.
+
+#include <iostream>
+#include <ctime>
+#include <cmath>
+
+#include "base/vector.h"
+#include "hardware/AvidaGP.h"
+#include "hardware/AvidaCPU_InstLib.h"
+#include "tools/Random.h"
+
+#include "../AGPCompiledProgram.h"
+
+using hardware_t = emp::AvidaGP;
+using inst_t = hardware_t::inst_t;
+using inst_lib_t = hardware_t::inst_lib_t;
+using genome_t = hardware_t::genome_t;
+using compiled_t = AGPCompiledProgram<hardware_t>;
+
+/// Add instructions that are shared by the stock and compiled instruction sets.
+/// Both libraries must have instructions in the same order, so flow control is added by the caller
+/// in between.
+void AddMathInsts(inst_lib_t & lib) {
+  lib.AddInst("Inc", inst_lib_t::Inst_Inc, 1, "Increment value in reg Arg1");
+  lib.AddInst("Dec", inst_lib_t::Inst_Dec, 1, "Decrement value in reg Arg1");
+  lib.AddInst("Not", inst_lib_t::Inst_Not, 1, "Logically toggle value in reg Arg1");
+  lib.AddInst("SetReg", inst_lib_t::Inst_SetReg, 2, "Set reg Arg1 to numerical value Arg2");
+  lib.AddInst("Add", inst_lib_t::Inst_Add, 3, "regs: Arg3 = Arg1 + Arg2");
+  lib.AddInst("Sub", inst_lib_t::Inst_Sub, 3, "regs: Arg3 = Arg1 - Arg2");
+  lib.AddInst("Mult", inst_lib_t::Inst_Mult, 3, "regs: Arg3 = Arg1 * Arg2");
+  lib.AddInst("Div", inst_lib_t::Inst_Div, 3, "regs: Arg3 = Arg1 / Arg2");
+  lib.AddInst("Mod", inst_lib_t::Inst_Mod, 3, "regs: Arg3 = Arg1 % Arg2");
+  lib.AddInst("TestEqu", inst_lib_t::Inst_TestEqu, 3, "regs: Arg3 = (Arg1 == Arg2)");
+  lib.AddInst("TestNEqu", inst_lib_t::Inst_TestNEqu, 3, "regs: Arg3 = (Arg1 != Arg2)");
+  lib.AddInst("TestLess", inst_lib_t::Inst_TestLess, 3, "regs: Arg3 = (Arg1 < Arg2)");
+}
+
+void AddMiscInsts(inst_lib_t & lib) {
+  lib.AddInst("Scope", inst_lib_t::Inst_Scope, 1, "Enter scope Arg1", emp::ScopeType::BASIC, 0);
+  lib.AddInst("Call", inst_lib_t::Inst_Call, 1, "Call previously defined function Arg1");
+  lib.AddInst("Push", inst_lib_t::Inst_Push, 2, "Push reg Arg1 onto stack Arg2");
+  lib.AddInst("Pop", inst_lib_t::Inst_Pop, 2, "Pop stack Arg1 into reg Arg2");
+  lib.AddInst("CopyVal", inst_lib_t::Inst_CopyVal, 2, "Copy reg Arg1 into reg Arg2");
+  lib.AddInst("ScopeReg", inst_lib_t::Inst_ScopeReg, 1, "Backup reg Arg1; restore at end of scope");
+}
+
+bool SameReg(double a, double b) {
+  return (a == b) || (std::isnan(a) && std::isnan(b));
+}
+
+int main(int argc, char* argv[])
+{
+  emp::Random random(2);
+  compiled_t compiled;
+
+  // Stock instruction set.
+  inst_lib_t stock_lib;
+  AddMathInsts(stock_lib);
+  stock_lib.AddInst("If", inst_lib_t::Inst_If, 2, "If reg Arg1 != 0, scope -> Arg2; else skip scope", emp::ScopeType::BASIC, 1);
+  stock_lib.AddInst("While", inst_lib_t::Inst_While, 2, "Until reg Arg1 != 0, repeat scope Arg2; else skip", emp::ScopeType::LOOP, 1);
+  stock_lib.AddInst("Countdown", inst_lib_t::Inst_Countdown, 2, "Countdown reg Arg1 to zero; scope to Arg2", emp::ScopeType::LOOP, 1);
+  stock_lib.AddInst("Break", inst_lib_t::Inst_Break, 1, "Break out of scope Arg1");
+  stock_lib.AddInst("Define", inst_lib_t::Inst_Define, 2, "Build function Arg1 in scope Arg2", emp::ScopeType::FUNCTION, 1);
+  AddMiscInsts(stock_lib);
+
+  // Compiled instruction set (the same AGPCompiled_Inst_* functions LineageExp registers).
+  inst_lib_t compiled_lib;
+  AddMathInsts(compiled_lib);
+  compiled_lib.AddInst("If", [&compiled](hardware_t & hw, const inst_t & inst) { AGPCompiled_Inst_If(hw, inst, compiled); },
+                       2, "If reg Arg1 != 0, scope -> Arg2; else skip scope", emp::ScopeType::BASIC, 1);
+  compiled_lib.AddInst("While", [&compiled](hardware_t & hw, const inst_t & inst) { AGPCompiled_Inst_While(hw, inst, compiled); },
+                       2, "Until reg Arg1 != 0, repeat scope Arg2; else skip", emp::ScopeType::LOOP, 1);
+  compiled_lib.AddInst("Countdown", [&compiled](hardware_t & hw, const inst_t & inst) { AGPCompiled_Inst_Countdown(hw, inst, compiled); },
+                       2, "Countdown reg Arg1 to zero; scope to Arg2", emp::ScopeType::LOOP, 1);
+  compiled_lib.AddInst("Break", [&compiled](hardware_t & hw, const inst_t & inst) { AGPCompiled_Inst_Break(hw, inst, compiled); },
+                       1, "Break out of scope Arg1");
+  compiled_lib.AddInst("Define", [&compiled](hardware_t & hw, const inst_t & inst) { AGPCompiled_Inst_Define(hw, inst, compiled); },
+                       2, "Build function Arg1 in scope Arg2", emp::ScopeType::FUNCTION, 1);
+  AddMiscInsts(compiled_lib);
+
+  const size_t trials = 1000;
+  const size_t genome_size = 500;
+  const size_t steps = 2000;
+  size_t mismatches = 0;
+  double stock_time = 0.0;
+  double compiled_time = 0.0;
+
+  for (size_t trialid = 0; trialid < trials; ++trialid) {
+    // 1) Generate a random genome, and make an identical copy that uses the compiled instruction set.
+    hardware_t stock_hw(&stock_lib);
+    stock_hw.PushRandom(random, genome_size);
+    genome_t compiled_genome(&compiled_lib);
+    compiled_genome.sequence = stock_hw.GetGenome().sequence;
+    hardware_t compiled_hw(&compiled_lib);
+    compiled_hw.SetGenome(compiled_genome);
+    compiled.Compile(compiled_genome);
+
+    // 2) How long does each take?
+    std::clock_t start_time = std::clock();
+    for (size_t step = 0; step < steps; ++step) stock_hw.SingleProcess();
+    stock_time += (double)(std::clock() - start_time);
+    start_time = std::clock();
+    for (size_t step = 0; step < steps; ++step) compiled_hw.SingleProcess();
+    compiled_time += (double)(std::clock() - start_time);
+
+    // 3) Step both from the beginning, checking that they agree after every step.
+    stock_hw.ResetHardware();
+    compiled_hw.ResetHardware();
+    for (size_t step = 0; step < steps; ++step) {
+      stock_hw.SingleProcess();
+      compiled_hw.SingleProcess();
+      bool same = (stock_hw.GetIP() == compiled_hw.GetIP());
+      for (size_t r = 0; r < hardware_t::CPU_SIZE; ++r) same = same && SameReg(stock_hw.regs[r], compiled_hw.regs[r]);
+      if (!same) {
+        std::cout << "Oh no! Trial " << trialid << " diverged at step " << step << "." << std::endl;
+        ++mismatches;
+        break;
+      }
+    }
+  }
+
+  std::cout << "Stock time = " << 1000.0 * stock_time / (double) CLOCKS_PER_SEC << " ms." << std::endl;
+  std::cout << "Compiled time = " << 1000.0 * compiled_time / (double) CLOCKS_PER_SEC << " ms." << std::endl;
+  std::cout << "Mismatched trials: " << mismatches << "/" << trials << std::endl;
+  return (mismatches == 0) ? 0 : 1;
+}
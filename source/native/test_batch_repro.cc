@@ -0,0 +1,123 @@
+// Tests for batched reproduction helpers: MutateOffspring must give identical offspring and
+// mutation counts for any number of workers (and leave elites unmutated), on one WorkerPool reused
+// for every batch, as in a run, and
+// SelectTournamentParents must draw entrants with replacement, as emp::TournamentSelect does.
+
+#include <iostream>
+#include <array>
+
+#include "base/vector.h"
+#include "tools/Random.h"
+
+#include "../CounterRandom.h"
+#include "../BatchReproduction.h"
+
+using genome_t = emp::vector<int>;
+using counts_t = std::array<size_t, 3>;   // Substitutions, insertions, deletions.
+
+constexpr size_t MAX_WORKERS = 7;
+WorkerPool workers(MAX_WORKERS);
+
+struct TestMutatorState {
+  counts_t muts;
+  TestMutatorState() : muts() { muts.fill(0); }
+};
+
+/// Per-site substitutions, insertions and deletions (so genome lengths change, like SGP/AGP).
+size_t Mutate(genome_t & genome, CounterRandom & rnd, TestMutatorState & mstate) {
+  mstate.muts.fill(0);
+  for (size_t i = 0; i < genome.size(); ++i) {
+    if (rnd.P(0.05)) { genome[i] = rnd.GetInt(1000); ++mstate.muts[0]; }
+  }
+  if (rnd.P(0.3)) { genome.insert(genome.begin() + rnd.GetUInt(genome.size() + 1), rnd.GetInt(1000)); ++mstate.muts[1]; }
+  if (genome.size() > 1 && rnd.P(0.3)) { genome.erase(genome.begin() + rnd.GetUInt(genome.size())); ++mstate.muts[2]; }
+  return mstate.muts[0] + mstate.muts[1] + mstate.muts[2];
+}
+
+struct BatchResult {
+  emp::vector<genome_t> offspring;
+  emp::vector<counts_t> muts;
+};
+
+BatchResult RunBatch(size_t num_workers, const emp::vector<genome_t> & pop, const emp::vector<size_t> & parents,
+                     size_t elite_cnt, size_t block_size, size_t update) {
+  emp::vector<CounterRandom> rngs(num_workers, CounterRandom(42));
+  emp::vector<TestMutatorState> mstates(num_workers);
+  BatchResult result;
+  MutateOffspring(workers, num_workers, parents, elite_cnt, block_size, update, 2,
+                  [&pop](size_t pos) -> const genome_t & { return pop[pos]; },
+                  Mutate, rngs, mstates, result.offspring, result.muts);
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  emp::Random random(3);
+  size_t failures = 0;
+
+  // 1) Offspring and mutation counts don't depend on the number of workers.
+  for (size_t gen = 0; gen < 10; ++gen) {
+    const size_t pop_size = 20 + random.GetUInt(200);
+    emp::vector<genome_t> pop(pop_size);
+    for (genome_t & genome : pop) {
+      genome.resize(1 + random.GetUInt(50));
+      for (int & site : genome) site = random.GetInt(1000);
+    }
+    emp::vector<size_t> parents(pop_size);
+    for (size_t & parent : parents) parent = random.GetUInt(pop_size);
+    const size_t block_size = (gen % 2) ? pop_size : pop_size / 4;
+    const size_t elite_cnt = random.GetUInt(3);
+    const BatchResult serial = RunBatch(1, pop, parents, elite_cnt, block_size, gen);
+    size_t mutated = 0;
+    for (size_t i = 0; i < pop_size; ++i) {
+      const bool elite = i % block_size < elite_cnt;
+      if (elite && (serial.offspring[i] != pop[parents[i]] || serial.muts[i] != counts_t{{0, 0, 0}})) {
+        std::cout << "FAIL: elite " << i << " was mutated (generation " << gen << ")" << std::endl;
+        ++failures;
+      }
+      if (!elite && serial.offspring[i] != pop[parents[i]]) ++mutated;
+    }
+    if (mutated == 0) { std::cout << "FAIL: nothing was mutated (generation " << gen << ")" << std::endl; ++failures; }
+    for (size_t num_workers : {(size_t)2, (size_t)3, MAX_WORKERS}) {
+      const BatchResult parallel = RunBatch(num_workers, pop, parents, elite_cnt, block_size, gen);
+      if (parallel.offspring != serial.offspring || parallel.muts != serial.muts) {
+        std::cout << "FAIL: " << num_workers << " workers differ from 1 (generation " << gen << ")" << std::endl;
+        ++failures;
+      }
+    }
+    // Reused offspring buffers (as every update after the first) give the same results.
+    BatchResult reused = RunBatch(3, pop, parents, elite_cnt, block_size, gen + 100);
+    emp::vector<CounterRandom> rngs(3, CounterRandom(42));
+    emp::vector<TestMutatorState> mstates(3);
+    MutateOffspring(workers, 3, parents, elite_cnt, block_size, gen, 2,
+                    [&pop](size_t pos) -> const genome_t & { return pop[pos]; }, Mutate,
+                    rngs, mstates, reused.offspring, reused.muts);
+    if (reused.offspring != serial.offspring || reused.muts != serial.muts) {
+      std::cout << "FAIL: reused buffers differ (generation " << gen << ")" << std::endl;
+      ++failures;
+    }
+  }
+
+  // 2) Tournaments draw entrants with replacement, first highest-fitness entrant wins.
+  for (size_t gen = 0; gen < 20; ++gen) {
+    const size_t pop_size = 1 + random.GetUInt(100);
+    emp::vector<double> fitness(pop_size);
+    for (double & fit : fitness) fit = (double)random.GetUInt(gen % 2 ? 4 : 1000);
+    const size_t t_size = 1 + random.GetUInt(pop_size + 5);   // May exceed the population.
+    emp::Random ref_random(gen + 1), sel_random(gen + 1);
+    emp::vector<size_t> expected, parents;
+    for (size_t t = 0; t < pop_size; ++t) {
+      size_t best_id = ref_random.GetUInt(pop_size);
+      for (size_t i = 1; i < t_size; ++i) {
+        const size_t id = ref_random.GetUInt(pop_size);
+        if (fitness[id] > fitness[best_id]) best_id = id;
+      }
+      expected.emplace_back(best_id);
+    }
+    SelectTournamentParents(fitness, t_size, pop_size, sel_random, parents);
+    if (parents != expected) { std::cout << "FAIL: tournament parents differ (generation " << gen << ")" << std::endl; ++failures; }
+  }
+
+  std::cout << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
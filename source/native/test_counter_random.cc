@@ -0,0 +1,68 @@
+// Checks for CounterRandom: Philox4x32-10 known-answer vectors (from Random123), stream replay
+// (a stream's numbers don't depend on what was drawn before), and basic distribution sanity.
+
+#include <iostream>
+#include <cmath>
+
+#include "base/vector.h"
+
+#include "../CounterRandom.h"
+
+int main(int argc, char* argv[])
+{
+  size_t failures = 0;
+
+  // 1) Known-answer tests.
+  struct KAT { CounterRandom::block_t ctr; CounterRandom::key_t key; CounterRandom::block_t out; };
+  const emp::vector<KAT> kats = {
+    {{{0, 0, 0, 0}}, {{0, 0}}, {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}},
+    {{{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}, {{0xffffffff, 0xffffffff}},
+     {{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}},
+    {{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}, {{0xa4093822, 0x299f31d0}},
+     {{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}}
+  };
+  for (size_t i = 0; i < kats.size(); ++i) {
+    if (CounterRandom::Philox4x32_10(kats[i].ctr, kats[i].key) != kats[i].out) {
+      std::cout << "FAIL: known-answer vector " << i << std::endl;
+      ++failures;
+    }
+  }
+
+  // 2) Streams replay regardless of history.
+  CounterRandom a(1234), b(1234);
+  a.SetStream(300, 12, 2);
+  emp::vector<uint32_t> first(10);
+  for (uint32_t & x : first) x = a.GetUInt32();
+  for (size_t i = 0; i < 7; ++i) b.GetDouble();
+  b.SetStream(300, 12, 2);
+  for (size_t i = 0; i < first.size(); ++i) {
+    if (b.GetUInt32() != first[i]) { std::cout << "FAIL: stream replay" << std::endl; ++failures; break; }
+  }
+  b.SetStream(300, 13, 2);
+  if (b.GetUInt32() == first[0]) { std::cout << "FAIL: neighbouring streams collide" << std::endl; ++failures; }
+
+  // 3) Distribution sanity.
+  CounterRandom rnd(7);
+  rnd.SetStream(0, 0, 0);
+  const size_t n = 1000000;
+  double sum = 0.0, sum_norm = 0.0, sum_sq_norm = 0.0, sum_binom = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    const double d = rnd.GetDouble();
+    if (d < 0.0 || d >= 1.0) { std::cout << "FAIL: GetDouble out of range" << std::endl; ++failures; break; }
+    sum += d;
+    const double z = rnd.GetRandNormal();
+    sum_norm += z;
+    sum_sq_norm += z * z;
+  }
+  for (size_t i = 0; i < n / 10; ++i) sum_binom += (double)rnd.GetRandBinomial(100, 0.05);
+  const double mean = sum / n, mean_norm = sum_norm / n, var_norm = sum_sq_norm / n - mean_norm * mean_norm;
+  const double mean_binom = sum_binom / (n / 10);
+  std::cout << "uniform mean: " << mean << "; normal mean/var: " << mean_norm << "/" << var_norm
+            << "; binomial(100, 0.05) mean: " << mean_binom << std::endl;
+  if (std::abs(mean - 0.5) > 0.002) { std::cout << "FAIL: uniform mean" << std::endl; ++failures; }
+  if (std::abs(mean_norm) > 0.005 || std::abs(var_norm - 1.0) > 0.01) { std::cout << "FAIL: normal moments" << std::endl; ++failures; }
+  if (std::abs(mean_binom - 5.0) > 0.05) { std::cout << "FAIL: binomial mean" << std::endl; ++failures; }
+
+  std::cout << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
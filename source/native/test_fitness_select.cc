@@ -0,0 +1,116 @@
+// Tests for fitness-array selection: TournamentSelectArray must give exactly the same births as
+// emp::TournamentSelect (reference transcribed below) for the same random seed, and AliasTable
+// draws must follow the weights (roulette selection's distribution). Uses a minimal stand-in world.
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "base/vector.h"
+#include "tools/Random.h"
+
+#include "../FitnessSelection.h"
+
+/// Just enough of emp::World for selection: a population of IDs with fitnesses.
+struct TestWorld {
+  using genome_t = size_t;
+  emp::Random random;
+  emp::vector<double> fitness;
+  emp::vector<size_t> births;  // Parent positions, in order.
+
+  TestWorld(int seed, const emp::vector<double> & fit) : random(seed), fitness(fit), births() { ; }
+  size_t GetSize() const { return fitness.size(); }
+  bool IsSynchronous() const { return true; }
+  emp::Random & GetRandom() { return random; }
+  double CalcFitnessID(size_t id) const { return fitness[id]; }
+  size_t GetRandomOrgID() { return random.GetUInt(fitness.size()); }
+  genome_t GetGenomeAt(size_t id) const { return id; }
+  void DoBirth(genome_t, size_t parent, size_t copies=1) { births.emplace_back(parent); }
+};
+
+/// emp::TournamentSelect's algorithm.
+void ReferenceTournamentSelect(TestWorld & world, size_t t_size, size_t tourny_count) {
+  emp::vector<size_t> entries;
+  for (size_t T = 0; T < tourny_count; T++) {
+    entries.resize(0);
+    for (size_t i=0; i<t_size; i++) entries.push_back( world.GetRandomOrgID() );
+    double best_fit = world.CalcFitnessID(entries[0]);
+    size_t best_id = entries[0];
+    for (size_t i = 1; i < t_size; i++) {
+      const double cur_fit = world.CalcFitnessID(entries[i]);
+      if (cur_fit > best_fit) {
+        best_fit = cur_fit;
+        best_id = entries[i];
+      }
+    }
+    world.DoBirth( world.GetGenomeAt(best_id), best_id, 1 );
+  }
+}
+
+/// Draw reps times from a table built from weights; returns max |z| of any index's count.
+double CheckAlias(emp::Random & random, const emp::vector<double> & weights, size_t reps, size_t & failures) {
+  AliasTable table;
+  table.Build(weights);
+  double total = 0.0;
+  for (double w : weights) total += w;
+  emp::vector<size_t> cnts(weights.size(), 0);
+  for (size_t rep = 0; rep < reps; ++rep) ++cnts[table.Draw(random)];
+  double max_z = 0.0;
+  for (size_t i = 0; i < weights.size(); ++i) {
+    const double p = (total > 0.0) ? weights[i] / total : 1.0 / (double)weights.size();
+    if (p == 0.0) {
+      if (cnts[i]) { std::cout << "FAIL: drew zero-weight index " << i << std::endl; ++failures; }
+      continue;
+    }
+    const double sd = std::sqrt((double)reps * p * (1.0 - p));
+    max_z = std::max(max_z, std::abs((double)cnts[i] - (double)reps * p) / std::max(sd, 1e-9));
+  }
+  return max_z;
+}
+
+int main(int argc, char* argv[])
+{
+  emp::Random random(6);
+  size_t failures = 0;
+
+  // Tournaments: same births as the reference (ties included: few distinct fitness values).
+  for (size_t gen = 0; gen < 20; ++gen) {
+    const size_t pop_size = 50 + random.GetUInt(500);
+    emp::vector<double> fitness(pop_size);
+    for (double & fit : fitness) fit = (double)random.GetUInt(gen % 2 ? 5 : 1000);
+    const size_t t_size = 1 + random.GetUInt(8);
+    TestWorld ref_world(gen + 1, fitness), world(gen + 1, fitness);
+    ReferenceTournamentSelect(ref_world, t_size, pop_size - 1);
+    emp::vector<size_t> parents;
+    TournamentSelectArray(world, fitness, t_size, pop_size - 1, parents);
+    if (ref_world.births != world.births) { std::cout << "FAIL: tournament births differ in generation " << gen << std::endl; ++failures; }
+  }
+
+  // Alias table: skewed, with zeros, uniform, all zero, and a single entry.
+  const double z_limit = 5.0;
+  emp::vector<emp::vector<double>> weight_sets;
+  weight_sets.emplace_back(emp::vector<double>{1.0, 2.0, 3.0, 4.0});
+  weight_sets.emplace_back(emp::vector<double>{0.0, 5.0, 0.0, 0.001, 100.0, 0.0, 7.5});
+  weight_sets.emplace_back(emp::vector<double>(37, 2.5));
+  weight_sets.emplace_back(emp::vector<double>(10, 0.0));
+  weight_sets.emplace_back(emp::vector<double>{3.0});
+  emp::vector<double> big(1000);
+  for (double & w : big) w = (random.GetUInt(4) == 0) ? 0.0 : random.GetDouble(100.0);
+  weight_sets.emplace_back(big);
+  for (const emp::vector<double> & weights : weight_sets) {
+    const double max_z = CheckAlias(random, weights, 400000, failures);
+    std::cout << "weights " << weights.size() << ": max |z| = " << max_z << std::endl;
+    if (max_z > z_limit) { std::cout << "FAIL: alias draws don't follow weights" << std::endl; ++failures; }
+  }
+
+  // Roulette into the world: births come from table draws.
+  TestWorld world(9, weight_sets[1]);
+  AliasTable table;
+  table.Build(world.fitness);
+  emp::vector<size_t> parents;
+  RouletteSelectArray(world, table, 100, parents);
+  if (world.births != parents || parents.size() != 100) { std::cout << "FAIL: roulette births" << std::endl; ++failures; }
+
+  std::cout << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+// Allocation counter for reproduction: once the genome pools have warmed up, a generation of
+// births (agents built from their parents' genomes, then mutated in place, then the old generation
+// dies) should make no heap allocations at all, for both SignalGP and AvidaGP agents. Also checks
+// that moved-from agents don't put empty genomes in the pool.
+
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "base/vector.h"
+#include "tools/Random.h"
+
+#include "../LineageExp.h"
+
+// --- Global allocation counter ---
+static size_t alloc_cnt = 0;
+
+void * operator new(size_t size) {
+  ++alloc_cnt;
+  if (void * ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void * ptr) noexcept { std::free(ptr); }
+void operator delete(void * ptr, size_t) noexcept { std::free(ptr); }
+
+using SGP__agent_t = LineageExp::SignalGPAgent;
+using AGP__agent_t = LineageExp::AvidaGPAgent;
+
+constexpr size_t POP_SIZE = 200;
+constexpr size_t WARMUP_GENS = 20;  // More than the SGP function count.
+constexpr size_t GENS = 50;
+
+/// SGP substitution (same length, like SGP__Mutate_Substitutions) in function gen % function count.
+/// Cycling through the functions means every ancestral block has been replaced after one cycle, so
+/// the number of live blocks (and so the block pool) is the same every generation after that.
+void Mutate(LineageExp::SGP__genome_t & program, size_t gen, emp::Random & random) {
+  LineageExp::SGP__function_t & fun = program.EditFunction(gen % program.GetSize());
+  fun.inst_seq[random.GetUInt(fun.inst_seq.size())].args[0] = random.GetInt(16);
+}
+
+/// AGP substitution.
+void Mutate(LineageExp::AGP__program_t & program, size_t gen, emp::Random & random) {
+  program.sequence[random.GetUInt(program.sequence.size())].args[0] = random.GetInt(16);
+}
+
+/// Run synchronous generations (as emp::World does, but with the population in reserved vectors so
+/// only genome allocations are counted). Every agent has one offspring, born at a random position.
+/// Returns allocations per generation after warm-up.
+template<typename AGENT_T, typename GENOME_T>
+double CountBirthAllocs(const GENOME_T & ancestor, emp::Random & random) {
+  emp::vector<AGENT_T> pop, next;
+  emp::vector<size_t> parents(POP_SIZE);
+  pop.reserve(POP_SIZE);
+  next.reserve(POP_SIZE);
+  for (size_t i = 0; i < POP_SIZE; ++i) pop.emplace_back(ancestor);
+  size_t steady_allocs = 0;
+  for (size_t gen = 0; gen < WARMUP_GENS + GENS; ++gen) {
+    const size_t start_cnt = alloc_cnt;
+    for (size_t i = 0; i < POP_SIZE; ++i) parents[i] = i;
+    for (size_t i = POP_SIZE - 1; i > 0; --i) std::swap(parents[i], parents[random.GetUInt(i + 1)]);
+    for (size_t i = 0; i < POP_SIZE; ++i) {
+      next.emplace_back(pop[parents[i]].GetGenome());
+      Mutate(next.back().GetGenome(), gen, random);
+    }
+    pop.clear();
+    std::swap(pop, next);
+    if (gen >= WARMUP_GENS) steady_allocs += alloc_cnt - start_cnt;
+  }
+  return (double)steady_allocs / (double)GENS;
+}
+
+int main(int argc, char* argv[])
+{
+  emp::Random random(4);
+  size_t failures = 0;
+
+  // Ancestors (as in SGP__InitPopulation_Random/AGP__InitPopulation_Random).
+  LineageExp::SGP__inst_lib_t sgp_inst_lib;
+  sgp_inst_lib.AddInst("Inc", LineageExp::SGP__hardware_t::Inst_Inc, 1, "Increment value in local memory Arg1");
+  sgp_inst_lib.AddInst("Dec", LineageExp::SGP__hardware_t::Inst_Dec, 1, "Decrement value in local memory Arg1");
+  LineageExp::SGP__program_t sgp_prog(&sgp_inst_lib);
+  for (size_t f = 0; f < 8; ++f) {
+    sgp_prog.PushFunction();
+    sgp_prog[f].affinity.Randomize(random);
+    for (size_t i = 0; i < 32; ++i) {
+      LineageExp::SGP__inst_t inst(random.GetUInt(sgp_inst_lib.GetSize()), random.GetInt(16), random.GetInt(16), random.GetInt(16));
+      inst.affinity.Randomize(random);
+      sgp_prog[f].PushInst(inst);
+    }
+  }
+  const LineageExp::SGP__genome_t sgp_ancestor(sgp_prog);
+
+  LineageExp::AGP__inst_lib_t agp_inst_lib;
+  agp_inst_lib.AddInst("Inc", LineageExp::AGP__inst_lib_t::Inst_Inc, 1, "Increment value in reg Arg1");
+  agp_inst_lib.AddInst("Dec", LineageExp::AGP__inst_lib_t::Inst_Dec, 1, "Decrement value in reg Arg1");
+  LineageExp::AGP__hardware_t cpu(&agp_inst_lib);
+  for (size_t i = 0; i < 256; ++i) cpu.PushInst(random.GetUInt(agp_inst_lib.GetSize()), random.GetInt(16), random.GetInt(16), random.GetInt(16));
+  const LineageExp::AGP__program_t agp_ancestor = cpu.GetGenome();
+
+  const double sgp_allocs = CountBirthAllocs<SGP__agent_t>(sgp_ancestor, random);
+  const double agp_allocs = CountBirthAllocs<AGP__agent_t>(agp_ancestor, random);
+  std::cout << "SGP steady-state allocations per generation = " << sgp_allocs << std::endl;
+  std::cout << "AGP steady-state allocations per generation = " << agp_allocs << std::endl;
+  if (sgp_allocs != 0.0) { std::cout << "FAIL: SGP births allocate" << std::endl; ++failures; }
+  if (agp_allocs != 0.0) { std::cout << "FAIL: AGP births allocate" << std::endl; ++failures; }
+
+  // Moved-from agents don't recycle.
+  {
+    const size_t pool_size = SGP__agent_t::recycler_t::GetPoolSize();
+    {
+      SGP__agent_t agent(sgp_ancestor);
+      SGP__agent_t moved(std::move(agent));
+    }
+    if (SGP__agent_t::recycler_t::GetPoolSize() != pool_size) { std::cout << "FAIL: SGP pool after move" << std::endl; ++failures; }
+  }
+  {
+    const size_t pool_size = AGP__agent_t::recycler_t::GetPoolSize();
+    {
+      AGP__agent_t agent(agp_ancestor);
+      AGP__agent_t moved(std::move(agent));
+    }
+    if (AGP__agent_t::recycler_t::GetPoolSize() != pool_size) { std::cout << "FAIL: AGP pool after move" << std::endl; ++failures; }
+  }
+
+  std::cout << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+// Statistical test: LexicaseSelector must pick parents with the same distribution as plain
+// lexicase selection (the emp::LexicaseSelect algorithm: shuffle all test cases, filter the whole
+// population down to the best on each, pick uniformly among what's left), including when it
+// filters on phenotype classes of duplicated score vectors.
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "base/vector.h"
+#include "tools/Random.h"
+
+#include "../LexicaseSelection.h"
+
+/// Reference lexicase: scores[testID][orgID].
+size_t ReferenceLexicase(const emp::vector<emp::vector<double>> & scores, size_t pop_size, double epsilon, emp::Random & rnd) {
+  emp::vector<size_t> order(scores.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  for (size_t i = order.size(); i > 1; --i) std::swap(order[i - 1], order[rnd.GetUInt(i)]);
+  emp::vector<size_t> cur_orgs(pop_size), next_orgs;
+  for (size_t i = 0; i < pop_size; ++i) cur_orgs[i] = i;
+  for (size_t testID : order) {
+    double max_score = scores[testID][cur_orgs[0]];
+    for (size_t org : cur_orgs) max_score = std::max(max_score, scores[testID][org]);
+    next_orgs.clear();
+    for (size_t org : cur_orgs) if (scores[testID][org] >= max_score - epsilon) next_orgs.emplace_back(org);
+    std::swap(cur_orgs, next_orgs);
+  }
+  return cur_orgs[rnd.GetUInt(cur_orgs.size())];
+}
+
+int main(int argc, char* argv[])
+{
+  emp::Random random(3);
+  const size_t reps = 200000;
+  const double z_limit = 5.0;
+  size_t failures = 0;
+
+  struct Setup { size_t pop_size; size_t num_tests; size_t levels; double epsilon; size_t phenotypes; };
+  // Few score levels => many ties (the interesting case); pop sizes straddle bitset words.
+  // phenotypes > 0: population is copies of that many random score vectors (unevenly).
+  const emp::vector<Setup> setups = {{10, 5, 3, 0.0, 0}, {70, 8, 2, 0.0, 0}, {130, 20, 4, 0.0, 0},
+                                     {100, 6, 10, 1.5, 0}, {300, 30, 3, 0.0, 7}, {200, 10, 5, 1.0, 70}};
+
+  for (const Setup & setup : setups) {
+    emp::vector<emp::vector<double>> scores(setup.num_tests, emp::vector<double>(setup.pop_size));
+    LexicaseSelector lex;
+    lex.Resize(setup.pop_size, setup.num_tests);
+    for (size_t testID = 0; testID < setup.num_tests; ++testID) {
+      for (size_t org = 0; org < setup.pop_size; ++org) scores[testID][org] = (double)random.GetUInt(setup.levels);
+    }
+    if (setup.phenotypes) {
+      for (size_t org = setup.phenotypes; org < setup.pop_size; ++org) {
+        const size_t proto = random.GetUInt(random.GetUInt(setup.phenotypes) + 1);
+        for (size_t testID = 0; testID < setup.num_tests; ++testID) scores[testID][org] = scores[testID][proto];
+      }
+    }
+    for (size_t testID = 0; testID < setup.num_tests; ++testID) {
+      for (size_t org = 0; org < setup.pop_size; ++org) lex.SetScore(testID, org, scores[testID][org]);
+    }
+    lex.Prepare(setup.epsilon);
+    if (setup.phenotypes && lex.GetNumClasses() != setup.phenotypes) {
+      std::cout << "FAIL: expected " << setup.phenotypes << " phenotype classes, found " << lex.GetNumClasses() << std::endl;
+      ++failures;
+    }
+
+    emp::vector<size_t> ref_cnts(setup.pop_size, 0), lex_cnts(setup.pop_size, 0);
+    for (size_t rep = 0; rep < reps; ++rep) {
+      ++ref_cnts[ReferenceLexicase(scores, setup.pop_size, setup.epsilon, random)];
+      ++lex_cnts[lex.SelectOne(random)];
+    }
+
+    // Two-sample test on every position's pick count.
+    double max_z = 0.0;
+    for (size_t org = 0; org < setup.pop_size; ++org) {
+      const double p = (double)(ref_cnts[org] + lex_cnts[org]) / (2.0 * reps);
+      if (p == 0.0) continue;
+      const double sd = std::sqrt(2.0 * reps * p * (1.0 - p));
+      const double z = std::abs((double)lex_cnts[org] - (double)ref_cnts[org]) / sd;
+      max_z = std::max(max_z, z);
+      if (lex_cnts[org] == 0 && ref_cnts[org] > 50) max_z = std::max(max_z, z_limit + 1);
+      if (ref_cnts[org] == 0 && lex_cnts[org] > 50) max_z = std::max(max_z, z_limit + 1);
+    }
+    std::cout << "pop " << setup.pop_size << ", tests " << setup.num_tests << ", levels " << setup.levels
+              << ", epsilon " << setup.epsilon << ", classes " << lex.GetNumClasses() << ": max |z| = " << max_z << std::endl;
+    if (max_z > z_limit) { std::cout << "FAIL: pick distributions differ" << std::endl; ++failures; }
+  }
+
+  std::cout << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
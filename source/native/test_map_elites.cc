@@ -0,0 +1,100 @@
+// Unit test: MapElitesArchive binning, insert/replace rules, elite bookkeeping, and the binary
+// archive format (written, then read back field by field).
+
+#include <iostream>
+#include <fstream>
+#include <cstdint>
+#include <cstdio>
+
+#include "base/vector.h"
+#include "tools/Random.h"
+
+#include "../MapElitesArchive.h"
+
+#include "TestCheck.h"
+
+template<typename T>
+T ReadVal(std::ifstream & is) {
+  T val = T();
+  is.read(reinterpret_cast<char *>(&val), sizeof(val));
+  return val;
+}
+
+int main(int argc, char* argv[])
+{
+  MapElitesArchive archive;
+  archive.AddAxis(0.0, 1.0, 4);     // Bins: [0,.25) [.25,.5) [.5,.75) [.75,1]
+  archive.AddAxis(-10.0, 10.0, 5);
+  archive.Reset();
+  Check(archive.GetNumCells() == 20, "cell count");
+  Check(archive.GetNumOccupied() == 0, "empty after reset");
+
+  // Binning, including edges and out-of-range values.
+  Check(archive.GetBin(0, 0.0) == 0 && archive.GetBin(0, 0.2499) == 0, "first bin");
+  Check(archive.GetBin(0, 0.25) == 1 && archive.GetBin(0, 0.74) == 2, "middle bins");
+  Check(archive.GetBin(0, 1.0) == 3 && archive.GetBin(0, 7.0) == 3, "last bin (and above range)");
+  Check(archive.GetBin(1, -50.0) == 0, "below range");
+  const double desc_a[] = {0.3, 9.0};
+  Check(archive.GetCell(desc_a) == 1 * 5 + 4, "cell index (first axis slowest)");
+
+  // Insert: empty cells always fill; occupied cells only take strictly fitter elites.
+  Check(archive.Insert(desc_a, 1.0, 7), "insert into empty cell");
+  const double desc_b[] = {0.4, 8.5};   // Same cell as desc_a.
+  Check(!archive.Insert(desc_b, 1.0, 8), "tie doesn't replace");
+  Check(!archive.Insert(desc_b, 0.5, 9), "worse doesn't replace");
+  Check(archive.GetElitePos(9) == 7, "elite kept");
+  Check(archive.Insert(desc_b, 2.0, 10), "better replaces");
+  Check(archive.GetElitePos(9) == 10 && archive.GetFitness(9) == 2.0, "replacement recorded");
+  Check(archive.GetDescriptors(9)[0] == 0.4 && archive.GetDescriptors(9)[1] == 8.5, "replacement descriptors");
+  Check(archive.GetNumOccupied() == 1, "replacement doesn't add a cell");
+  const double desc_c[] = {0.9, -10.0};
+  archive.Insert(desc_c, -3.0, 2);
+  Check(archive.GetNumOccupied() == 2 && archive.GetOccupiedCell(1) == 15, "second cell");
+  archive.SetElitePos(15, 1);
+  Check(archive.GetElitePos(15) == 1, "elite moved");
+
+  // Random fill: every cell's elite has the best fitness offered to that cell.
+  emp::Random random(5);
+  MapElitesArchive grid;
+  grid.AddAxis(0.0, 1.0, 8);
+  grid.AddAxis(0.0, 1.0, 8);
+  grid.AddAxis(0.0, 1.0, 3);
+  grid.Reset();
+  emp::vector<double> best(grid.GetNumCells(), -1.0);
+  for (size_t n = 0; n < 5000; ++n) {
+    const double desc[] = {random.GetDouble(), random.GetDouble(), random.GetDouble()};
+    const double fit = random.GetDouble(100.0);
+    const size_t cell = grid.GetCell(desc);
+    if (fit > best[cell]) best[cell] = fit;
+    grid.Insert(desc, fit, n);
+  }
+  size_t occupied = 0;
+  for (size_t cell = 0; cell < grid.GetNumCells(); ++cell) {
+    if (best[cell] < 0) { Check(!grid.IsOccupied(cell), "unvisited cell is empty"); continue; }
+    ++occupied;
+    Check(grid.IsOccupied(cell) && grid.GetFitness(cell) == best[cell], "cell keeps best fitness");
+  }
+  Check(grid.GetNumOccupied() == occupied, "occupied count");
+
+  // Binary round trip.
+  const std::string fpath = "test_map_elites.bin";
+  Check(archive.WriteBinary(fpath, 1234), "write archive");
+  std::ifstream is(fpath, std::ios::binary);
+  Check(ReadVal<uint32_t>(is) == MapElitesArchive::BINARY_MAGIC, "magic");
+  Check(ReadVal<uint32_t>(is) == MapElitesArchive::BINARY_VERSION, "version");
+  Check(ReadVal<uint64_t>(is) == 1234, "update");
+  Check(ReadVal<uint32_t>(is) == 2, "dimensions");
+  Check(ReadVal<uint32_t>(is) == 4 && ReadVal<double>(is) == 0.0 && ReadVal<double>(is) == 1.0, "axis 0");
+  Check(ReadVal<uint32_t>(is) == 5 && ReadVal<double>(is) == -10.0 && ReadVal<double>(is) == 10.0, "axis 1");
+  Check(ReadVal<uint64_t>(is) == 2, "occupied cells");
+  Check(ReadVal<uint64_t>(is) == 9 && ReadVal<double>(is) == 2.0, "first cell (by index)");
+  Check(ReadVal<double>(is) == 0.4 && ReadVal<double>(is) == 8.5, "first cell descriptors");
+  Check(ReadVal<uint64_t>(is) == 15 && ReadVal<double>(is) == -3.0, "second cell");
+  Check(ReadVal<double>(is) == 0.9 && ReadVal<double>(is) == -10.0, "second cell descriptors");
+  is.get();
+  Check(is.eof(), "end of file");
+  is.close();
+  std::remove(fpath.c_str());
+
+  return CheckResult();
+}
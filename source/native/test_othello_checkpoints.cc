@@ -0,0 +1,104 @@
+// Check OthelloHardware's dream checkpoints: random legal moves with interleaved PushActive/PopActive
+// (on several dreams, with resets mixed in), where every pop must restore the board saved when the
+// matching checkpoint was pushed; and the MAX_CHECKPOINTS limit.
+
+#include <iostream>
+
+#include "base/vector.h"
+#include "games/Othello8.h"
+#include "tools/Random.h"
+
+#include "../OthelloHW.h"
+
+#include "TestCheck.h"
+
+using othello_t = emp::Othello8;
+using player_t = othello_t::Player;
+
+bool SameBoard(const othello_t & game, const othello_t & other) {
+  return game.GetBoard().occupied == other.GetBoard().occupied && game.GetBoard().player == other.GetBoard().player;
+}
+
+/// Make a random legal move (for a random player that has one) on the active dream.
+void RandomMove(OthelloHardware & hw, emp::Random & random) {
+  othello_t & dream = hw.GetActiveDreamOthello();
+  player_t player = random.P(0.5) ? player_t::DARK : player_t::LIGHT;
+  auto moves = dream.GetMoveOptions(player);
+  if (moves.size() == 0) {
+    player = (player == player_t::DARK) ? player_t::LIGHT : player_t::DARK;
+    moves = dream.GetMoveOptions(player);
+  }
+  if (moves.size() == 0) return;
+  hw.DoActiveMove(player, moves[random.GetUInt(moves.size())]);
+}
+
+int main(int argc, char* argv[])
+{
+  emp::Random random(31);
+  const size_t dream_cnt = 3;
+  OthelloHardware hw(dream_cnt);
+  othello_t root;
+  const size_t trials = 500;
+
+  for (size_t trial = 0; trial < trials; ++trial) {
+    // Turn root: a random board.
+    root.Reset();
+    const size_t num_moves = random.GetUInt(0, 40);
+    for (size_t i = 0; i < num_moves; ++i) {
+      auto moves = root.GetMoveOptions();
+      if (moves.size() == 0) break;
+      root.DoNextMove(moves[random.GetUInt(moves.size())]);
+    }
+    hw.Reset(root);
+
+    // Snapshots of each dream's board at each of its open checkpoints.
+    emp::vector<emp::vector<othello_t>> snapshots(dream_cnt);
+    for (size_t step = 0; step < 400; ++step) {
+      const size_t op = random.GetUInt(100);
+      if (op < 5) {
+        hw.SetActiveDream(random.GetUInt(dream_cnt));
+      } else if (op < 7) {
+        hw.ResetActive(root);   // Clears the active dream's checkpoints.
+        snapshots[hw.GetActiveDream()].clear();
+      } else if (op < 30) {
+        const bool pushed = hw.PushActive();
+        Check(pushed == (snapshots[hw.GetActiveDream()].size() < OthelloHardware::MAX_CHECKPOINTS), "push result", trial);
+        if (pushed) snapshots[hw.GetActiveDream()].emplace_back(hw.GetActiveDreamOthello());
+      } else if (op < 50) {
+        emp::vector<othello_t> & stack = snapshots[hw.GetActiveDream()];
+        const bool popped = hw.PopActive();
+        Check(popped == !stack.empty(), "pop result", trial);
+        if (popped) {
+          Check(SameBoard(hw.GetActiveDreamOthello(), stack.back()), "board after pop doesn't match its checkpoint", trial);
+          stack.pop_back();
+        }
+      } else {
+        RandomMove(hw, random);   // Logged only if a checkpoint is open.
+      }
+      Check(hw.GetActiveCheckpointCnt() == snapshots[hw.GetActiveDream()].size(), "checkpoint count", trial);
+    }
+  }
+
+  // Limit: MAX_CHECKPOINTS pushes succeed, the next one fails; then everything unwinds.
+  root.Reset();
+  hw.Reset(root);
+  hw.SetActiveDream(0);
+  emp::vector<othello_t> stack;
+  for (size_t i = 0; i < OthelloHardware::MAX_CHECKPOINTS; ++i) {
+    Check(hw.PushActive(), "push below the limit", i);
+    stack.emplace_back(hw.GetActiveDreamOthello());
+    RandomMove(hw, random);
+  }
+  Check(OthelloHardware::MAX_CHECKPOINTS == 64, "MAX_CHECKPOINTS is 64", 0);
+  Check(!hw.PushActive(), "push past the limit", 0);
+  Check(hw.GetActiveCheckpointCnt() == OthelloHardware::MAX_CHECKPOINTS, "failed push doesn't open a checkpoint", 0);
+  while (!stack.empty()) {
+    Check(hw.PopActive(), "pop", stack.size());
+    Check(SameBoard(hw.GetActiveDreamOthello(), stack.back()), "board after pop (limit)", stack.size());
+    stack.pop_back();
+  }
+  Check(!hw.PopActive(), "pop with no checkpoints", 0);
+  Check(SameBoard(hw.GetActiveDreamOthello(), root), "fully unwound board is the root", 0);
+
+  return CheckResult();
+}
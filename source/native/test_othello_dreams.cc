@@ -0,0 +1,84 @@
+// Check OthelloHardware's copy-on-first-use dreams against a model that copies eagerly: after a
+// reset, every dream must look like the turn root the first time it's touched (even if it was
+// written to in an earlier turn), and writes to one dream must never show up in the root or in
+// any other dream.
+
+#include <iostream>
+
+#include "base/vector.h"
+#include "games/Othello8.h"
+#include "tools/Random.h"
+
+#include "../OthelloHW.h"
+
+#include "TestCheck.h"
+
+using othello_t = emp::Othello8;
+using player_t = othello_t::Player;
+
+bool SameBoard(const othello_t & game, const othello_t & other) {
+  return game.GetBoard().occupied == other.GetBoard().occupied && game.GetBoard().player == other.GetBoard().player;
+}
+
+int main(int argc, char* argv[])
+{
+  emp::Random random(30);
+  const size_t dream_cnt = 4;
+  OthelloHardware hw(dream_cnt);
+  othello_t root, root_copy, fresh;
+  const size_t turns = 1000;
+
+  for (size_t turn = 0; turn < turns; ++turn) {
+    // New turn root (only changed between resets, as Reset requires), or a fresh game.
+    const bool fresh_reset = (turn % 7 == 3);
+    if (fresh_reset) {
+      hw.Reset();
+    } else {
+      const size_t num_moves = random.GetUInt(0, 4);
+      for (size_t i = 0; i < num_moves; ++i) {
+        auto moves = root.GetMoveOptions();
+        if (moves.size() == 0) { root.Reset(); break; }
+        root.DoNextMove(moves[random.GetUInt(moves.size())]);
+      }
+      root_copy = root;
+      hw.Reset(root);
+    }
+    const othello_t & turn_root = fresh_reset ? fresh : root_copy;
+    for (size_t id = 0; id < dream_cnt; ++id) Check(!hw.IsMaterialized(id), "dream materialized before first use", turn);
+
+    // Model: eager copies of the dreams touched so far this turn.
+    emp::vector<othello_t> model(dream_cnt);
+    emp::vector<bool> touched(dream_cnt, false);
+    for (size_t step = 0; step < 30; ++step) {
+      const size_t id = random.GetUInt(dream_cnt);
+      hw.SetActiveDream(id);
+      othello_t & dream = hw.GetActiveDreamOthello();
+      if (!touched[id]) {
+        Check(SameBoard(dream, turn_root), "dream doesn't start from the turn root", turn);
+        model[id] = turn_root;
+        touched[id] = true;
+      }
+      // Write to it (through the hardware or directly, as instructions do).
+      const player_t player = random.P(0.5) ? player_t::DARK : player_t::LIGHT;
+      auto moves = dream.GetMoveOptions(player);
+      if (moves.size()) {
+        const size_t move = moves[random.GetUInt(moves.size())];
+        if (random.P(0.5)) hw.DoActiveMove(player, move);
+        else dream.DoMove(player, move);
+        model[id].DoMove(player, move);
+      }
+      // No leaks: every touched dream matches its model; the root is unchanged.
+      for (size_t other = 0; other < dream_cnt; ++other) {
+        if (!touched[other]) {
+          Check(!hw.IsMaterialized(other), "untouched dream was materialized", turn);
+          continue;
+        }
+        hw.SetActiveDream(other);
+        Check(SameBoard(hw.GetActiveDreamOthello(), model[other]), "dream doesn't match its model", turn);
+      }
+      if (!fresh_reset) Check(SameBoard(root, root_copy), "write leaked into the turn root", turn);
+    }
+  }
+
+  return CheckResult();
+}
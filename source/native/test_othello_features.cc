@@ -0,0 +1,96 @@
+// Check OthelloFeatures against brute force on random boards (disc/corner counts, mobility,
+// greedy move and its tie-break, NO_MOVE), and check that the OthelloLookup-cached features (used
+// by the feature instructions) agree with computing them straight from the board (NOLOOKUP).
+
+#include <iostream>
+
+#include "base/vector.h"
+#include "games/Othello8.h"
+#include "tools/Random.h"
+
+#include "../OthelloFeatures.h"
+#include "../OthelloLookup.h"
+
+#include "TestCheck.h"
+
+using othello_t = emp::Othello8;
+using player_t = othello_t::Player;
+using geom_t = OthelloGeometry<8>;
+
+bool SameFeatures(const OthelloFeatures & a, const OthelloFeatures & b) {
+  return a.dark_disc_cnt == b.dark_disc_cnt && a.light_disc_cnt == b.light_disc_cnt
+      && a.dark_corner_cnt == b.dark_corner_cnt && a.light_corner_cnt == b.light_corner_cnt
+      && a.dark_mobility == b.dark_mobility && a.light_mobility == b.light_mobility
+      && a.dark_greedy_move == b.dark_greedy_move && a.light_greedy_move == b.light_greedy_move;
+}
+
+int main(int argc, char* argv[])
+{
+  emp::Random random(8);
+  OthelloLookup lu;
+  othello_t game;
+  const size_t trials = 2000;
+  size_t no_move_cnt = 0;   // Boards where a player had no moves.
+  size_t tie_cnt = 0;       // Boards where the greedy move had to break a tie.
+
+  for (size_t trial = 0; trial < trials; ++trial) {
+    // Random board via random moves (every 10th game is played out to the end).
+    const size_t num_moves = (trial % 10 == 0) ? 100 : random.GetUInt(0, 60);
+    game.Reset();
+    for (size_t i = 0; i < num_moves; ++i) {
+      auto moves = game.GetMoveOptions();
+      if (moves.size() == 0) break;
+      game.DoNextMove(moves[random.GetUInt(moves.size())]);
+    }
+
+    OthelloFeatures features;
+    features.Compute(game);
+
+    for (player_t player : {player_t::DARK, player_t::LIGHT}) {
+      const player_t opp = (player == player_t::DARK) ? player_t::LIGHT : player_t::DARK;
+      // Brute force over every square.
+      size_t discs = 0, corners = 0, mobility = 0, opp_mobility = 0;
+      size_t greedy_move = OthelloFeatures::NO_MOVE, best_flips = 0, best_cnt = 0;
+      for (size_t pos = 0; pos < geom_t::NUM_CELLS; ++pos) {
+        const size_t x = geom_t::GetX(pos), y = geom_t::GetY(pos);
+        const bool corner = (x == 0 || x == 7) && (y == 0 || y == 7);
+        if (game.GetPosOwner(pos) == player) {
+          ++discs;
+          if (corner) ++corners;
+        }
+        if (game.GetPosOwner(pos) != player_t::NONE) continue;
+        const size_t flips = game.GetFlipList(player, pos).size();
+        if (game.GetFlipList(opp, pos).size()) ++opp_mobility;
+        if (flips == 0) continue;
+        ++mobility;
+        if (flips > best_flips) {   // Strictly more: the lowest position wins ties.
+          greedy_move = pos;
+          best_flips = flips;
+          best_cnt = 1;
+        } else if (flips == best_flips) {
+          ++best_cnt;
+        }
+      }
+      if (greedy_move == OthelloFeatures::NO_MOVE) ++no_move_cnt;
+      if (best_cnt > 1) ++tie_cnt;
+
+      Check(features.GetDiscCnt(player) == discs, "disc count mismatch", trial);
+      Check(features.GetCornerCnt(player) == corners, "corner count mismatch", trial);
+      Check(features.GetMobility(player) == mobility, "mobility mismatch", trial);
+      Check(features.GetMobility(player) == game.GetMoveOptions(player).size(), "mobility (move options) mismatch", trial);
+      Check((int)features.GetMobility(player) - (int)features.GetMobility(opp) == (int)mobility - (int)opp_mobility,
+            "mobility difference mismatch", trial);
+      Check(features.GetGreedyMove(player) == greedy_move, "greedy move mismatch", trial);
+    }
+
+    // Lookup path: first request computes from the cached flip lists; later ones hit the cache.
+    if (trial % 2) lu.CacheBoard(game);
+    Check(SameFeatures(lu.GetFeatures(game), features), "lookup features mismatch", trial);
+    Check(SameFeatures(lu.GetFeatures(game), features), "cached lookup features mismatch", trial);
+  }
+
+  std::cout << "Boards with no moves for a player: " << no_move_cnt << std::endl;
+  std::cout << "Boards with greedy-move ties: " << tie_cnt << std::endl;
+  Check(no_move_cnt > 0 && tie_cnt > 0, "Random boards didn't cover NO_MOVE and ties.");
+  return CheckResult();
+}
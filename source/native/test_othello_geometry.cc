@@ -0,0 +1,41 @@
+// Check compile-time board geometry tables against emp::Othello8.
+
+#include <iostream>
+
+#include "games/Othello8.h"
+#include "tools/math.h"
+
+#include "../OthelloGeometry.h"
+
+using othello_t = emp::Othello8;
+using facing_t = othello_t::Facing;
+using geom_t = OthelloGeometry<8>;
+
+int main(int argc, char* argv[])
+{
+  othello_t game;
+  const facing_t facings[geom_t::NUM_DIRECTIONS] = { facing_t::N, facing_t::NE, facing_t::E, facing_t::SE,
+                                                     facing_t::S, facing_t::SW, facing_t::W, facing_t::NW };
+  size_t mismatches = 0;
+
+  for (size_t pos = 0; pos <= geom_t::NUM_CELLS; ++pos) {
+    const othello_t::Index idx(pos);
+    if (pos < geom_t::NUM_CELLS) {
+      if (geom_t::GetX(pos) != idx.x() || geom_t::GetY(pos) != idx.y() || geom_t::GetID(idx.x(), idx.y()) != pos) {
+        std::cout << "Oh no! XY mismatch at " << pos << std::endl;
+        ++mismatches;
+      }
+    }
+    for (int dir = -8; dir < 16; ++dir) {
+      const othello_t::Index neighbor = game.GetNeighbor(idx, facings[emp::Mod(dir, (int)geom_t::NUM_DIRECTIONS)]);
+      const size_t expected = neighbor.IsValid() ? (size_t)neighbor.pos : geom_t::INVALID;
+      if (geom_t::GetNeighbor(pos, dir) != expected) {
+        std::cout << "Oh no! Neighbor mismatch at " << pos << " (dir " << dir << ")" << std::endl;
+        ++mismatches;
+      }
+    }
+  }
+
+  std::cout << "Mismatches: " << mismatches << std::endl;
+  return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+// Equivalence test: ResourceSelectMatrix must give exactly the same births and resource amounts as
+// emp::ResourceSelect with one fitness function per resource (reference transcribed below), for
+// the same random seed. Uses a minimal stand-in world.
+
+#include <iostream>
+#include <functional>
+
+#include "base/vector.h"
+#include "Evolve/Resource.h"
+#include "tools/Random.h"
+#include "tools/math.h"
+
+#include "../ResourceSelection.h"
+
+/// Just enough of emp::World for resource selection: a population of IDs with base fitnesses.
+struct TestWorld {
+  using genome_t = size_t;
+  emp::Random random;
+  emp::vector<double> base_fitness;
+  emp::vector<size_t> births;  // Parent positions, in order.
+
+  TestWorld(int seed, const emp::vector<double> & fit) : random(seed), base_fitness(fit), births() { ; }
+  size_t GetSize() const { return base_fitness.size(); }
+  size_t GetNumOrgs() const { return base_fitness.size(); }
+  bool IsOccupied(size_t) const { return true; }
+  double CalcFitnessID(size_t id) const { return base_fitness[id]; }
+  size_t GetRandomOrgID() { return random.GetUInt(base_fitness.size()); }
+  genome_t GetGenomeAt(size_t id) const { return id; }
+  void DoBirth(genome_t, size_t parent, size_t) { births.emplace_back(parent); }
+};
+
+/// emp::ResourceSelect's algorithm, with per-resource fitness functions.
+void ReferenceResourceSelect(TestWorld & world, const emp::vector<std::function<double(size_t)>> & extra_funs,
+                             emp::vector<emp::Resource> & pools, size_t t_size, size_t tourny_count,
+                             double frac, double max_bonus, double cost) {
+  emp::vector<double> base_fitness(world.GetSize());
+  for (size_t org_id = 0; org_id < world.GetSize(); org_id++) {
+    base_fitness[org_id] = world.CalcFitnessID(org_id);
+    for (size_t ex_id = 0; ex_id < extra_funs.size(); ex_id++) {
+      pools[ex_id].Inc(pools[ex_id].GetInflow()/world.GetNumOrgs());
+      double cur_fit = extra_funs[ex_id](org_id);
+      cur_fit = emp::Pow(cur_fit, 2.0);
+      cur_fit *= frac*(pools[ex_id].GetAmount()-cost);
+      if (cur_fit > 0) {
+        cur_fit -= cost;
+      } else {
+        cur_fit = 0;
+      }
+      cur_fit = std::min(cur_fit, max_bonus);
+      base_fitness[org_id] *= emp::Pow2(cur_fit);
+      pools[ex_id].Dec(std::abs(cur_fit));
+    }
+  }
+  emp::vector<size_t> entries;
+  for (size_t T = 0; T < tourny_count; T++) {
+    entries.resize(0);
+    for (size_t i=0; i<t_size; i++) entries.push_back( world.GetRandomOrgID() );
+    double best_fit = base_fitness[entries[0]];
+    size_t best_id = entries[0];
+    for (size_t i = 1; i < t_size; i++) {
+      const double cur_fit = base_fitness[entries[i]];
+      if (cur_fit > best_fit) {
+        best_fit = cur_fit;
+        best_id = entries[i];
+      }
+    }
+    world.DoBirth( world.GetGenomeAt(best_id), best_id, 1 );
+  }
+  for (size_t ex_id = 0; ex_id < extra_funs.size(); ex_id++) pools[ex_id].Update();
+}
+
+/// Run generations of selection with both implementations; returns number of mismatches.
+/// score_levels > 0: scores take that many distinct values (like per-test-case move scores).
+size_t CompareRuns(emp::Random & random, size_t pop_size, size_t num_resources, size_t score_levels, size_t generations) {
+  size_t failures = 0;
+  emp::vector<double> base_fitness(pop_size);
+  emp::vector<emp::vector<double>> scores(pop_size, emp::vector<double>(num_resources));
+  emp::vector<emp::Resource> ref_pools, pools;
+  for (size_t r = 0; r < num_resources; ++r) {
+    ref_pools.emplace_back(100.0 + r, 50.0, 0.05);
+    pools.emplace_back(100.0 + r, 50.0, 0.05);
+  }
+  emp::vector<std::function<double(size_t)>> extra_funs;
+  for (size_t r = 0; r < num_resources; ++r) extra_funs.push_back([&scores, r](size_t id) { return scores[id][r]; });
+
+  ResourceSelector selector;
+  for (size_t gen = 0; gen < generations; ++gen) {
+    for (size_t id = 0; id < pop_size; ++id) {
+      base_fitness[id] = 1.0 + random.GetDouble(10.0);
+      for (size_t r = 0; r < num_resources; ++r) {
+        if (score_levels) scores[id][r] = 0.5 * (double)random.GetUInt(score_levels);
+        else scores[id][r] = (random.GetUInt(3) == 0) ? 0.0 : random.GetDouble(3.0);
+      }
+    }
+    TestWorld ref_world(gen + 1, base_fitness), world(gen + 1, base_fitness);
+    ReferenceResourceSelect(ref_world, extra_funs, ref_pools, 7, pop_size, 0.0025, 5.0, 0.5);
+    selector.Resize(pop_size, num_resources);
+    for (size_t id = 0; id < pop_size; ++id) {
+      for (size_t r = 0; r < num_resources; ++r) selector.SetScore(id, r, scores[id][r]);
+    }
+    ResourceSelectMatrix(world, selector, pools, 7, pop_size, 0.0025, 5.0, 0.5);
+    if (ref_world.births != world.births) { std::cout << "FAIL: births differ in generation " << gen << std::endl; ++failures; }
+    for (size_t r = 0; r < num_resources; ++r) {
+      if (ref_pools[r].GetAmount() != pools[r].GetAmount()) {
+        std::cout << "FAIL: resource " << r << " differs in generation " << gen << ": "
+                  << ref_pools[r].GetAmount() << " vs " << pools[r].GetAmount() << std::endl;
+        ++failures;
+      }
+    }
+  }
+  return failures;
+}
+
+int main(int argc, char* argv[])
+{
+  emp::Random random(4);
+  size_t failures = 0;
+  failures += CompareRuns(random, 200, 13, 0, 30);   // E.g. game phase resources.
+  failures += CompareRuns(random, 500, 300, 4, 10);  // E.g. one resource per test case.
+  std::cout << (failures ? "FAILED" : "PASSED") << std::endl;
+  return failures ? 1 : 0;
+}
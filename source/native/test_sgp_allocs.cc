@@ -0,0 +1,105 @@
+// Allocation counter for SignalGP evaluation: evaluating a program in the steady state (the hardware
+// and everything else evaluation touches warmed up) has to do zero heap allocations.
+// Runs the experiment's own evaluation path: LineageExp's SGP instruction library (SGP__Inst_Call and
+// SGP__Inst_Fork resolve tags through the SGPBindingTable), the SGP__eval_hw_t evaluation hardware,
+// and RunTest (begin-turn hardware reset, RunUntil, move extraction) on every test case.
+// Exits with a nonzero status if any steady-state evaluation allocates.
+// Run it from a config directory, as with lineage: it reads configs.cfg and its test case file.
+
+#include <iostream>
+#include <cstdlib>
+#include <new>
+
+#include "base/vector.h"
+
+#include "config/command_line.h"
+#include "config/ArgManager.h"
+
+#include "../lineage-config.h"
+#include "../LineageExp.h"
+
+// --- Global allocation counter ---
+static size_t alloc_cnt = 0;
+
+void * operator new(size_t size) {
+  ++alloc_cnt;
+  if (void * ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void * ptr) noexcept { std::free(ptr); }
+void operator delete(void * ptr, size_t) noexcept { std::free(ptr); }
+
+constexpr size_t EVAL_PROGRAMS = 50;  // Evaluate this many programs from the (random) initial population.
+
+/// LineageExp with access to its evaluation internals.
+class SGPAllocCounter : public LineageExp {
+public:
+  SGPAllocCounter(const LineageConfig & config) : LineageExp(config) { ; }
+
+  /// Evaluate programs from a random initial population on every test case, twice, counting
+  /// allocations per test case. The first pass warms up the eval hardware, dreamware, and Othello
+  /// lookup table (which caches every board it's asked about). The second pass repeats exactly the
+  /// same evaluations (the random number generator that breaks tag-binding ties is reseeded for each
+  /// test case), so anything it allocates is evaluation overhead. Returns steady-state allocations.
+  size_t Count() {
+    SGP__InitPopulation_Random();
+    const size_t program_cnt = emp::Min(EVAL_PROGRAMS, sgp_world->GetSize());
+    const size_t testcase_cnt = testcases.GetSize();
+    if (testcase_cnt == 0) {
+      std::cout << "Need at least one test case. Exiting..." << std::endl;
+      exit(-1);
+    }
+    size_t warmup_allocs = 0;
+    size_t steady_allocs = 0;
+    size_t steady_max = 0;
+    size_t steady_steps = 0;
+    for (size_t id = 0; id < program_cnt; ++id) {
+      SGP__SetEvalProgram(sgp_world->GetOrg(id).GetGenome(), sgp_world->GetGenotypeAt(id)->GetData().sgp_compiled);
+      for (size_t pass = 0; pass < 2; ++pass) {
+        for (cur_testcase = 0; cur_testcase < testcase_cnt; ++cur_testcase) {
+          random->ResetSeed((int)(id * testcase_cnt + cur_testcase) + 1);
+          const size_t start_cnt = alloc_cnt;
+          RunTest(id, cur_testcase);
+          const size_t allocs = alloc_cnt - start_cnt;
+          if (pass == 0) {
+            warmup_allocs += allocs;
+          } else {
+            steady_allocs += allocs;
+            steady_max = emp::Max(steady_max, allocs);
+            steady_steps += eval_time;
+          }
+        }
+      }
+    }
+    const size_t eval_cnt = program_cnt * testcase_cnt;
+    std::cout << "Programs = " << program_cnt << "; test cases = " << testcase_cnt << "; steady-state steps = " << steady_steps << std::endl;
+    std::cout << "Warm-up allocations per test case = " << (double)warmup_allocs / (double)eval_cnt << std::endl;
+    std::cout << "Steady-state allocations per test case = " << (double)steady_allocs / (double)eval_cnt
+              << " (max " << steady_max << ")" << std::endl;
+    return steady_allocs;
+  }
+};
+
+int main(int argc, char* argv[])
+{
+  // Read configs.
+  std::string config_fname = "configs.cfg";
+  auto args = emp::cl::ArgManager(argc, argv);
+  LineageConfig config;
+  config.Read(config_fname);
+
+  if (args.ProcessConfigOptions(config, std::cout, config_fname, "../lineage-config.h") == false)
+    exit(0);
+  if (args.TestUnknown() == false)
+    exit(0);
+
+  // SignalGP experiment evaluation, on a random population (an ancestor-file population is one program).
+  config.RUN_MODE(RUN_ID__EXP);
+  config.REPRESENTATION(REPRESENTATION_ID__SIGNALGP);
+  config.POP_INITIALIZATION_METHOD(POP_INITIALIZATION_METHOD_ID__RANDOM_POP);
+
+  SGPAllocCounter counter(config);
+  const size_t steady_allocs = counter.Count();
+  std::cout << (steady_allocs ? "FAILED" : "PASSED") << std::endl;
+  return (steady_allocs == 0) ? 0 : 1;
+}
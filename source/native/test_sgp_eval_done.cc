@@ -0,0 +1,87 @@
+// SignalGP evaluation actually runs programs: a trivial program that sets its move has to get to
+// execute on the experiment's evaluation path (RunTest: begin-turn hardware reset, RunUntil with
+// SGP__IsEvalDone, move extraction). Right after a reset, the main core is still pending (it only
+// becomes active at the end of the first SingleProcess); a quiescence check that ignores pending
+// cores ends every turn after 0 steps, with MOVE still at its reset value.
+// Run it from a config directory, as with lineage: it reads configs.cfg and its test case file.
+
+#include <iostream>
+
+#include "base/vector.h"
+
+#include "config/command_line.h"
+#include "config/ArgManager.h"
+
+#include "../lineage-config.h"
+#include "../LineageExp.h"
+
+constexpr int MOVE_ID = 9;   // Small enough to be a valid SetMem argument.
+
+/// LineageExp with access to its evaluation internals.
+class SGPEvalDoneTester : public LineageExp {
+protected:
+  size_t failures = 0;
+
+  SGP__inst_t Inst(const std::string & name, int a0=0, int a1=0, int a2=0) {
+    return SGP__inst_t(sgp_inst_lib->GetID(name), a0, a1, a2);
+  }
+
+  /// Run program (one function, inst_seq) through RunTest on test case 0; check how it went.
+  void Check(const std::string & name, const emp::vector<SGP__inst_t> & inst_seq, bool ends_turn) {
+    SGP__program_t prog(sgp_inst_lib);
+    prog.PushFunction();
+    for (const SGP__inst_t & inst : inst_seq) prog[0].PushInst(inst);
+    SignalGPAgent hero(prog);
+    hero.SetID(0);
+    SGP__compiled_t compiled;
+    SGP__SetEvalProgram(hero.GetGenome(), compiled);
+    cur_testcase = 0;
+    RunTest(hero.GetID(), cur_testcase);
+    const int move = (int)sgp_eval_hw->GetTrait(TRAIT_ID__MOVE);
+    const bool done = (bool)sgp_eval_hw->GetTrait(TRAIT_ID__DONE);
+    std::cout << name << ": steps = " << eval_time << "; MOVE = " << move << "; DONE = " << done << std::endl;
+    if (eval_time == 0) { std::cout << "FAIL: " << name << " never ran." << std::endl; ++failures; }
+    if (move != MOVE_ID) { std::cout << "FAIL: " << name << " didn't get to set its move." << std::endl; ++failures; }
+    if (done != ends_turn) { std::cout << "FAIL: " << name << " DONE trait is wrong." << std::endl; ++failures; }
+    // Without EndTurn, the turn ends when the (only) core finishes, not when time runs out.
+    if (!ends_turn && eval_time >= EVAL_TIME) {
+      std::cout << "FAIL: " << name << " ran out the clock after its only core finished." << std::endl;
+      ++failures;
+    }
+  }
+
+public:
+  SGPEvalDoneTester(const LineageConfig & config) : LineageExp(config) { ; }
+
+  size_t Run() {
+    if (testcases.GetSize() == 0) {
+      std::cout << "Need at least one test case. Exiting..." << std::endl;
+      exit(-1);
+    }
+    Check("SetMoveID + EndTurn", {Inst("SetMem", 0, MOVE_ID), Inst("SetMoveID", 0), Inst("EndTurn")}, true);
+    Check("SetMoveID (core finishes)", {Inst("SetMem", 0, MOVE_ID), Inst("SetMoveID", 0)}, false);
+    return failures;
+  }
+};
+
+int main(int argc, char* argv[])
+{
+  // Read configs.
+  std::string config_fname = "configs.cfg";
+  auto args = emp::cl::ArgManager(argc, argv);
+  LineageConfig config;
+  config.Read(config_fname);
+
+  if (args.ProcessConfigOptions(config, std::cout, config_fname, "../lineage-config.h") == false)
+    exit(0);
+  if (args.TestUnknown() == false)
+    exit(0);
+
+  config.RUN_MODE(RUN_ID__EXP);
+  config.REPRESENTATION(REPRESENTATION_ID__SIGNALGP);
+
+  SGPEvalDoneTester tester(config);
+  const size_t failures = tester.Run();
+  std::cout << (failures ? "FAILED" : "PASSED") << std::endl;
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+// Differential test: SGPHardware (with hash map memory and with dense memory) running compiled
+// programs vs. stock emp::EventDrivenGP running the same programs, on random programs. Call and Fork pick functions by argument instead of by tag
+// (the experiment binds tags itself), and Emit records what the current call can see, so all
+// three hardware types have to agree on memory, control flow, and core/call stack bookkeeping.
+// Dense memory hardware also has to run every program without a single heap allocation (its cores
+// and call states are pooled).
+
+#include <iostream>
+#include <ctime>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "base/vector.h"
+#include "hardware/EventDrivenGP.h"
+#include "tools/Random.h"
+
+#include "../SGPHardware.h"
+#include "../SGPMemory.h"
+
+// --- Global allocation counter ---
+static size_t alloc_cnt = 0;
+
+void * operator new(size_t size) {
+  ++alloc_cnt;
+  if (void * ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void * ptr) noexcept { std::free(ptr); }
+void operator delete(void * ptr, size_t) noexcept { std::free(ptr); }
+
+constexpr size_t TAG_WIDTH = 16;
+constexpr size_t MEM_SIZE = 16;
+
+using stock_hw_t = emp::EventDrivenGP_AW<TAG_WIDTH>;
+using map_hw_t = SGPHardware<TAG_WIDTH, SGPMapMemory>;
+using dense_hw_t = SGPHardware<TAG_WIDTH, SGPDenseMemory<MEM_SIZE>>;
+using program_t = stock_hw_t::Program;
+using inst_t = stock_hw_t::inst_t;
+
+emp::vector<double> * trace = nullptr;  ///< Where Emit records to.
+
+template<typename HW_T>
+void Inst_Call(HW_T & hw, const inst_t & inst) {
+  hw.CallFunction((size_t)inst.args[0] % hw.GetProgram().GetSize());
+}
+template<typename HW_T>
+void Inst_Fork(HW_T & hw, const inst_t & inst) {
+  if (hw.GetInactiveCores().empty()) return;
+  hw.SpawnCore((size_t)inst.args[0] % hw.GetProgram().GetSize(), hw.GetCurState().local_mem);
+}
+template<typename HW_T>
+void Inst_Emit(HW_T & hw, const inst_t & inst) {
+  auto & state = hw.GetCurState();
+  trace->emplace_back(state.GetLocal(inst.args[0]));
+  trace->emplace_back(state.GetInput(inst.args[1]));
+  trace->emplace_back(state.GetOutput(inst.args[2]));
+  trace->emplace_back((double)state.GetFP());
+  trace->emplace_back((double)state.GetIP());
+  trace->emplace_back((double)hw.GetCurCore().size());
+}
+
+template<typename HW_T, typename INST_LIB_T>
+void ConfigInstLib(INST_LIB_T & lib) {
+  lib.AddInst("Inc", HW_T::Inst_Inc, 1);
+  lib.AddInst("Dec", HW_T::Inst_Dec, 1);
+  lib.AddInst("Not", HW_T::Inst_Not, 1);
+  lib.AddInst("Add", HW_T::Inst_Add, 3);
+  lib.AddInst("Sub", HW_T::Inst_Sub, 3);
+  lib.AddInst("Mult", HW_T::Inst_Mult, 3);
+  lib.AddInst("Div", HW_T::Inst_Div, 3);
+  lib.AddInst("Mod", HW_T::Inst_Mod, 3);
+  lib.AddInst("TestEqu", HW_T::Inst_TestEqu, 3);
+  lib.AddInst("TestNEqu", HW_T::Inst_TestNEqu, 3);
+  lib.AddInst("TestLess", HW_T::Inst_TestLess, 3);
+  lib.AddInst("If", HW_T::Inst_If, 1, "", emp::ScopeType::BASIC, 0, {"block_def"});
+  lib.AddInst("While", HW_T::Inst_While, 1, "", emp::ScopeType::BASIC, 0, {"block_def"});
+  lib.AddInst("Countdown", HW_T::Inst_Countdown, 1, "", emp::ScopeType::BASIC, 0, {"block_def"});
+  lib.AddInst("Close", HW_T::Inst_Close, 0, "", emp::ScopeType::BASIC, 0, {"block_close"});
+  lib.AddInst("Break", HW_T::Inst_Break, 0);
+  lib.AddInst("Call", Inst_Call<HW_T>, 1);
+  lib.AddInst("Return", HW_T::Inst_Return, 0);
+  lib.AddInst("SetMem", HW_T::Inst_SetMem, 2);
+  lib.AddInst("CopyMem", HW_T::Inst_CopyMem, 2);
+  lib.AddInst("SwapMem", HW_T::Inst_SwapMem, 2);
+  lib.AddInst("Input", HW_T::Inst_Input, 2);
+  lib.AddInst("Output", HW_T::Inst_Output, 2);
+  lib.AddInst("Commit", HW_T::Inst_Commit, 2);
+  lib.AddInst("Pull", HW_T::Inst_Pull, 2);
+  lib.AddInst("Nop", HW_T::Inst_Nop, 0);
+  lib.AddInst("Fork", Inst_Fork<HW_T>, 1);
+  lib.AddInst("Emit", Inst_Emit<HW_T>, 3);
+}
+
+void SetMem(stock_hw_t::memory_t & mem, int key, double value) { mem[key] = value; }
+template<typename MEMORY_T>
+void SetMem(MEMORY_T & mem, int key, double value) { mem.Set(key, value); }
+
+bool SameVal(double a, double b) { return (a == b) || (std::isnan(a) && std::isnan(b)); }
+
+/// Run prog on hw for steps time steps (main core gets input), recording Emits and per-step core counts.
+/// Returns how many allocations running the program took (out has to have room for the whole trace).
+template<typename HW_T, typename PROGRAM_T>
+size_t Run(HW_T & hw, const PROGRAM_T & prog, const emp::vector<std::pair<int, double>> & input,
+           size_t steps, emp::vector<double> & out)
+{
+  typename HW_T::memory_t input_mem;
+  for (const auto & entry : input) SetMem(input_mem, entry.first, entry.second);
+  trace = &out;
+  hw.SetProgram(prog);
+  hw.ResetHardware();
+  const size_t start_cnt = alloc_cnt;
+  hw.SpawnCore(0, input_mem, true);
+  for (size_t step = 0; step < steps; ++step) {
+    hw.SingleProcess();
+    out.emplace_back((double)hw.GetActiveCores().size());
+    out.emplace_back((double)hw.GetPendingCores().size());
+  }
+  return alloc_cnt - start_cnt;
+}
+
+bool SameTrace(const emp::vector<double> & a, const emp::vector<double> & b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i) if (!SameVal(a[i], b[i])) return false;
+  return true;
+}
+
+int main() {
+  emp::Random random(2);
+  stock_hw_t::inst_lib_t stock_lib;
+  map_hw_t::inst_lib_t map_lib;
+  dense_hw_t::inst_lib_t dense_lib;
+  ConfigInstLib<stock_hw_t>(stock_lib);
+  ConfigInstLib<map_hw_t>(map_lib);
+  ConfigInstLib<dense_hw_t>(dense_lib);
+  stock_hw_t::event_lib_t event_lib;
+
+  emp::Random stock_rnd(1);
+  emp::Random map_rnd(1);
+  emp::Random dense_rnd(1);
+  stock_hw_t stock_hw(&stock_lib, &event_lib, &stock_rnd);
+  map_hw_t map_hw(&map_lib, &map_rnd);
+  dense_hw_t dense_hw(&dense_lib, &dense_rnd);
+  const size_t max_cores = 4;       // Small, so Fork runs out of cores.
+  const size_t max_call_depth = 8;  // Small, so Call hits max call depth.
+  stock_hw.SetMaxCores(max_cores);
+  map_hw.SetMaxCores(max_cores);
+  dense_hw.SetMaxCores(max_cores);
+  stock_hw.SetMaxCallDepth(max_call_depth);
+  map_hw.SetMaxCallDepth(max_call_depth);
+  dense_hw.SetMaxCallDepth(max_call_depth);
+
+  const size_t trials = 2000;
+  const size_t steps = 256;
+  size_t mismatches = 0;
+  size_t dense_allocs = 0;
+  double stock_time = 0.0;
+  double dense_time = 0.0;
+  emp::vector<double> stock_trace, map_trace, dense_trace;
+  // Room for every Emit (6 values) from every core, every step, plus per-step core counts.
+  dense_trace.reserve(steps * (max_cores * 6 + 2));
+
+  for (size_t trialid = 0; trialid < trials; ++trialid) {
+    // 1) Random program (and main core input memory).
+    program_t prog(&stock_lib);
+    const size_t fun_cnt = random.GetUInt(1, 6);
+    for (size_t f = 0; f < fun_cnt; ++f) {
+      prog.PushFunction();
+      const size_t len = random.GetUInt(1, 32);
+      for (size_t i = 0; i < len; ++i) {
+        prog[f].PushInst(inst_t(random.GetUInt(stock_lib.GetSize()), random.GetInt(MEM_SIZE),
+                                random.GetInt(MEM_SIZE), random.GetInt(MEM_SIZE)));
+      }
+    }
+    map_hw_t::program_t map_prog;
+    dense_hw_t::program_t dense_prog;
+    map_prog.Compile(prog, map_lib);
+    dense_prog.Compile(prog, dense_lib);
+    emp::vector<std::pair<int, double>> input;
+    for (size_t i = random.GetUInt(4); i > 0; --i) input.emplace_back(random.GetInt(MEM_SIZE), random.GetDouble(10.0));
+
+    // 2) Run all three, timing stock vs. dense.
+    stock_trace.clear();
+    map_trace.clear();
+    dense_trace.clear();
+    std::clock_t start_time = std::clock();
+    Run(stock_hw, prog, input, steps, stock_trace);
+    stock_time += (double)(std::clock() - start_time);
+    Run(map_hw, map_prog, input, steps, map_trace);
+    start_time = std::clock();
+    dense_allocs += Run(dense_hw, dense_prog, input, steps, dense_trace);
+    dense_time += (double)(std::clock() - start_time);
+
+    // 3) Did they all do the same thing?
+    const bool map_same = SameTrace(stock_trace, map_trace);
+    const bool dense_same = SameTrace(stock_trace, dense_trace);
+    if (!map_same || !dense_same) {
+      std::cout << "Oh no! Trial " << trialid << " diverged:" << (map_same ? "" : " map memory")
+                << (dense_same ? "" : " dense memory") << std::endl;
+      ++mismatches;
+    }
+  }
+
+  std::cout << "Stock time = " << 1000.0 * stock_time / (double) CLOCKS_PER_SEC << " ms." << std::endl;
+  std::cout << "Dense time = " << 1000.0 * dense_time / (double) CLOCKS_PER_SEC << " ms." << std::endl;
+  std::cout << "Mismatched trials: " << mismatches << "/" << trials << std::endl;
+  std::cout << "Dense memory allocations while running: " << dense_allocs << std::endl;
+  return (mismatches == 0 && dense_allocs == 0) ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+// Statistical test: GeometricSkipSampler must hit every trial independently with probability p,
+// i.e. exactly the distribution of calling rnd.P(p) once per trial.
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "base/vector.h"
+#include "tools/Random.h"
+
+#include "../GeometricSkipSampler.h"
+
+int main(int argc, char* argv[])
+{
+  emp::Random random(2);
+  const emp::vector<double> rates = {0.0, 0.001, 0.005, 0.05, 0.3, 0.9, 1.0};
+  const size_t num_trials = 256;   // e.g. sites in a genome
+  const size_t reps = 200000;      // e.g. offspring
+  const double z_limit = 5.0;      // Per-check |z| limit (all checks together: false alarm rate << 1%).
+  size_t failures = 0;
+
+  for (double p : rates) {
+    GeometricSkipSampler sampler(p);
+    emp::vector<size_t> site_hits(num_trials, 0);
+    emp::vector<size_t> pair_hits(num_trials - 1, 0); // Both trial i and i+1 hit (independence check).
+    double sum_cnt = 0.0;
+    double sum_sq_cnt = 0.0;
+    emp::vector<char> hit(num_trials, 0);
+    for (size_t rep = 0; rep < reps; ++rep) {
+      size_t cnt = 0;
+      std::fill(hit.begin(), hit.end(), 0);
+      sampler.ForEachHit(num_trials, random, [&](size_t trial) { hit[trial] = 1; ++site_hits[trial]; ++cnt; });
+      for (size_t i = 0; i + 1 < num_trials; ++i) pair_hits[i] += (size_t)(hit[i] && hit[i+1]);
+      sum_cnt += (double)cnt;
+      sum_sq_cnt += (double)(cnt * cnt);
+    }
+
+    // 1) Every site is hit with probability p.
+    double max_z = 0.0;
+    const double site_sd = std::sqrt((double)reps * p * (1.0 - p));
+    for (size_t i = 0; i < num_trials; ++i) {
+      const double diff = (double)site_hits[i] - (double)reps * p;
+      const double z = (site_sd > 0.0) ? std::abs(diff) / site_sd : std::abs(diff);
+      max_z = std::max(max_z, z);
+    }
+    // 2) Neighboring sites are hit independently (probability p^2).
+    double max_pair_z = 0.0;
+    const double pp = p * p;
+    const double pair_sd = std::sqrt((double)reps * pp * (1.0 - pp));
+    for (size_t i = 0; i + 1 < num_trials; ++i) {
+      const double diff = (double)pair_hits[i] - (double)reps * pp;
+      const double z = (pair_sd > 0.0) ? std::abs(diff) / pair_sd : std::abs(diff);
+      max_pair_z = std::max(max_pair_z, z);
+    }
+    // 3) Hits per run have binomial mean/variance.
+    const double mean = sum_cnt / (double)reps;
+    const double var = sum_sq_cnt / (double)reps - mean * mean;
+    const double exp_mean = (double)num_trials * p;
+    const double exp_var = (double)num_trials * p * (1.0 - p);
+    const double mean_z = (exp_var > 0.0) ? std::abs(mean - exp_mean) / std::sqrt(exp_var / (double)reps) : std::abs(mean - exp_mean);
+    const bool var_ok = (exp_var > 0.0) ? std::abs(var / exp_var - 1.0) < 0.05 : var < 1e-9;
+
+    const bool ok = max_z < z_limit && max_pair_z < z_limit && mean_z < z_limit && var_ok;
+    std::cout << "p = " << p << ": max site |z| = " << max_z << "; max pair |z| = " << max_pair_z
+              << "; mean = " << mean << " (expected " << exp_mean << ")"
+              << "; var = " << var << " (expected " << exp_var << ")"
+              << (ok ? "" : "  <-- Oh no!") << std::endl;
+    if (!ok) ++failures;
+  }
+
+  std::cout << "Failed rates: " << failures << "/" << rates.size() << std::endl;
+  return (failures == 0) ? 0 : 1;
+}
@@ -22,6 +22,8 @@ EMP_BUILD_CONFIG( ToyConfig,
   VALUE(RESOURCE_SELECT__FRAC, double, 0.0025, "Fraction of resource consumed."),
   VALUE(RESOURCE_SELECT__MAX_BONUS, double, 5.0, "What's the max bonus someone can get for consuming a resource?"),
   VALUE(RESOURCE_SELECT__COST, double, 0.0, "Cost of using a resource?"),
+  VALUE(MAP_ELITES__BINS, size_t, 16, "MAP-Elites: archive is MAP_ELITES__BINS x MAP_ELITES__BINS cells over the genome's (x, y)."),
+  VALUE(MAP_ELITES__ARCHIVE_INTERVAL, size_t, 1000, "MAP-Elites: write the archive (binary) every this many updates. 0: never."),
   GROUP(MUTATION_GROUP, "Mutation Settings"),
   VALUE(MUTATION_STD, double, 0.1, "For each dimension: dimenstion std = MUTATION_STD*(upperbound[dim]-lowerbound[dim])"),
   GROUP(DATA_GROUP, "Data Collection Settings"),